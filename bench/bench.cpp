@@ -0,0 +1,694 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+/*  Performance suite
+
+    Usage:
+
+        bench [--json] [--iterations N] [filter]
+
+    Every benchmark is run over each corpus which
+    matches the filter, and reports the time per URL,
+    the throughput, and the number of allocations per
+    operation. With --json one object is written per
+    line, suitable for comparing two runs.
+
+    The std::regex benchmark uses the regular
+    expression of rfc3986 Appendix B, and serves as
+    a baseline produced by a different parser.
+*/
+
+#include <boost/url/hash.hpp>
+#include <boost/url/idna.hpp>
+#include <boost/url/lazy_url_view.hpp>
+#include <boost/url/parse.hpp>
+#include <boost/url/resolve.hpp>
+#include <boost/url/router.hpp>
+#include <boost/url/serialize.hpp>
+#include <boost/url/url.hpp>
+#include <boost/url/url_dedup.hpp>
+#include <boost/url/url_parser.hpp>
+#include <boost/url/url_stats.hpp>
+#include <boost/url/url_view.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <regex>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------
+
+// Count every allocation made by the program
+static std::atomic<std::size_t> g_allocs(0);
+
+void*
+operator new(std::size_t n)
+{
+    ++g_allocs;
+    if(auto p = std::malloc(n ? n : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+//----------------------------------------------------------
+
+namespace boost {
+namespace urls {
+namespace bench {
+
+struct corpus
+{
+    char const* name;
+    std::vector<string_view> urls;
+    std::size_t bytes = 0;
+
+    corpus(
+        char const* name_,
+        std::initializer_list<char const*> init)
+        : name(name_)
+    {
+        for(auto s : init)
+        {
+            urls.emplace_back(s);
+            bytes += urls.back().size();
+        }
+    }
+};
+
+static
+std::vector<corpus> const&
+corpora()
+{
+    static std::vector<corpus> const v = {
+    { "short", {
+        "https://api.example.com/v1/users",
+        "https://api.example.com/v1/users/42",
+        "http://localhost:8080/health",
+        "https://www.example.org/",
+        "/index.html",
+        "/api/v2/items?id=7",
+        "http://example.com",
+        "https://cdn.example.net/img/logo.png",
+        "ftp://ftp.example.com/pub/file.txt",
+        "mailto:user@example.com",
+        } },
+    { "tracking", {
+        "https://www.example.com/landing/spring-sale/shoes?utm_source=newsletter"
+            "&utm_medium=email&utm_campaign=spring_sale_2019&utm_term=running+shoes"
+            "&utm_content=hero_banner&gclid=EAIaIQobChMI8tXq2sKx4QIVgYbVCh0yQwGXEAAYASAAEgKXYfD_BwE"
+            "&fbclid=IwAR2bV1cX0a9fDq7oNk8j5QvGJ3uT&ref=home#section-3",
+        "https://ads.example.net/click/campaign/1234567/creative/89012345/placement/67890"
+            "?cb=1558401234567&ord=8372619&redirect=https%3A%2F%2Fshop.example.com%2Fproduct"
+            "%2F4455&device=mobile&os=android&lang=en-US&geo=US-CA-SF",
+        "https://track.example.org/pixel.gif?event=page_view&session=6f1e2d3c4b5a69788796a5b4c3d2e1f0"
+            "&visitor=0123456789abcdef&t=1558401234&w=1920&h=1080&dpr=2&tz=-420"
+            "&page=%2Fproducts%2Fwidgets%2Fblue&title=Blue+Widgets&referrer=",
+        } },
+    { "ipv6", {
+        "http://[2001:DB8::1]/",
+        "http://[2001:DB8:85A3::8A2E:370:7334]:8080/index.html",
+        "https://[::1]:443/status?verbose=1",
+        "http://[FE80::1FF:FE23:4567:890A]/a/b/c",
+        "ldap://[2001:DB8::7]/c=GB?objectClass?one",
+        } },
+    { "encoded", {
+        "https://www.example.com/search?q=%E4%BD%A0%E5%A5%BD%E4%B8%96%E7%95%8C&lang=zh",
+        "https://example.com/path%20with%20spaces/file%20name.pdf?dl=%31",
+        "https://example.org/?json=%7B%22a%22%3A1%2C%22b%22%3A%5B1%2C2%2C3%5D%7D",
+        "http://example.net/%7Euser/%E2%82%AC/%C3%A9t%C3%A9?x=%25%26%3D%2B",
+        } },
+    };
+    return v;
+}
+
+//----------------------------------------------------------
+
+struct result
+{
+    std::size_t ops = 0;
+    std::size_t bytes = 0;
+    std::size_t allocs = 0;
+    double seconds = 0;
+};
+
+template<class F>
+result
+run(
+    corpus const& c,
+    std::size_t iterations,
+    F const& f)
+{
+    // warm up
+    for(auto s : c.urls)
+        f(s);
+
+    result r;
+    auto const a0 = g_allocs.load();
+    auto const t0 =
+        std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < iterations; ++i)
+        for(auto s : c.urls)
+            f(s);
+    auto const t1 =
+        std::chrono::steady_clock::now();
+    r.allocs = g_allocs.load() - a0;
+    r.ops = iterations * c.urls.size();
+    r.bytes = iterations * c.bytes;
+    r.seconds = std::chrono::duration<
+        double>(t1 - t0).count();
+    return r;
+}
+
+// Defeat the optimizer
+static std::size_t volatile g_sink = 0;
+
+struct benchmark
+{
+    char const* name;
+    result (*fn)(corpus const&, std::size_t);
+};
+
+static
+result
+parse_uri_bench(
+    corpus const& c,
+    std::size_t n)
+{
+    return run(c, n,
+        [](string_view s)
+        {
+            error_code ec;
+            auto const u = parse_uri(s, ec);
+            g_sink = g_sink + u.size();
+        });
+}
+
+static
+result
+parse_table_bench(
+    corpus const& c,
+    std::size_t n)
+{
+    return run(c, n,
+        [](string_view s)
+        {
+            error_code ec;
+            auto const u = parse_uri(
+                s, parser_kind::table, ec);
+            g_sink = g_sink + u.size();
+        });
+}
+
+static
+result
+validate_bench(
+    corpus const& c,
+    std::size_t n)
+{
+    return run(c, n,
+        [](string_view s)
+        {
+            error_code ec;
+            auto const n =
+                validate_url(s, ec);
+            g_sink = g_sink + n;
+        });
+}
+
+static
+result
+request_target_bench(
+    corpus const& c,
+    std::size_t n)
+{
+    return run(c, n,
+        [](string_view s)
+        {
+            error_code ec;
+            auto const u =
+                parse_request_target(s, ec);
+            g_sink = g_sink + u.size();
+        });
+}
+
+static
+result
+stream_bench(
+    corpus const& c,
+    std::size_t n)
+{
+    return run(c, n,
+        [](string_view s)
+        {
+            // the URL arrives in two pieces
+            url_parser pr;
+            error_code ec;
+            auto const half = s.size() / 2;
+            pr.write(s.substr(0, half), ec);
+            pr.write(s.substr(half), ec);
+            pr.finish(ec);
+            auto const u = pr.result(s);
+            g_sink = g_sink + u.size();
+        });
+}
+
+static
+result
+url_bench(
+    corpus const& c,
+    std::size_t n)
+{
+    return run(c, n,
+        [](string_view s)
+        {
+            url u(s);
+            g_sink = g_sink + u.size();
+        });
+}
+
+static
+result
+setters_bench(
+    corpus const& c,
+    std::size_t n)
+{
+    return run(c, n,
+        [](string_view s)
+        {
+            static url u;
+            u.set_encoded_url(s);
+            u.set_scheme("https");
+            u.set_encoded_host("www.example.com");
+            u.set_port("8443");
+            u.set_encoded_query("k=v");
+            u.set_encoded_fragment("");
+            g_sink = g_sink + u.size();
+        });
+}
+
+static
+result
+strip_bench(
+    corpus const& c,
+    std::size_t n)
+{
+    // remove the tracking params
+    // in one pass over the query
+    return run(c, n,
+        [](string_view s)
+        {
+            static url u;
+            u.set_encoded_url(s);
+            g_sink = g_sink + u.params().erase_if(
+                [](url::params_type::value_type const& e)
+                {
+                    auto const k = e.encoded_key();
+                    return k.substr(0, 4) == "utm_" ||
+                        k == "gclid" || k == "fbclid";
+                });
+            g_sink = g_sink + u.size();
+        });
+}
+
+static
+result
+assign_bench(
+    corpus const& c,
+    std::size_t n)
+{
+    return run(c, n,
+        [](string_view s)
+        {
+            error_code ec;
+            auto const v = parse_uri(s, ec);
+            components c;
+            c.scheme = "https";
+            c.host = "www.example.com";
+            c.port = "8443";
+            c.path = v.encoded_path();
+            if(c.path.empty() || c.path.front() != '/')
+                c.path = "/";
+            c.query = "k=v";
+            static url u;
+            u.assign(c);
+            g_sink = g_sink + u.size();
+        });
+}
+
+static
+result
+iterate_bench(
+    corpus const& c,
+    std::size_t n)
+{
+    return run(c, n,
+        [](string_view s)
+        {
+            error_code ec;
+            auto const u = parse_uri(s, ec);
+            std::size_t m = 0;
+            for(auto e : u.segments())
+                m += e.encoded_string().size();
+            for(auto e : u.params())
+                m += e.encoded_key().size() +
+                    e.encoded_value().size();
+            g_sink = g_sink + m;
+        });
+}
+
+static
+result
+decode_bench(
+    corpus const& c,
+    std::size_t n)
+{
+    return run(c, n,
+        [](string_view s)
+        {
+            error_code ec;
+            auto const u = parse_uri(s, ec);
+            std::size_t m = 0;
+            for(auto e : u.segments())
+                m += e.string().size();
+            for(auto e : u.params())
+                m += e.key().size() +
+                    e.value().size();
+            g_sink = g_sink + m;
+        });
+}
+
+static
+result
+resolve_bench(
+    corpus const& c,
+    std::size_t n)
+{
+    // each URL is a reference found
+    // on the page with this base
+    url_view const base(
+        "https://www.example.com/docs/guide/intro.html?lang=en");
+    return run(c, n,
+        [&base](string_view s)
+        {
+            error_code ec;
+            auto const ref = parse_uri(s, ec);
+            static url u;
+            resolve(base, ref, u, ec);
+            g_sink = g_sink + u.size();
+        });
+}
+
+static
+result
+hash_bench(
+    corpus const& c,
+    std::size_t n)
+{
+    return run(c, n,
+        [](string_view s)
+        {
+            error_code ec;
+            auto const u = parse_uri(s, ec);
+            g_sink = g_sink + hash_url(u);
+        });
+}
+
+static
+result
+stats_bench(
+    corpus const& c,
+    std::size_t n)
+{
+    // tables reach their final size
+    // during the warm up, as in a log
+    url_stats st;
+    auto r = run(c, n,
+        [&st](string_view s)
+        {
+            st.insert(s);
+        });
+    g_sink = g_sink + st.urls();
+    return r;
+}
+
+static
+result
+dedup_bench(
+    corpus const& c,
+    std::size_t n)
+{
+    // after the warm up every
+    // URL is a duplicate
+    std::vector<char> buf(c.bytes);
+    url_dedup set(buf.data(), buf.size());
+    auto r = run(c, n,
+        [&set](string_view s)
+        {
+            error_code ec;
+            g_sink = g_sink +
+                set.insert(s, ec).size();
+        });
+    g_sink = g_sink + set.size();
+    return r;
+}
+
+static
+result
+host_bench(
+    corpus const& c,
+    std::size_t n)
+{
+    return run(c, n,
+        [](string_view s)
+        {
+            error_code ec;
+            auto const u = parse_uri(s, ec);
+            g_sink = g_sink + u.encoded_host().size();
+        });
+}
+
+static
+result
+idna_bench(
+    corpus const& c,
+    std::size_t n)
+{
+    // the Unicode form of the host, set
+    // back through the ASCII fast path
+    // or the IDNA conversion
+    return run(c, n,
+        [](string_view s)
+        {
+            static url u;
+            u.set_encoded_url(s);
+            error_code ec;
+            auto const h = idna_to_unicode(
+                u.encoded_host(), ec);
+            if(! ec)
+                u.set_host(h);
+            g_sink = g_sink + u.size();
+        });
+}
+
+static
+result
+reload_bench(
+    corpus const& c,
+    std::size_t n)
+{
+    // read back the records written for the
+    // corpus, instead of parsing it again
+    std::string buf;
+    for(auto s : c.urls)
+    {
+        error_code ec;
+        serialize_url(parse_uri(s, ec), buf);
+    }
+    string_view rest = buf;
+    return run(c, n,
+        [&buf, &rest](string_view)
+        {
+            if(rest.empty())
+                rest = buf;
+            error_code ec;
+            auto const u =
+                deserialize_url(rest, ec);
+            g_sink = g_sink + u.encoded_host().size();
+        });
+}
+
+static
+result
+lazy_host_bench(
+    corpus const& c,
+    std::size_t n)
+{
+    return run(c, n,
+        [](string_view s)
+        {
+            lazy_url_view const u(s);
+            g_sink = g_sink + u.encoded_host().size();
+        });
+}
+
+static
+result
+router_bench(
+    corpus const& c,
+    std::size_t n)
+{
+    // a table of a few hundred routes,
+    // with a catch-all so that every
+    // path matches something
+    router r;
+    for(int i = 0; i < 100; ++i)
+    {
+        auto const v = std::to_string(i);
+        r.insert("/api/v" + v + "/users/{id}");
+        r.insert("/api/v" + v + "/users/{id}/posts/{post}");
+        r.insert("/static/r" + v + "/*");
+    }
+    r.insert("/{a}");
+    r.insert("/*");
+    return run(c, n,
+        [&r](string_view s)
+        {
+            error_code ec;
+            auto const u = parse_uri(s, ec);
+            router::match_results m;
+            if(r.match(u, m))
+                g_sink = g_sink + m.route();
+        });
+}
+
+static
+result
+regex_bench(
+    corpus const& c,
+    std::size_t n)
+{
+    // rfc3986 Appendix B
+    static std::regex const re(
+        "^(([^:/?#]+):)?(//([^/?#]*))?([^?#]*)"
+        "(\\?([^#]*))?(#(.*))?");
+    return run(c, n,
+        [](string_view s)
+        {
+            std::cmatch m;
+            std::regex_match(
+                s.data(), s.data() + s.size(),
+                m, re);
+            g_sink = g_sink + m.size();
+        });
+}
+
+static
+benchmark const benchmarks[] = {
+    { "parse_uri",  &parse_uri_bench },
+    { "parse_table", &parse_table_bench },
+    { "validate",   &validate_bench },
+    { "target",     &request_target_bench },
+    { "stream",     &stream_bench },
+    { "url",        &url_bench },
+    { "setters",    &setters_bench },
+    { "strip",      &strip_bench },
+    { "assign",     &assign_bench },
+    { "iterate",    &iterate_bench },
+    { "decode",     &decode_bench },
+    { "resolve",    &resolve_bench },
+    { "hash",       &hash_bench },
+    { "stats",      &stats_bench },
+    { "dedup",      &dedup_bench },
+    { "router",     &router_bench },
+    { "host",       &host_bench },
+    { "lazy_host",  &lazy_host_bench },
+    { "reload",     &reload_bench },
+    { "idna",       &idna_bench },
+    { "std_regex",  &regex_bench },
+};
+
+static
+void
+report(
+    bool json,
+    benchmark const& b,
+    corpus const& c,
+    result const& r)
+{
+    auto const ns =
+        r.seconds * 1e9 / r.ops;
+    auto const mbs =
+        r.bytes / r.seconds / 1e6;
+    auto const apo =
+        static_cast<double>(r.allocs) / r.ops;
+    if(json)
+        std::printf(
+            "{\"bench\":\"%s\",\"corpus\":\"%s\","
+            "\"ops\":%zu,\"ns_per_url\":%.2f,"
+            "\"mb_per_s\":%.2f,\"allocs_per_op\":%.3f}\n",
+            b.name, c.name, r.ops, ns, mbs, apo);
+    else
+        std::printf(
+            "%-11s %-9s %10.2f ns/url %9.2f MB/s %7.3f allocs/op\n",
+            b.name, c.name, ns, mbs, apo);
+}
+
+} // bench
+} // urls
+} // boost
+
+int
+main(int argc, char** argv)
+{
+    using namespace boost::urls::bench;
+
+    bool json = false;
+    std::size_t iterations = 20000;
+    char const* filter = "";
+    for(int i = 1; i < argc; ++i)
+    {
+        if(std::strcmp(argv[i], "--json") == 0)
+            json = true;
+        else if(std::strcmp(argv[i], "--iterations") == 0 &&
+            i + 1 < argc)
+            iterations = std::strtoul(argv[++i], nullptr, 10);
+        else
+            filter = argv[i];
+    }
+
+    for(auto const& b : benchmarks)
+    {
+        for(auto const& c : corpora())
+        {
+            auto const name =
+                std::string(b.name) + "/" + c.name;
+            if(name.find(filter) == std::string::npos)
+                continue;
+            report(json, b, c, b.fn(c, iterations));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,287 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+/*  Log file URL statistics
+
+    Usage:
+
+        log_stats <file> [threads]
+
+    The file holds one URL per line. It is mapped
+    into memory and split into chunks at newline
+    boundaries. Each thread parses the chunks of
+    its own share in order, then steals the chunks
+    left in the shares of other threads, so a slow
+    thread does not hold up the rest. Every thread
+    counts into its own url_stats, and the tables
+    are merged once at the end.
+*/
+
+#include <boost/url/url_stats.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define LOG_STATS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace urls = boost::urls;
+using urls::string_view;
+
+//----------------------------------------------------------
+
+// The contents of a file, mapped when possible
+class file_text
+{
+    char const* p_ = nullptr;
+    std::size_t n_ = 0;
+    bool mapped_ = false;
+    std::string buf_;
+
+public:
+    file_text() = default;
+    file_text(file_text const&) = delete;
+    file_text& operator=(file_text const&) = delete;
+
+    ~file_text()
+    {
+#ifdef LOG_STATS_MMAP
+        if(mapped_)
+            ::munmap(const_cast<char*>(p_), n_);
+#endif
+    }
+
+    string_view
+    text() const noexcept
+    {
+        return string_view(p_, n_);
+    }
+
+    bool
+    open(char const* path)
+    {
+#ifdef LOG_STATS_MMAP
+        int const fd = ::open(path, O_RDONLY);
+        if(fd < 0)
+            return false;
+        struct stat st;
+        if(::fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            n_ = static_cast<std::size_t>(st.st_size);
+            void* p = ::mmap(nullptr, n_,
+                PROT_READ, MAP_PRIVATE, fd, 0);
+            if(p != MAP_FAILED)
+            {
+                ::madvise(p, n_, MADV_SEQUENTIAL);
+                p_ = static_cast<char const*>(p);
+                mapped_ = true;
+                ::close(fd);
+                return true;
+            }
+            n_ = 0;
+        }
+        ::close(fd);
+#endif
+        // read the whole file instead
+        std::ifstream is(path, std::ios::binary);
+        if(! is)
+            return false;
+        buf_.assign(
+            std::istreambuf_iterator<char>(is),
+            std::istreambuf_iterator<char>());
+        p_ = buf_.data();
+        n_ = buf_.size();
+        return true;
+    }
+};
+
+//----------------------------------------------------------
+
+// Split text into pieces of about the given
+// size, each ending just after a newline
+std::vector<string_view>
+split(
+    string_view s,
+    std::size_t size)
+{
+    std::vector<string_view> v;
+    auto p = s.data();
+    auto const end = p + s.size();
+    while(p < end)
+    {
+        auto q = p + (std::min)(
+            size, static_cast<std::size_t>(end - p));
+        if(q < end)
+        {
+            auto const nl = static_cast<char const*>(
+                std::memchr(q, '\n', end - q));
+            q = nl ? nl + 1 : end;
+        }
+        v.emplace_back(p, q - p);
+        p = q;
+    }
+    return v;
+}
+
+// The chunks assigned to one thread
+struct share
+{
+    std::atomic<std::size_t> next;
+    std::size_t last;
+
+    share()
+        : next(0)
+        , last(0)
+    {
+    }
+};
+
+class scheduler
+{
+    std::vector<string_view> const& chunks_;
+    std::unique_ptr<share[]> shares_;
+    std::size_t n_;
+
+public:
+    scheduler(
+        std::vector<string_view> const& chunks,
+        std::size_t threads)
+        : chunks_(chunks)
+        , shares_(new share[threads])
+        , n_(threads)
+    {
+        auto const size = chunks.size();
+        for(std::size_t i = 0; i < n_; ++i)
+        {
+            shares_[i].next = size * i / n_;
+            shares_[i].last = size * (i + 1) / n_;
+        }
+    }
+
+    // Return the next chunk for thread i, or
+    // false when there are no chunks left
+    bool
+    take(
+        std::size_t i,
+        string_view& s)
+    {
+        for(std::size_t k = 0; k < n_; ++k)
+        {
+            auto& sh = shares_[(i + k) % n_];
+            // cheap check before the increment
+            if(sh.next.load(
+                std::memory_order_relaxed) >= sh.last)
+                continue;
+            auto const j = sh.next.fetch_add(1,
+                std::memory_order_relaxed);
+            if(j < sh.last)
+            {
+                s = chunks_[j];
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+//----------------------------------------------------------
+
+void
+print(
+    char const* title,
+    urls::url_stats::table_type const& t)
+{
+    std::printf("\n%s (%zu):\n", title, t.size());
+    for(auto const& e :
+            urls::url_stats::top(t, 10))
+        std::printf("  %10zu  %s\n",
+            e.second, e.first.c_str());
+}
+
+int
+main(int argc, char** argv)
+{
+    if(argc < 2 || argc > 3)
+    {
+        std::fprintf(stderr,
+            "Usage: %s <file> [threads]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::size_t threads =
+        std::thread::hardware_concurrency();
+    if(argc == 3)
+        threads = std::strtoul(argv[2], nullptr, 10);
+    if(threads == 0)
+        threads = 1;
+
+    file_text f;
+    if(! f.open(argv[1]))
+    {
+        std::fprintf(stderr,
+            "%s: cannot open %s\n", argv[0], argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    auto const t0 =
+        std::chrono::steady_clock::now();
+
+    // many more chunks than threads,
+    // so that stealing can balance them
+    auto const chunks = split(f.text(), 1 << 20);
+    scheduler sched(chunks, threads);
+    std::vector<urls::url_stats> stats(threads);
+    std::vector<std::thread> pool;
+    for(std::size_t i = 0; i < threads; ++i)
+        pool.emplace_back(
+            [i, &sched, &stats]
+            {
+                string_view s;
+                while(sched.take(i, s))
+                    stats[i].insert_lines(s);
+            });
+    for(auto& t : pool)
+        t.join();
+
+    urls::url_stats total;
+    for(auto const& st : stats)
+        total.merge(st);
+
+    auto const t1 =
+        std::chrono::steady_clock::now();
+    auto const seconds = std::chrono::duration<
+        double>(t1 - t0).count();
+
+    std::printf(
+        "%zu urls, %zu errors, %zu bytes\n"
+        "%zu threads, %.3f s, %.1f MB/s\n",
+        total.urls(), total.errors(), f.text().size(),
+        threads, seconds,
+        f.text().size() / 1e6 /
+            (seconds > 0 ? seconds : 1));
+    print("hosts", total.hosts());
+    print("first segments", total.first_segments());
+    print("param keys", total.param_keys());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,327 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+/*  Driver for the fuzz targets, without libFuzzer
+
+    Usage:
+
+        fuzz_X [file]...
+        fuzz_X --perf [--limit NS] [--growth X]
+            [--count N] [--max-size N] [--runs N] [file]...
+
+    Each file is given once to the target, or, when
+    there are none, standard input is, as AFL
+    expects. A failed check aborts.
+
+    With --perf, the time taken by the target is
+    measured for each file, or else for --count
+    inputs made of repeated pieces of URLs of up
+    to --max-size bytes. Each input is run --runs
+    times and the fastest run is kept. An input
+    is reported when its time per byte is above
+    --limit nanoseconds. A made input is also
+    reported when its time per byte is more than
+    --growth times that of the same input with a
+    quarter of the repeats, which finds work that
+    is not linear in the size: for quadratic work
+    the ratio is four. Under libFuzzer, use
+    -report_slow_units and -timeout instead.
+*/
+
+#include "fuzz.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool
+read_file(
+    std::FILE* f,
+    std::string& s)
+{
+    s.clear();
+    char buf[4096];
+    for(;;)
+    {
+        auto const n = std::fread(
+            buf, 1, sizeof(buf), f);
+        s.append(buf, n);
+        if(n < sizeof(buf))
+            return std::ferror(f) == 0;
+    }
+}
+
+bool
+read_file(
+    char const* path,
+    std::string& s)
+{
+    auto const f = std::fopen(path, "rb");
+    if(! f)
+        return false;
+    auto const ok = read_file(f, s);
+    std::fclose(f);
+    return ok;
+}
+
+void
+run(std::string const& s)
+{
+    LLVMFuzzerTestOneInput(
+        reinterpret_cast<
+            std::uint8_t const*>(s.data()),
+        s.size());
+}
+
+// printable, and not too long
+void
+print(std::string const& s)
+{
+    std::size_t const max = 80;
+    for(std::size_t i = 0;
+        i < s.size() && i < max; ++i)
+    {
+        auto const c = static_cast<
+            unsigned char>(s[i]);
+        if(c >= 0x20 && c < 0x7f && c != '\\')
+            std::putchar(c);
+        else
+            std::printf("\\x%02x", c);
+    }
+    if(s.size() > max)
+        std::printf("...");
+}
+
+//----------------------------------------------------------
+
+struct perf_options
+{
+    double limit = 200;
+    double growth = 2.5;
+    std::size_t count = 10000;
+    std::size_t max_size = 4096;
+    int runs = 5;
+};
+
+// A long input made of one short unit,
+// repeated, after an optional prefix
+struct made_input
+{
+    std::string prefix;
+    std::string unit;
+    std::size_t repeats = 0;
+
+    std::string
+    get(std::size_t n) const
+    {
+        auto s = prefix;
+        for(std::size_t i = 0; i < n; ++i)
+            s += unit;
+        return s;
+    }
+};
+
+made_input
+make_input(
+    std::uint32_t& seed,
+    std::size_t max_size)
+{
+    static char const* const prefixes[] = {
+        "", "http://", "//", "x:", "/", "?", "#",
+        "http://[", "//u@", "https://h/",
+        };
+    static char const* const pieces[] = {
+        "a", "0", "1", "255", ".", ":", "::", "/",
+        "//", "?", "#", "@", "[", "]", "%", "%4",
+        "%41", "%g", "=", "&", "+", "-", "~",
+        "[::1]", "1.2.3.4", "FFFF", "ffff:", "x:",
+        "\x80", " ",
+        };
+    auto const rand = [&seed]
+    {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) & 0x7fff;
+    };
+    made_input m;
+    m.prefix = prefixes[rand() %
+        (sizeof(prefixes) / sizeof(prefixes[0]))];
+    auto const n = 1 + rand() % 4;
+    for(unsigned i = 0; i < n; ++i)
+        m.unit += pieces[rand() %
+            (sizeof(pieces) / sizeof(pieces[0]))];
+    auto const size = 1 + (
+        (static_cast<std::size_t>(rand()) << 15) |
+        rand()) % max_size;
+    if(size > m.prefix.size())
+        m.repeats = (size - m.prefix.size()) /
+            m.unit.size();
+    return m;
+}
+
+// Returns the fastest time of
+// the runs, in nanoseconds
+double
+measure(
+    std::string const& s,
+    int runs)
+{
+    using clock = std::chrono::steady_clock;
+    double best = 0;
+    for(int i = 0; i < runs; ++i)
+    {
+        auto const t0 = clock::now();
+        run(s);
+        auto const t1 = clock::now();
+        auto const ns = std::chrono::duration<
+            double, std::nano>(t1 - t0).count();
+        if(i == 0 || ns < best)
+            best = ns;
+    }
+    return best;
+}
+
+int
+perf(
+    perf_options const& opt,
+    std::vector<std::string> const& files)
+{
+    std::size_t slow = 0;
+    double worst = 0;
+    std::string worst_input;
+    // a fixed cost for each call
+    auto const per_byte =
+        [&opt](std::string const& s)
+        {
+            return measure(s, opt.runs) /
+                static_cast<double>((std::max)(
+                    s.size(), std::size_t(16)));
+        };
+    auto const check =
+        [&](std::string const& s,
+            made_input const* m)
+        {
+            auto const t = per_byte(s);
+            if(t > worst)
+            {
+                worst = t;
+                worst_input = s;
+            }
+            double g = 0;
+            if(m && s.size() >= 256)
+                g = t / per_byte(
+                    m->get(m->repeats / 4));
+            if( t <= opt.limit &&
+                g <= opt.growth)
+                return;
+            ++slow;
+            std::printf("slow: %.1f ns/byte, growth %.1f, "
+                "%zu bytes: ", t, g, s.size());
+            print(s);
+            std::printf("\n");
+        };
+    std::string s;
+    if(! files.empty())
+    {
+        for(auto const& f : files)
+        {
+            if(! read_file(f.c_str(), s))
+            {
+                std::fprintf(stderr,
+                    "can't read %s\n", f.c_str());
+                return EXIT_FAILURE;
+            }
+            check(s, nullptr);
+        }
+    }
+    else
+    {
+        std::uint32_t seed = 1;
+        for(std::size_t i = 0; i < opt.count; ++i)
+        {
+            auto const m = make_input(
+                seed, opt.max_size);
+            check(m.get(m.repeats), &m);
+        }
+    }
+    std::printf("%zu slow, worst %.1f ns/byte: ",
+        slow, worst);
+    print(worst_input);
+    std::printf("\n");
+    return slow == 0 ?
+        EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // (anon)
+
+int
+main(int argc, char** argv)
+{
+    bool use_perf = false;
+    perf_options opt;
+    std::vector<std::string> files;
+    for(int i = 1; i < argc; ++i)
+    {
+        auto const arg = argv[i];
+        auto const value = [&]
+        {
+            if(i + 1 >= argc)
+            {
+                std::fprintf(stderr,
+                    "%s needs a value\n", arg);
+                std::exit(EXIT_FAILURE);
+            }
+            return argv[++i];
+        };
+        if(std::strcmp(arg, "--perf") == 0)
+            use_perf = true;
+        else if(std::strcmp(arg, "--limit") == 0)
+            opt.limit = std::atof(value());
+        else if(std::strcmp(arg, "--growth") == 0)
+            opt.growth = std::atof(value());
+        else if(std::strcmp(arg, "--count") == 0)
+            opt.count = std::strtoul(value(), nullptr, 10);
+        else if(std::strcmp(arg, "--max-size") == 0)
+            opt.max_size = (std::max)(std::size_t(1),
+                static_cast<std::size_t>(
+                    std::strtoul(value(), nullptr, 10)));
+        else if(std::strcmp(arg, "--runs") == 0)
+            opt.runs = (std::max)(1, std::atoi(value()));
+        else
+            files.emplace_back(arg);
+    }
+    if(use_perf)
+        return perf(opt, files);
+
+    std::string s;
+    if(files.empty())
+    {
+        if(! read_file(stdin, s))
+            return EXIT_FAILURE;
+        run(s);
+        return EXIT_SUCCESS;
+    }
+    for(auto const& f : files)
+    {
+        if(! read_file(f.c_str(), s))
+        {
+            std::fprintf(stderr,
+                "can't read %s\n", f.c_str());
+            return EXIT_FAILURE;
+        }
+        run(s);
+    }
+    std::printf("%zu inputs\n", files.size());
+    return EXIT_SUCCESS;
+}
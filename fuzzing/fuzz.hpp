@@ -0,0 +1,70 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_FUZZING_FUZZ_HPP
+#define BOOST_URL_FUZZING_FUZZ_HPP
+
+#include <boost/url/config.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+/*  Shared by the fuzz targets
+
+    Every target defines LLVMFuzzerTestOneInput,
+    the entry point of libFuzzer. A failed check
+    aborts, so that the fuzzer or the driver keeps
+    the input which caused it.
+*/
+
+extern "C"
+int
+LLVMFuzzerTestOneInput(
+    std::uint8_t const* data,
+    std::size_t size);
+
+#define BOOST_URL_FUZZ_CHECK(cond) \
+    ((cond) ? (void)0 : ::boost::urls::fuzz::fail( \
+        #cond, __FILE__, __LINE__))
+
+namespace boost {
+namespace urls {
+namespace fuzz {
+
+[[noreturn]]
+inline
+void
+fail(
+    char const* expr,
+    char const* file,
+    int line) noexcept
+{
+    std::fprintf(stderr,
+        "%s(%d): check failed: %s\n",
+        file, line, expr);
+    std::abort();
+}
+
+inline
+string_view
+make_string(
+    std::uint8_t const* data,
+    std::size_t size) noexcept
+{
+    return string_view(
+        reinterpret_cast<
+            char const*>(data), size);
+}
+
+} // fuzz
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,213 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+/*  Every other way of parsing a URL, compared
+    with the reference parser, detail::parse_url
+
+    table       parse_url_table, the same error and parts
+    validate    validate_url, the same error
+    lazy        lazy_url_view, the same result
+    stream      url_parser, fed in pieces, the same result
+    serial      serialize_url and deserialize_url, the
+                same parts after a round trip
+*/
+
+#include "fuzz.hpp"
+
+#include <boost/url/lazy_url_view.hpp>
+#include <boost/url/parse.hpp>
+#include <boost/url/serialize.hpp>
+#include <boost/url/url_parser.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/url/detail/parse.hpp>
+#include <boost/url/detail/table_parse.hpp>
+#include <boost/url/detail/validate.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+using namespace boost::urls;
+
+namespace {
+
+bool
+same(
+    detail::parts const& pt0,
+    detail::parts const& pt1) noexcept
+{
+    for(int i = 0; i <= detail::id_end; ++i)
+        if(pt0.offset[i] != pt1.offset[i])
+            return false;
+    if( pt0.host == host_type::ipv4 &&
+        std::memcmp(pt0.ip, pt1.ip, 4) != 0)
+        return false;
+    if( pt0.host == host_type::ipv6 &&
+        std::memcmp(pt0.ip, pt1.ip, 16) != 0)
+        return false;
+    return
+        pt0.nseg == pt1.nseg &&
+        pt0.nparam == pt1.nparam &&
+        pt0.host == pt1.host &&
+        pt0.scheme_id == pt1.scheme_id &&
+        pt0.port_number == pt1.port_number;
+}
+
+template<class View>
+bool
+same(
+    url_view const& u0,
+    View const& u1)
+{
+    return
+        u0.encoded_url() == u1.encoded_url() &&
+        u0.scheme() == u1.scheme() &&
+        u0.scheme_id() == u1.scheme_id() &&
+        u0.has_authority() == u1.has_authority() &&
+        u0.encoded_user() == u1.encoded_user() &&
+        u0.encoded_password() == u1.encoded_password() &&
+        u0.host_type() == u1.host_type() &&
+        u0.encoded_host() == u1.encoded_host() &&
+        u0.port_part() == u1.port_part() &&
+        u0.port_number() == u1.port_number() &&
+        u0.encoded_path() == u1.encoded_path() &&
+        u0.segments().size() == u1.segments().size() &&
+        u0.query_part() == u1.query_part() &&
+        u0.params().size() == u1.params().size() &&
+        u0.fragment_part() == u1.fragment_part();
+}
+
+bool
+same_ip(
+    url_view const& u0,
+    url_view const& u1)
+{
+    return
+        u0.ipv4_address() == u1.ipv4_address() &&
+        u0.ipv6_address() == u1.ipv6_address();
+}
+
+// Feed s to a url_parser in pieces of size k.
+// Returns true if all of s was accepted.
+bool
+stream(
+    url_parser& pr,
+    string_view s,
+    std::size_t k)
+{
+    error_code ec;
+    std::size_t n = 0;
+    while(n < s.size())
+    {
+        auto const m = (std::min)(
+            k, s.size() - n);
+        auto const used = pr.write(
+            s.substr(n, m), ec);
+        n += used;
+        if(ec == error::need_more)
+            continue;
+        if(ec || used != m)
+            return false;
+    }
+    if(! pr.is_done())
+        pr.finish(ec);
+    return ! ec && pr.size() == s.size();
+}
+
+} // (anon)
+
+extern "C"
+int
+LLVMFuzzerTestOneInput(
+    std::uint8_t const* data,
+    std::size_t size)
+{
+    auto const s =
+        fuzz::make_string(data, size);
+
+    // reference
+    detail::parts pt0;
+    error_code ec0;
+    detail::parse_url(pt0, s, ec0);
+    url_view const u0 =
+        parse_uri(s, ec0);
+
+    // table
+    {
+        detail::parts pt1;
+        error_code ec1;
+        detail::parse_url_table(pt1, s, ec1);
+        BOOST_URL_FUZZ_CHECK(ec0 == ec1);
+        if(! ec0)
+            BOOST_URL_FUZZ_CHECK(same(pt0, pt1));
+    }
+
+    // validate
+    {
+        error_code ec1;
+        auto const n =
+            detail::validate_url(s, ec1);
+        BOOST_URL_FUZZ_CHECK(ec0 == ec1);
+        BOOST_URL_FUZZ_CHECK(
+            (n == s.size()) || ec1);
+        BOOST_URL_FUZZ_CHECK(n <= s.size());
+    }
+
+    // lazy
+    {
+        lazy_url_view const u1(s);
+        error_code ec1;
+        auto const v = u1.validate(ec1);
+        BOOST_URL_FUZZ_CHECK(! ec0 == ! ec1);
+        if(! ec0)
+        {
+            BOOST_URL_FUZZ_CHECK(same(u0, u1));
+            BOOST_URL_FUZZ_CHECK(same(u0, v));
+            BOOST_URL_FUZZ_CHECK(same_ip(u0, v));
+        }
+    }
+
+    // stream, in pieces of a size
+    // chosen by the input
+    {
+        std::size_t const k = size > 0 ?
+            1 + data[0] % 16 : 1;
+        url_parser pr;
+        auto const all = stream(pr, s, k);
+        if(ec0)
+        {
+            BOOST_URL_FUZZ_CHECK(! all);
+        }
+        else
+        {
+            BOOST_URL_FUZZ_CHECK(all);
+            auto const v = pr.result(s);
+            BOOST_URL_FUZZ_CHECK(same(u0, v));
+            BOOST_URL_FUZZ_CHECK(same_ip(u0, v));
+        }
+    }
+
+    // serial
+    if(! ec0)
+    {
+        std::string buf;
+        serialize_url(u0, buf);
+        BOOST_URL_FUZZ_CHECK(
+            buf.size() == serialized_size(u0));
+        string_view b = buf;
+        error_code ec1;
+        auto const v =
+            deserialize_url(b, ec1);
+        BOOST_URL_FUZZ_CHECK(! ec1);
+        BOOST_URL_FUZZ_CHECK(b.empty());
+        BOOST_URL_FUZZ_CHECK(same(u0, v));
+        BOOST_URL_FUZZ_CHECK(same_ip(u0, v));
+    }
+    return 0;
+}
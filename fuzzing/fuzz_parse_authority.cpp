@@ -0,0 +1,64 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// An authority on its own, and as the
+// authority of a URL
+
+#include "fuzz.hpp"
+
+#include <boost/url/detail/parse.hpp>
+
+#include <cstring>
+#include <string>
+
+using namespace boost::urls;
+
+extern "C"
+int
+LLVMFuzzerTestOneInput(
+    std::uint8_t const* data,
+    std::size_t size)
+{
+    auto const s =
+        fuzz::make_string(data, size);
+    detail::parts pt0;
+    error_code ec0;
+    detail::parse_authority(pt0, s, ec0);
+
+    // "//" s is a URL with the same authority,
+    // unless s holds the start of a path,
+    // query, or fragment
+    if(s.find_first_of("/?#") != string_view::npos)
+        return 0;
+    std::string u = "//";
+    u.append(s.data(), s.size());
+    detail::parts pt1;
+    error_code ec1;
+    detail::parse_url(pt1, u, ec1);
+    BOOST_URL_FUZZ_CHECK(! ec0 == ! ec1);
+    if(ec0)
+        return 0;
+    BOOST_URL_FUZZ_CHECK(
+        pt0.host == pt1.host);
+    BOOST_URL_FUZZ_CHECK(
+        pt0.port_number == pt1.port_number);
+    BOOST_URL_FUZZ_CHECK(
+        pt0.length(detail::id_host) ==
+        pt1.length(detail::id_host));
+    BOOST_URL_FUZZ_CHECK(
+        pt0.length(detail::id_port) ==
+        pt1.length(detail::id_port));
+    if(pt0.host == host_type::ipv4)
+        BOOST_URL_FUZZ_CHECK(std::memcmp(
+            pt0.ip, pt1.ip, 4) == 0);
+    if(pt0.host == host_type::ipv6)
+        BOOST_URL_FUZZ_CHECK(std::memcmp(
+            pt0.ip, pt1.ip, 16) == 0);
+    return 0;
+}
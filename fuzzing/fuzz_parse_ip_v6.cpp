@@ -0,0 +1,73 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// The IPv6 matcher, whose address must
+// survive a round trip through text
+
+#include "fuzz.hpp"
+
+#include <boost/url/detail/parse.hpp>
+
+#include <cstring>
+#include <string>
+
+using namespace boost::urls;
+
+extern "C"
+int
+LLVMFuzzerTestOneInput(
+    std::uint8_t const* data,
+    std::size_t size)
+{
+    auto const s =
+        fuzz::make_string(data, size);
+    unsigned char a0[16];
+    error_code ec;
+    detail::parser pr0(s);
+    pr0.parse_ip_v6(a0, ec);
+    if(ec)
+        return 0;
+    BOOST_URL_FUZZ_CHECK(
+        pr0.p_ > pr0.begin_ &&
+        pr0.p_ <= pr0.end_);
+    auto const t = s.substr(0,
+        pr0.p_ - pr0.begin_);
+
+    // all eight words, in full
+    static char const hex[] =
+        "0123456789abcdef";
+    std::string w;
+    for(int i = 0; i < 16; ++i)
+    {
+        if(i > 0 && i % 2 == 0)
+            w.push_back(':');
+        w.push_back(hex[a0[i] >> 4]);
+        w.push_back(hex[a0[i] & 0xf]);
+    }
+    unsigned char a1[16];
+    detail::parser pr1(w);
+    pr1.parse_ip_v6(a1, ec);
+    BOOST_URL_FUZZ_CHECK(! ec);
+    BOOST_URL_FUZZ_CHECK(pr1.done());
+    BOOST_URL_FUZZ_CHECK(
+        std::memcmp(a0, a1, 16) == 0);
+
+    // as the host of a URL
+    std::string u = "//[";
+    u.append(t.data(), t.size());
+    u.push_back(']');
+    detail::parts pt;
+    detail::parse_url(pt, u, ec);
+    BOOST_URL_FUZZ_CHECK(! ec);
+    BOOST_URL_FUZZ_CHECK(
+        pt.host == host_type::ipv6);
+    BOOST_URL_FUZZ_CHECK(
+        std::memcmp(a0, pt.ip, 16) == 0);
+    return 0;
+}
@@ -0,0 +1,81 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// The reference parser, and the views and
+// containers built on the parts it finds
+
+#include "fuzz.hpp"
+
+#include <boost/url/detail/parse.hpp>
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+
+using namespace boost::urls;
+
+extern "C"
+int
+LLVMFuzzerTestOneInput(
+    std::uint8_t const* data,
+    std::size_t size)
+{
+    auto const s =
+        fuzz::make_string(data, size);
+    detail::parts pt;
+    error_code ec;
+    detail::parse_url(pt, s, ec);
+    if(ec)
+        return 0;
+
+    // the parts cover the string, in order
+    for(int id = 0; id < detail::id_end; ++id)
+        BOOST_URL_FUZZ_CHECK(
+            pt.offset[id] <= pt.offset[id + 1]);
+    BOOST_URL_FUZZ_CHECK(
+        pt.offset[detail::id_end] == s.size());
+
+    url_view const u(s);
+    BOOST_URL_FUZZ_CHECK(u.encoded_url() == s);
+
+    // the counts match the containers
+    std::size_t n = 0;
+    for(auto const& e : u.segments())
+    {
+        (void)e.decoded().size();
+        ++n;
+    }
+    BOOST_URL_FUZZ_CHECK(n == pt.nseg);
+    BOOST_URL_FUZZ_CHECK(n == u.segments().size());
+    n = 0;
+    for(auto const& e : u.params())
+    {
+        (void)e.decoded_key().size();
+        (void)e.decoded_value().size();
+        ++n;
+    }
+    BOOST_URL_FUZZ_CHECK(n == pt.nparam);
+    BOOST_URL_FUZZ_CHECK(n == u.params().size());
+
+    // decoding a valid part cannot fail
+    (void)u.decoded_user().size();
+    (void)u.decoded_password().size();
+    (void)u.decoded_host().size();
+    (void)u.decoded_query().size();
+    (void)u.decoded_fragment().size();
+
+    // a copy has the same parts
+    url const v(u.encoded_url());
+    BOOST_URL_FUZZ_CHECK(v.encoded_url() == s);
+    BOOST_URL_FUZZ_CHECK(v.scheme() == u.scheme());
+    BOOST_URL_FUZZ_CHECK(v.encoded_host() == u.encoded_host());
+    BOOST_URL_FUZZ_CHECK(v.port_number() == u.port_number());
+    BOOST_URL_FUZZ_CHECK(v.encoded_path() == u.encoded_path());
+    BOOST_URL_FUZZ_CHECK(v.encoded_query() == u.encoded_query());
+    BOOST_URL_FUZZ_CHECK(v.encoded_fragment() == u.encoded_fragment());
+    return 0;
+}
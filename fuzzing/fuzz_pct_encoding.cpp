@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// The functions of pct_encoding, for the set
+// chosen by the first byte of the input
+
+#include "fuzz.hpp"
+
+#include <boost/url/detail/char_type.hpp>
+
+#include <string>
+
+using namespace boost::urls;
+
+namespace {
+
+detail::pct_encoding
+select(unsigned char c) noexcept
+{
+    switch(c % 8)
+    {
+    case 0: return detail::reg_name_pct_set();
+    case 1: return detail::userinfo_pct_set();
+    case 2: return detail::pchar_pct_set();
+    case 3: return detail::pchar_nc_pct_set();
+    case 4: return detail::frag_pct_set();
+    case 5: return detail::qkey_pct_set();
+    case 6: return detail::qval_pct_set();
+    default:
+        break;
+    }
+    return detail::param_key_pct_set();
+}
+
+// encode, and check that the
+// result decodes to s
+void
+round_trip(
+    detail::pct_encoding const& e,
+    string_view s)
+{
+    std::string t(e.encoded_size(s), '\0');
+    auto const n = e.encode(&t[0], s);
+    BOOST_URL_FUZZ_CHECK(n == t.size());
+    error_code ec;
+    auto const m = e.decoded_size(t, ec);
+    BOOST_URL_FUZZ_CHECK(! ec);
+    BOOST_URL_FUZZ_CHECK(m == s.size());
+    std::string d(m, '\0');
+    auto const end = detail::pct_encoding::decode(
+        &d[0], t);
+    BOOST_URL_FUZZ_CHECK(end == &d[0] + d.size());
+    BOOST_URL_FUZZ_CHECK(d == s);
+}
+
+} // (anon)
+
+extern "C"
+int
+LLVMFuzzerTestOneInput(
+    std::uint8_t const* data,
+    std::size_t size)
+{
+    if(size == 0)
+        return 0;
+    auto const e = select(data[0]);
+    auto const s =
+        fuzz::make_string(data + 1, size - 1);
+
+    // parse stops at the first special
+    // character, or at a bad escape
+    error_code ec0;
+    auto const p = e.parse(
+        s.data(), s.data() + s.size(), ec0);
+    BOOST_URL_FUZZ_CHECK(
+        p >= s.data() &&
+        p <= s.data() + s.size());
+    auto const valid = e.check(s);
+    BOOST_URL_FUZZ_CHECK(valid == (
+        ! ec0 && p == s.data() + s.size()));
+
+    // any string may be encoded
+    round_trip(e, s);
+    if(! valid)
+        return 0;
+
+    error_code ec1;
+    auto const n = e.decoded_size(s, ec1);
+    BOOST_URL_FUZZ_CHECK(! ec1);
+    BOOST_URL_FUZZ_CHECK(n ==
+        detail::pct_encoding::raw_decoded_size(s));
+    std::string d(n, '\0');
+    auto const end = detail::pct_encoding::decode(
+        &d[0], s);
+    BOOST_URL_FUZZ_CHECK(end == &d[0] + d.size());
+    round_trip(e, d);
+    return 0;
+}
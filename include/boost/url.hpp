@@ -13,10 +13,32 @@
 #include <boost/url/config.hpp>
 
 #include <boost/url/url_base.hpp>
+#include <boost/url/components.hpp>
+#include <boost/url/decoded_view.hpp>
 #include <boost/url/error.hpp>
+#include <boost/url/growth_policy.hpp>
+#include <boost/url/hash.hpp>
 #include <boost/url/host_type.hpp>
+#include <boost/url/idna.hpp>
+#include <boost/url/instrument.hpp>
+#include <boost/url/interned_url.hpp>
+#include <boost/url/lazy_url_view.hpp>
+#include <boost/url/normalize_flags.hpp>
+#include <boost/url/origin_pool.hpp>
+#include <boost/url/params_index.hpp>
+#include <boost/url/parse.hpp>
+#include <boost/url/parser_kind.hpp>
+#include <boost/url/resolve.hpp>
+#include <boost/url/result.hpp>
+#include <boost/url/router.hpp>
 #include <boost/url/scheme.hpp>
+#include <boost/url/segments_index.hpp>
+#include <boost/url/serialize.hpp>
 #include <boost/url/static_pool.hpp>
+#include <boost/url/url_literal.hpp>
+#include <boost/url/url_dedup.hpp>
+#include <boost/url/url_parser.hpp>
+#include <boost/url/url_stats.hpp>
 #include <boost/url/url_view.hpp>
 #include <boost/url/urls.hpp>
 
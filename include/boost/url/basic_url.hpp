@@ -11,24 +11,37 @@
 #define BOOST_URL_BASIC_URL_HPP
 
 #include <boost/url/config.hpp>
+#include <boost/url/growth_policy.hpp>
 #include <boost/url/url_base.hpp>
 #include <boost/url/detail/storage.hpp>
+#include <cstring>
+#include <memory>
 #include <utility>
 
 namespace boost {
 namespace urls {
 
 /** A container for storing a URL.
+
+    @tparam Allocator The allocator of the buffer.
+
+    @tparam GrowthPolicy Decides the new capacity
+    when the buffer must grow, such as
+    @ref geometric_growth, the default, or
+    @ref exact_growth.
 */
-template<class Allocator>
+template<
+    class Allocator,
+    class GrowthPolicy = geometric_growth>
 class basic_url
-    : private detail::storage_member<Allocator>
+    : private detail::storage_member<
+        Allocator, GrowthPolicy>
     , public url_base
 {
 public:
     basic_url() noexcept
         : detail::storage_member<
-            Allocator>(Allocator{})
+            Allocator, GrowthPolicy>(Allocator{})
         , url_base(static_cast<
             detail::storage&>(this->st_))
     {
@@ -39,7 +52,7 @@ public:
         string_view s,
         Allocator const& a = {})
         : detail::storage_member<
-            Allocator>(a)
+            Allocator, GrowthPolicy>(a)
         , url_base(this->st_, s)
     {
     }
@@ -48,27 +61,117 @@ public:
     basic_url(
         Allocator const& a) noexcept
         : detail::storage_member<
-            Allocator>(a)
+            Allocator, GrowthPolicy>(a)
         , url_base(this->st_)
     {
     }
 
+    /** Constructor.
+
+        The buffer is taken from `u`, which
+        becomes empty. Nothing is allocated.
+    */
     basic_url(
-        basic_url&&) noexcept
+        basic_url&& u) noexcept
+        : detail::storage_member<
+            Allocator, GrowthPolicy>(std::move(u))
+        , url_base(this->st_)
     {
+        s_ = u.s_;
+        pt_ = u.pt_;
+        u.s_ = nullptr;
+        u.pt_ = {};
     }
 
+    /** Constructor.
+
+        The characters and the offsets of the parts
+        are copied; nothing is parsed.
+
+        @par Exception Safety
+
+        Calls to allocate may throw.
+    */
     basic_url(
-        basic_url const&)
+        basic_url const& u)
+        : detail::storage_member<
+            Allocator, GrowthPolicy>(std::allocator_traits<
+                Allocator>::select_on_container_copy_construction(
+                    u.st_.get_allocator()))
+        , url_base(this->st_)
     {
+        copy(u);
     }
 
+    /** Assignment.
+
+        The characters and the offsets of the parts
+        are copied; nothing is parsed. The existing
+        buffer is reused when it is large enough.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
     basic_url&
     operator=(
-        basic_url const&)
+        basic_url const& u)
     {
+        if(this != &u)
+            copy(u);
         return *this;
     }
+
+    /** Assignment.
+
+        When the allocators are equal the buffer is
+        exchanged with the buffer of `u`, which
+        becomes empty. Otherwise the characters are
+        copied.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw when the
+        allocators are not equal.
+    */
+    basic_url&
+    operator=(
+        basic_url&& u)
+    {
+        if(this == &u)
+            return *this;
+        if(this->st_.get_allocator() !=
+            u.st_.get_allocator())
+        {
+            copy(u);
+            return *this;
+        }
+        this->st_.swap(u.st_);
+        s_ = u.s_;
+        pt_ = u.pt_;
+        // keep our old buffer in u,
+        // so it may be reused
+        u.s_ = u.st_.resize(0);
+        u.pt_ = {};
+        return *this;
+    }
+
+private:
+    void
+    copy(basic_url const& u)
+    {
+        // may reallocate, but keeps
+        // the old characters
+        auto const p =
+            this->st_.resize(u.size());
+        s_ = p;
+        if(u.size() > 0)
+            std::memcpy(s_,
+                u.s_, u.size());
+        pt_ = u.pt_;
+    }
 };
 
 } // urls
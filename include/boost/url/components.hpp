@@ -0,0 +1,81 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_COMPONENTS_HPP
+#define BOOST_URL_COMPONENTS_HPP
+
+#include <boost/url/config.hpp>
+
+namespace boost {
+namespace urls {
+
+/** The parts of a URL, used to build one in a single step.
+
+    Each member holds one part of the URL without its
+    delimiters. An empty member means the part is
+    absent. The user, password, host, query and
+    fragment are plain strings which are percent-encoded
+    as needed, the same as the corresponding setters
+    such as `set_user` and `set_query`. The path is
+    already encoded, as for `set_encoded_path`.
+
+    The URL has an authority when any of the user,
+    password, host or port is not empty, or when
+    @ref has_authority is `true`.
+
+    @par Example
+    @code
+    components c;
+    c.scheme = "https";
+    c.host = "www.example.com";
+    c.path = "/index.htm";
+    c.query = "id=42";
+    url u;
+    u.assign( c );
+    assert( u.encoded_url() == "https://www.example.com/index.htm?id=42" );
+    @endcode
+
+    @see url_base::assign
+*/
+struct components
+{
+    /// The scheme, without the trailing colon
+    string_view scheme;
+
+    /// The user, as a plain string
+    string_view user;
+
+    /// The password, as a plain string
+    string_view password;
+
+    /// The host, as a plain string or IP literal.
+    /// An internationalized name is converted
+    /// by @ref idna_to_ascii, as by `set_host`.
+    string_view host;
+
+    /// The port, without the leading colon
+    string_view port;
+
+    /// The path, as an encoded string
+    string_view path;
+
+    /// The query, as a plain string without the '?'
+    string_view query;
+
+    /// The fragment, as a plain string without the '#'
+    string_view fragment;
+
+    /// Set to `true` to add an empty authority
+    bool has_authority = false;
+};
+
+} // urls
+} // boost
+
+#endif
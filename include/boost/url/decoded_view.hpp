@@ -0,0 +1,395 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_DECODED_VIEW_HPP
+#define BOOST_URL_DECODED_VIEW_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/detail/char_type.hpp>
+#include <cstddef>
+#include <iosfwd>
+#include <iterator>
+#include <memory>
+
+namespace boost {
+namespace urls {
+
+/** A non-owning view of a percent-encoded string, as decoded characters.
+
+    Objects of this type refer to a valid
+    percent-encoded string, and present it as a
+    range of decoded characters. Escapes are
+    decoded while iterating, so the view never
+    allocates. The underlying string must remain
+    valid for as long as the view is used.
+
+    Every decoded component accessor, such as
+    @ref url_view::decoded_host, returns this type.
+
+    @par Example
+    @code
+    url_view u( "http://example.com/a%20b" );
+    for( auto e : u.segments() )
+        assert( e.decoded() == "a b" );
+    @endcode
+*/
+class decoded_view
+{
+    string_view s_;
+
+public:
+    class iterator;
+
+    /// The type of iterator
+    using const_iterator = iterator;
+
+    /// The type of decoded character
+    using value_type = char;
+
+    /// The type of decoded character
+    using reference = char;
+
+    /// The type used to represent sizes
+    using size_type = std::size_t;
+
+    /// The type used to represent differences
+    using difference_type = std::ptrdiff_t;
+
+    /** Constructor
+
+        Default constructed views are empty.
+    */
+    decoded_view() = default;
+
+    /** Constructor
+
+        @par Precondition
+        `s` is a valid percent-encoded string.
+
+        @param s The encoded string to view.
+    */
+    explicit
+    decoded_view(
+        string_view s) noexcept
+        : s_(s)
+    {
+    }
+
+    /** Return the encoded string.
+    */
+    string_view
+    encoded() const noexcept
+    {
+        return s_;
+    }
+
+    /** Return `true` if there are no decoded characters.
+    */
+    bool
+    empty() const noexcept
+    {
+        return s_.empty();
+    }
+
+    /** Return the number of decoded characters.
+
+        @par Complexity
+
+        Linear in the size of the encoded string.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return detail::pct_encoding::
+            raw_decoded_size(s_);
+    }
+
+    /** Return an iterator to the first decoded character.
+    */
+    inline
+    iterator
+    begin() const noexcept;
+
+    /** Return an iterator to one past the last decoded character.
+    */
+    inline
+    iterator
+    end() const noexcept;
+
+    /** Compare the decoded string with a plain string.
+
+        The comparison is lexicographical, as if by
+        `std::char_traits<char>::compare`.
+
+        @return A negative value, zero, or a positive
+        value if the decoded string is less than,
+        equal to, or greater than `s`.
+    */
+    BOOST_URL_DECL
+    int
+    compare(string_view s) const noexcept;
+
+    /** Compare the decoded strings of two views.
+    */
+    BOOST_URL_DECL
+    int
+    compare(decoded_view const& other) const noexcept;
+
+    /** Return `true` if the decoded string starts with `s`.
+    */
+    BOOST_URL_DECL
+    bool
+    starts_with(string_view s) const noexcept;
+
+    /** Return `true` if the decoded string ends with `s`.
+    */
+    BOOST_URL_DECL
+    bool
+    ends_with(string_view s) const noexcept;
+
+    /** Return a hash of the decoded string.
+
+        Two views which compare equal produce the
+        same value, regardless of how their
+        characters were encoded.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    hash() const noexcept;
+
+    /** Return the decoded string.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param a An optional allocator the returned
+        string will use. If this parameter is omitted,
+        the default allocator is used, and the return
+        type of the function becomes `std::string`.
+
+        @return A `std::basic_string` using the
+        specified allocator.
+    */
+    template<
+        class Allocator =
+            std::allocator<char>>
+    string_type<Allocator>
+    to_string(
+        Allocator const& a = {}) const
+    {
+        return detail::decode(s_, a);
+    }
+
+    friend
+    bool
+    operator==(
+        decoded_view const& v,
+        string_view s) noexcept
+    {
+        return v.compare(s) == 0;
+    }
+
+    friend
+    bool
+    operator==(
+        string_view s,
+        decoded_view const& v) noexcept
+    {
+        return v.compare(s) == 0;
+    }
+
+    friend
+    bool
+    operator==(
+        decoded_view const& v0,
+        decoded_view const& v1) noexcept
+    {
+        return v0.compare(v1) == 0;
+    }
+
+    friend
+    bool
+    operator!=(
+        decoded_view const& v,
+        string_view s) noexcept
+    {
+        return v.compare(s) != 0;
+    }
+
+    friend
+    bool
+    operator!=(
+        string_view s,
+        decoded_view const& v) noexcept
+    {
+        return v.compare(s) != 0;
+    }
+
+    friend
+    bool
+    operator!=(
+        decoded_view const& v0,
+        decoded_view const& v1) noexcept
+    {
+        return v0.compare(v1) != 0;
+    }
+
+    friend
+    bool
+    operator<(
+        decoded_view const& v0,
+        decoded_view const& v1) noexcept
+    {
+        return v0.compare(v1) < 0;
+    }
+
+    /** Write the decoded string to an output stream.
+    */
+    BOOST_URL_DECL
+    friend
+    std::ostream&
+    operator<<(
+        std::ostream& os,
+        decoded_view const& v);
+};
+
+//----------------------------------------------------------
+
+/** A bidirectional iterator over decoded characters.
+*/
+class decoded_view::iterator
+{
+    char const* b_ = nullptr;
+    char const* p_ = nullptr;
+
+    friend class decoded_view;
+
+    iterator(
+        char const* b,
+        char const* p) noexcept
+        : b_(b)
+        , p_(p)
+    {
+    }
+
+public:
+    using value_type = char;
+    using reference = char;
+    using pointer = void const*;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category =
+        std::bidirectional_iterator_tag;
+
+    iterator() = default;
+
+    /** Return the position in the encoded string.
+    */
+    char const*
+    base() const noexcept
+    {
+        return p_;
+    }
+
+    char
+    operator*() const noexcept
+    {
+        if(*p_ != '%')
+            return *p_;
+        return static_cast<char>(
+            (static_cast<unsigned char>(
+                detail::hex_digit(p_[1])) << 4) +
+            static_cast<unsigned char>(
+                detail::hex_digit(p_[2])));
+    }
+
+    iterator&
+    operator++() noexcept
+    {
+        p_ += (*p_ == '%') ? 3 : 1;
+        return *this;
+    }
+
+    iterator
+    operator++(int) noexcept
+    {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    // In a valid encoding the two characters
+    // after a '%' are hex digits, so a '%'
+    // three back always starts the previous
+    // character.
+    iterator&
+    operator--() noexcept
+    {
+        if( p_ - b_ >= 3 &&
+            p_[-3] == '%')
+            p_ -= 3;
+        else
+            --p_;
+        return *this;
+    }
+
+    iterator
+    operator--(int) noexcept
+    {
+        auto tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    bool
+    operator==(
+        iterator const& other) const noexcept
+    {
+        return p_ == other.p_;
+    }
+
+    bool
+    operator!=(
+        iterator const& other) const noexcept
+    {
+        return p_ != other.p_;
+    }
+};
+
+//----------------------------------------------------------
+
+inline
+auto
+decoded_view::
+begin() const noexcept ->
+    iterator
+{
+    return iterator(
+        s_.data(), s_.data());
+}
+
+inline
+auto
+decoded_view::
+end() const noexcept ->
+    iterator
+{
+    return iterator(
+        s_.data(), s_.data() + s_.size());
+}
+
+} // urls
+} // boost
+
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/decoded_view.ipp>
+#endif
+
+#endif
@@ -27,6 +27,41 @@
 #endif
 #include <stdint.h>
 
+// detect std::pmr
+#ifndef BOOST_URL_NO_PMR
+# if defined(__has_include)
+#  if __has_include(<memory_resource>) && ( \
+      __cplusplus >= 201703L || \
+      (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+#   define BOOST_URL_HAS_PMR
+#  endif
+# endif
+#endif
+#ifdef BOOST_URL_HAS_PMR
+# include <memory_resource>
+# include <type_traits>
+namespace boost {
+namespace urls {
+namespace detail {
+template<class T>
+using enable_if_memory_resource =
+    typename std::enable_if<
+        std::is_convertible<T*,
+            std::pmr::memory_resource*
+                >::value>::type;
+} // detail
+} // urls
+} // boost
+#endif
+
+// detect relaxed constexpr (C++14)
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201304L
+# define BOOST_URL_HAS_CONSTEXPR14
+# define BOOST_URL_CONSTEXPR14 constexpr
+#else
+# define BOOST_URL_CONSTEXPR14
+#endif
+
 // detect 32/64 bit
 #if UINTPTR_MAX == UINT64_MAX
 # define BOOST_URL_ARCH 64
@@ -101,6 +136,16 @@
 # endif
 #endif
 
+// Define BOOST_URL_INSTRUMENT to keep counters of
+// parses, reallocations, bytes moved and decodes
+// in each thread, see <boost/url/instrument.hpp>.
+// The library must be built with the same setting.
+#ifdef BOOST_URL_INSTRUMENT
+# define BOOST_URL_COUNT(expr) ((void)(expr))
+#else
+# define BOOST_URL_COUNT(expr) ((void)0)
+#endif
+
 #ifndef BOOST_URL_NO_SSE2
 # if (defined(_M_IX86) && _M_IX86_FP == 2) || \
       defined(_M_X64) || defined(__SSE2__)
@@ -0,0 +1,410 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_DETAIL_HASH_HPP
+#define BOOST_URL_DETAIL_HASH_HPP
+
+#include <boost/url/detail/char_type.hpp>
+#include <boost/url/detail/simd.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+inline
+char
+ascii_lower(char c) noexcept
+{
+    if(static_cast<unsigned char>(
+        c - 'A') < 26)
+        return static_cast<char>(c + 32);
+    return c;
+}
+
+inline
+char
+hex_upper(char c) noexcept
+{
+    if(static_cast<unsigned char>(
+        c - 'a') < 6)
+        return static_cast<char>(c - 32);
+    return c;
+}
+
+inline
+char
+decode_escape(char const* p) noexcept
+{
+    return static_cast<char>(
+        (static_cast<unsigned char>(
+            hex_digit(p[1])) << 4) +
+        static_cast<unsigned char>(
+            hex_digit(p[2])));
+}
+
+//----------------------------------------------------------
+
+// FNV-1a, sized to std::size_t
+inline
+std::size_t
+hash_step(
+    std::size_t h,
+    char c) noexcept
+{
+    return (h ^ static_cast<
+        unsigned char>(c)) * (
+            sizeof(std::size_t) == 8 ?
+                static_cast<std::size_t>(
+                    1099511628211ULL) :
+                16777619U);
+}
+
+inline
+std::size_t
+hash_basis() noexcept
+{
+    return sizeof(std::size_t) == 8 ?
+        static_cast<std::size_t>(
+            14695981039346656037ULL) :
+        2166136261U;
+}
+
+// hash of a plain string
+inline
+std::size_t
+hash_key(string_view s) noexcept
+{
+    auto h = hash_basis();
+    for(auto c : s)
+        h = hash_step(h, c);
+    return h;
+}
+
+// hash of the decoded form of a valid
+// encoded string, equal to hash_key
+// of the decoded string
+inline
+std::size_t
+hash_encoded_key(string_view s) noexcept
+{
+    auto h = hash_basis();
+    auto p = s.data();
+    auto const end = p + s.size();
+    while(p < end)
+    {
+        if(*p != '%')
+        {
+            h = hash_step(h, *p++);
+            continue;
+        }
+        BOOST_ASSERT(end - p >= 3);
+        h = hash_step(h, decode_escape(p));
+        p += 3;
+    }
+    return h;
+}
+
+//----------------------------------------------------------
+
+/*  A hash of a stream of bytes
+
+    The bytes are gathered in blocks of 32, and
+    each block is mixed into four independent
+    64-bit lanes as in xxHash64. The lanes do not
+    depend on each other, so the inner loop can
+    be unrolled or vectorized by the compiler.
+
+    Blocks fall at the same offsets in the stream
+    regardless of how the bytes were supplied, and
+    words are read little-endian, so the value
+    depends only on the bytes: it is the same in
+    every process and on every platform.
+*/
+class hash_stream
+{
+    static constexpr std::uint64_t p1 = 0x9E3779B185EBCA87ULL;
+    static constexpr std::uint64_t p2 = 0xC2B2AE3D27D4EB4FULL;
+    static constexpr std::uint64_t p3 = 0x165667B19E3779F9ULL;
+    static constexpr std::size_t N = 32;
+
+    std::uint64_t v_[4];
+    std::uint64_t len_ = 0;
+    std::size_t n_ = 0;
+    unsigned char b_[N];
+
+    static
+    std::uint64_t
+    rotl(
+        std::uint64_t x,
+        int r) noexcept
+    {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    static
+    std::uint64_t
+    load(unsigned char const* p) noexcept
+    {
+        return
+            static_cast<std::uint64_t>(p[0]) |
+            static_cast<std::uint64_t>(p[1]) << 8 |
+            static_cast<std::uint64_t>(p[2]) << 16 |
+            static_cast<std::uint64_t>(p[3]) << 24 |
+            static_cast<std::uint64_t>(p[4]) << 32 |
+            static_cast<std::uint64_t>(p[5]) << 40 |
+            static_cast<std::uint64_t>(p[6]) << 48 |
+            static_cast<std::uint64_t>(p[7]) << 56;
+    }
+
+    void
+    block(unsigned char const* p) noexcept
+    {
+        for(int i = 0; i < 4; ++i)
+        {
+            v_[i] += load(p + 8 * i) * p2;
+            v_[i] = rotl(v_[i], 31) * p1;
+        }
+    }
+
+public:
+    explicit
+    hash_stream(
+        std::uint64_t seed = 0) noexcept
+    {
+        v_[0] = seed + p1 + p2;
+        v_[1] = seed + p2;
+        v_[2] = seed;
+        v_[3] = seed - p1;
+    }
+
+    void
+    put(char c) noexcept
+    {
+        b_[n_++] = static_cast<
+            unsigned char>(c);
+        ++len_;
+        if(n_ == N)
+        {
+            block(b_);
+            n_ = 0;
+        }
+    }
+
+    void
+    append(
+        char const* p,
+        std::size_t n) noexcept
+    {
+        len_ += n;
+        if(n_ > 0)
+        {
+            auto const m = n < N - n_ ?
+                n : N - n_;
+            std::memcpy(b_ + n_, p, m);
+            n_ += m;
+            p += m;
+            n -= m;
+            if(n_ < N)
+                return;
+            block(b_);
+            n_ = 0;
+        }
+        // whole blocks straight from the input
+        auto const u = reinterpret_cast<
+            unsigned char const*>(p);
+        std::size_t i = 0;
+        for(; i + N <= n; i += N)
+            block(u + i);
+        std::memcpy(b_, u + i, n - i);
+        n_ = n - i;
+    }
+
+    void
+    append_lower(
+        char const* p,
+        std::size_t n) noexcept
+    {
+        len_ += n;
+        while(n > 0)
+        {
+            auto const m = n < N - n_ ?
+                n : N - n_;
+            for(std::size_t i = 0; i < m; ++i)
+                b_[n_ + i] = static_cast<
+                    unsigned char>(
+                        ascii_lower(p[i]));
+            n_ += m;
+            p += m;
+            n -= m;
+            if(n_ == N)
+            {
+                block(b_);
+                n_ = 0;
+            }
+        }
+    }
+
+    std::uint64_t
+    finish() noexcept
+    {
+        if(n_ > 0)
+        {
+            // the length tells
+            // the padding apart
+            std::memset(b_ + n_, 0, N - n_);
+            block(b_);
+        }
+        std::uint64_t h =
+            rotl(v_[0], 1) + rotl(v_[1], 7) +
+            rotl(v_[2], 12) + rotl(v_[3], 18);
+        h = (h ^ len_) * p3;
+        h ^= h >> 33;
+        h *= p2;
+        h ^= h >> 29;
+        h *= p3;
+        h ^= h >> 32;
+        return h;
+    }
+};
+
+//----------------------------------------------------------
+
+/*  The normal form of a part, as produced by
+    url_base::normalize: escapes of unreserved
+    characters are decoded, the hex digits of the
+    other escapes are uppercase, and when `fold`
+    is set other letters are lowercase.
+*/
+
+// Write the normal form of [p, end) to a sink
+template<class Sink>
+void
+write_normal(
+    Sink& s,
+    char const* p,
+    char const* const end,
+    bool fold) noexcept
+{
+    while(p < end)
+    {
+        auto q = static_cast<char const*>(
+            std::memchr(p, '%', end - p));
+        if(! q)
+            q = end;
+        if(fold)
+            s.append_lower(p, q - p);
+        else
+            s.append(p, q - p);
+        if(q == end)
+            break;
+        auto const c = decode_escape(q);
+        if(is_unreserved(c))
+        {
+            s.put(fold ? ascii_lower(c) : c);
+        }
+        else
+        {
+            s.put('%');
+            s.put(hex_upper(q[1]));
+            s.put(hex_upper(q[2]));
+        }
+        p = q + 3;
+    }
+}
+
+// Writes to a buffer large enough
+struct buffer_sink
+{
+    char* p;
+
+    void
+    put(char c) noexcept
+    {
+        *p++ = c;
+    }
+
+    void
+    append(
+        char const* s,
+        std::size_t n) noexcept
+    {
+        std::memcpy(p, s, n);
+        p += n;
+    }
+
+    void
+    append_lower(
+        char const* s,
+        std::size_t n) noexcept
+    {
+        while(n--)
+            *p++ = ascii_lower(*s++);
+    }
+};
+
+// Reads the normal form of [p, end)
+class normal_reader
+{
+    char const* p_;
+    char const* end_;
+    char hex_[2];
+    unsigned char n_ = 0;
+    bool fold_;
+
+public:
+    normal_reader(
+        char const* p,
+        char const* end,
+        bool fold) noexcept
+        : p_(p)
+        , end_(end)
+        , fold_(fold)
+    {
+    }
+
+    bool
+    empty() const noexcept
+    {
+        return n_ == 0 && p_ == end_;
+    }
+
+    // Precondition: ! empty()
+    char
+    next() noexcept
+    {
+        if(n_ > 0)
+            return hex_[2 - n_--];
+        auto const c = *p_;
+        if(c != '%')
+        {
+            ++p_;
+            return fold_ ? ascii_lower(c) : c;
+        }
+        auto const d = decode_escape(p_);
+        if(is_unreserved(d))
+        {
+            p_ += 3;
+            return fold_ ? ascii_lower(d) : d;
+        }
+        hex_[0] = hex_upper(p_[1]);
+        hex_[1] = hex_upper(p_[2]);
+        n_ = 2;
+        p_ += 3;
+        return '%';
+    }
+};
+
+} // detail
+} // urls
+} // boost
+
+#endif
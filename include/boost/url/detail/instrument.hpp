@@ -0,0 +1,58 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_DETAIL_INSTRUMENT_HPP
+#define BOOST_URL_DETAIL_INSTRUMENT_HPP
+
+#include <boost/url/instrument.hpp>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+// The counters of the calling thread. Calls
+// are written inside BOOST_URL_COUNT, so they
+// are compiled out unless instrumented.
+inline
+instrument_counters&
+counters() noexcept
+{
+    static thread_local
+        instrument_counters c;
+    return c;
+}
+
+inline
+bool
+count_parse(
+    error_code const& ec) noexcept
+{
+    auto& c = counters();
+    ++c.parses;
+    if(! ec)
+        return true;
+    ++c.parse_failures;
+    std::size_t i = 0;
+    if(ec.category() == make_error_code(
+        error::syntax).category())
+    {
+        i = static_cast<std::size_t>(
+            ec.value());
+        if(i >= instrument_counters::error_count)
+            i = 0;
+    }
+    ++c.failures[i];
+    return false;
+}
+
+} // detail
+} // urls
+} // boost
+
+#endif
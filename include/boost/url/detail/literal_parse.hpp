@@ -0,0 +1,509 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_DETAIL_LITERAL_PARSE_HPP
+#define BOOST_URL_DETAIL_LITERAL_PARSE_HPP
+
+#include <boost/url/error.hpp>
+#include <boost/url/scheme.hpp>
+#include <boost/url/detail/char_type.hpp>
+#include <boost/url/detail/parse.hpp>
+#include <boost/url/detail/parts.hpp>
+#include <boost/url/detail/table_parse.hpp>
+#include <cstddef>
+#include <cstdint>
+
+#ifdef BOOST_URL_HAS_CONSTEXPR14
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+/*  Constant expression URL parser
+
+    This is the table driven parser with every
+    step written so that it may be evaluated
+    during compilation: bytes are examined one
+    at a time, errors are returned as values,
+    and IP literals are read by the IPv6 matcher
+    of the recursive parser, which is itself a
+    constant expression. It accepts the same
+    strings and produces the same parts; the
+    tests check this.
+*/
+class literal_parser
+{
+    char const* const begin_;
+    char const* const end_;
+    char const* p_;
+    parts pt_;
+    error ec_ = error();
+
+    static
+    constexpr
+    bool
+    in(unsigned char cc,
+        std::uint16_t mask) noexcept
+    {
+        return ((mask >> cc) & 1) != 0;
+    }
+
+    constexpr
+    bool
+    failed() const noexcept
+    {
+        return ec_ != error();
+    }
+
+    constexpr
+    void
+    mark(int id) noexcept
+    {
+        pt_.offset[id + 1] =
+            static_cast<parts::size_type>(
+                p_ - begin_);
+    }
+
+    constexpr
+    void
+    escape() noexcept
+    {
+        if(end_ - p_ < 3)
+            ec_ = error::incomplete_pct_encoding;
+        else if(
+            hex_digit(p_[1]) == -1 ||
+            hex_digit(p_[2]) == -1)
+            ec_ = error::bad_pct_encoding_digit;
+        p_ += 3;
+    }
+
+    constexpr
+    void
+    scan(std::uint16_t mask) noexcept
+    {
+        if(! in(cc_unres, mask))
+            return;
+        while(p_ < end_)
+        {
+            auto const cc =
+                char_class_of(*p_);
+            if(! in(cc, mask))
+                break;
+            if(cc == cc_pct)
+            {
+                escape();
+                if(failed())
+                    return;
+                continue;
+            }
+            ++p_;
+        }
+    }
+
+    static
+    constexpr
+    bool
+    iequal(
+        char const* s,
+        std::size_t n,
+        char const* lower) noexcept
+    {
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            auto c = s[i];
+            if(c >= 'A' && c <= 'Z')
+                c = static_cast<char>(c + 32);
+            if(lower[i] != c)
+                return false;
+        }
+        return lower[n] == 0;
+    }
+
+    // as string_to_scheme, for the special
+    // schemes; those added by register_scheme
+    // are not known at compile time
+    static
+    constexpr
+    urls::scheme
+    scheme_of(
+        char const* s,
+        std::size_t n) noexcept
+    {
+        return
+            iequal(s, n, "ftp") ? urls::scheme::ftp :
+            iequal(s, n, "file") ? urls::scheme::file :
+            iequal(s, n, "http") ? urls::scheme::http :
+            iequal(s, n, "https") ? urls::scheme::https :
+            iequal(s, n, "ws") ? urls::scheme::ws :
+            iequal(s, n, "wss") ? urls::scheme::wss :
+            urls::scheme::unknown;
+    }
+
+    //------------------------------------------------------
+
+    constexpr
+    void
+    parse_host() noexcept
+    {
+        if( p_ < end_ &&
+            *p_ == '[')
+        {
+            ++p_;
+            parser pr(p_, end_);
+            ec_ = pr.parse_ip_v6(pt_.ip);
+            if(failed())
+                return;
+            p_ = pr.p_;
+            if( p_ == end_ ||
+                *p_ != ']')
+            {
+                ec_ = error::syntax;
+                return;
+            }
+            ++p_;
+            pt_.host = host_type::ipv6;
+        }
+        else
+        {
+            auto const p0 = p_;
+            ipv4_state v4;
+            while(p_ < end_)
+            {
+                auto const cc =
+                    char_class_of(*p_);
+                if(! in(cc, cm_reg_name))
+                    break;
+                if(cc == cc_digit)
+                    v4.digit(*p_ - '0');
+                else if(*p_ == '.')
+                    v4.dot();
+                else
+                    v4.ok = false;
+                if(cc == cc_pct)
+                {
+                    escape();
+                    if(failed())
+                        return;
+                    continue;
+                }
+                ++p_;
+            }
+            if(v4.done(pt_.ip))
+                pt_.host = host_type::ipv4;
+            else if(p_ != p0)
+                pt_.host = host_type::name;
+        }
+        mark(id_host);
+
+        if( p_ < end_ &&
+            *p_ == ':')
+        {
+            ++p_;
+            port_state pn;
+            while( p_ < end_ &&
+                char_class_of(*p_) == cc_digit)
+                pn.digit(*p_++ - '0');
+            pt_.port_number = pn.value();
+        }
+        mark(id_port);
+    }
+
+    constexpr
+    void
+    parse_authority() noexcept
+    {
+        auto const p0 = p_;
+        char const* colon = nullptr;
+        bool port = true;
+        port_state pn;
+        ipv4_state v4;
+        while(p_ < end_)
+        {
+            auto const cc =
+                char_class_of(*p_);
+            if(! in(cc, cm_userinfo))
+                break;
+            if(cc == cc_colon)
+            {
+                if(colon)
+                    port = false;
+                else
+                    colon = p_;
+            }
+            else if(colon)
+            {
+                if(cc != cc_digit)
+                    port = false;
+                else
+                    pn.digit(*p_ - '0');
+            }
+            else if(cc == cc_digit)
+            {
+                v4.digit(*p_ - '0');
+            }
+            else if(*p_ == '.')
+            {
+                v4.dot();
+            }
+            else
+            {
+                v4.ok = false;
+            }
+            if(cc == cc_pct)
+            {
+                escape();
+                if(failed())
+                    return;
+                continue;
+            }
+            ++p_;
+        }
+
+        if( p_ < end_ &&
+            *p_ == '@')
+        {
+            auto const p1 = p_;
+            p_ = colon ? colon : p1;
+            mark(id_user);
+            p_ = p1 + 1;
+            mark(id_password);
+            parse_host();
+            return;
+        }
+
+        auto const p1 = p_;
+        p_ = p0;
+        mark(id_user);
+        mark(id_password);
+        if(p1 == p0)
+        {
+            parse_host();
+            return;
+        }
+
+        if(! colon)
+            colon = p1;
+        else if(! port)
+        {
+            ec_ = error::syntax;
+            return;
+        }
+        if(v4.done(pt_.ip))
+            pt_.host = host_type::ipv4;
+        else if(colon != p0)
+            pt_.host = host_type::name;
+        p_ = colon;
+        mark(id_host);
+        p_ = p1;
+        mark(id_port);
+        pt_.port_number = pn.value();
+    }
+
+    constexpr
+    void
+    parse_path(
+        char const* p0,
+        std::uint16_t first) noexcept
+    {
+        std::size_t n = 0;
+        if( p0 == end_ ||
+            *p0 != '/')
+        {
+            scan(first);
+            if(failed())
+                return;
+            if(p_ == p0)
+            {
+                mark(id_path);
+                return;
+            }
+            if( p_ < end_ &&
+                *p_ != '/')
+            {
+                mark(id_path);
+                pt_.nseg = 1;
+                return;
+            }
+            n = 1;
+        }
+        while(p_ < end_)
+        {
+            auto const cc =
+                char_class_of(*p_);
+            if(! in(cc, cm_segments))
+                break;
+            if(cc == cc_slash)
+            {
+                ++n;
+                ++p_;
+                continue;
+            }
+            if(cc == cc_pct)
+            {
+                escape();
+                if(failed())
+                    return;
+                continue;
+            }
+            ++p_;
+        }
+        mark(id_path);
+        pt_.nseg = static_cast<
+            parts::size_type>(n);
+    }
+
+    constexpr
+    void
+    parse_hier_part(
+        std::uint16_t first) noexcept
+    {
+        if( end_ - p_ >= 2 &&
+            p_[0] == '/' &&
+            p_[1] == '/')
+        {
+            p_ += 2;
+            parse_authority();
+            if(failed())
+                return;
+            first = 0;
+        }
+        parse_path(p_, first);
+    }
+
+    constexpr
+    void
+    parse_query() noexcept
+    {
+        std::size_t n = 1;
+        std::uint16_t mask = cm_qkey;
+        ++p_;
+        while(p_ < end_)
+        {
+            auto const cc =
+                char_class_of(*p_);
+            if(! in(cc, mask))
+            {
+                if( mask == cm_qkey &&
+                    cc == cc_eq)
+                {
+                    mask = cm_qval;
+                    ++p_;
+                    continue;
+                }
+                if( mask == cm_qval &&
+                    cc == cc_amp)
+                {
+                    mask = cm_qkey;
+                    ++n;
+                    ++p_;
+                    continue;
+                }
+                break;
+            }
+            if(cc == cc_pct)
+            {
+                escape();
+                if(failed())
+                    return;
+                continue;
+            }
+            ++p_;
+        }
+        mark(id_query);
+        pt_.nparam = static_cast<
+            parts::size_type>(n);
+    }
+
+public:
+    constexpr
+    literal_parser(
+        char const* s,
+        std::size_t n) noexcept
+        : begin_(s)
+        , end_(s + n)
+        , p_(s)
+    {
+    }
+
+    // Returns error() on success
+    constexpr
+    error
+    parse(parts& pt) noexcept
+    {
+        if(end_ - begin_ > static_cast<
+            std::ptrdiff_t>(BOOST_URL_MAX_STRING_SIZE))
+            return error::invalid;
+
+        if( p_ < end_ &&
+            char_class_of(*p_) == cc_alpha)
+        {
+            ++p_;
+            while( p_ < end_ && in(
+                char_class_of(*p_), cm_scheme))
+                ++p_;
+            if( p_ < end_ &&
+                *p_ == ':')
+            {
+                ++p_;
+                mark(id_scheme);
+                pt_.scheme_id = scheme_of(
+                    begin_, p_ - 1 - begin_);
+                parse_hier_part(cm_pchar);
+            }
+            else
+            {
+                parse_path(begin_, cm_pchar_nc);
+            }
+        }
+        else
+        {
+            parse_hier_part(cm_pchar_nc);
+        }
+        if(failed())
+            return ec_;
+
+        if( p_ < end_ &&
+            *p_ == '?')
+        {
+            parse_query();
+            if(failed())
+                return ec_;
+        }
+
+        if( p_ < end_ &&
+            *p_ == '#')
+        {
+            ++p_;
+            scan(cm_frag);
+            if(failed())
+                return ec_;
+            mark(id_frag);
+        }
+
+        if(p_ != end_)
+            return error::syntax;
+
+        for(int i = id_user;
+            i <= id_end; ++i)
+            if(pt_.offset[i] <
+                    pt_.offset[i - 1])
+                pt_.offset[i] =
+                    pt_.offset[i - 1];
+        pt = pt_;
+        return error();
+    }
+};
+
+} // detail
+} // urls
+} // boost
+
+#endif
+
+#endif
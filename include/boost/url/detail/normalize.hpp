@@ -0,0 +1,112 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_DETAIL_NORMALIZE_HPP
+#define BOOST_URL_DETAIL_NORMALIZE_HPP
+
+#include <boost/url/scheme.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+// rfc3986 5.2.4
+//
+// Writes the path [first, last) with its dot
+// segments removed to dest, and returns the
+// number of characters written. The output is
+// never longer than the input, and dest may be
+// equal to first so the path can be rewritten
+// in place.
+inline
+std::size_t
+remove_dot_segments(
+    char* const dest,
+    char const* first,
+    char const* const last) noexcept
+{
+    auto p = first;
+    auto d = dest;
+    auto const is = [&p, last](
+        char const* s, std::size_t n)
+    {
+        if(static_cast<std::size_t>(
+                last - p) < n)
+            return false;
+        for(std::size_t i = 0; i < n; ++i)
+            if(p[i] != s[i])
+                return false;
+        return true;
+    };
+    // remove the last segment
+    // and its preceding '/'
+    auto const pop = [dest, &d]
+    {
+        while(d > dest)
+            if(*--d == '/')
+                break;
+    };
+    while(p < last)
+    {
+        // A
+        if(is("../", 3))
+        {
+            p += 3;
+            continue;
+        }
+        if(is("./", 2))
+        {
+            p += 2;
+            continue;
+        }
+        // B
+        if(is("/./", 3))
+        {
+            p += 2;
+            continue;
+        }
+        if(last - p == 2 && is("/.", 2))
+        {
+            *d++ = '/';
+            break;
+        }
+        // C
+        if(is("/../", 4))
+        {
+            p += 3;
+            pop();
+            continue;
+        }
+        if(last - p == 3 && is("/..", 3))
+        {
+            pop();
+            *d++ = '/';
+            break;
+        }
+        // D
+        if( (last - p == 1 && *p == '.') ||
+            (last - p == 2 && is("..", 2)))
+            break;
+        // E
+        if(*p == '/')
+            *d++ = *p++;
+        while(p < last && *p != '/')
+            *d++ = *p++;
+    }
+    return static_cast<
+        std::size_t>(d - dest);
+}
+
+} // detail
+} // urls
+} // boost
+
+#endif
@@ -13,6 +13,7 @@
 #include <boost/url/detail/char_type.hpp>
 #include <boost/url/detail/parts.hpp>
 #include <boost/url/error.hpp>
+#include <boost/url/scheme.hpp>
 
 namespace boost {
 namespace urls {
@@ -42,6 +43,7 @@ struct parser
     {
     }
 
+    constexpr
     parser(
         char const* begin,
         char const* end) noexcept
@@ -242,7 +244,7 @@ struct parser
             *p_ != ':')
             return;
         ++p_;
-        match_port();
+        pt.port_number = match_port();
         mark(pt, id_port);
     }
 
@@ -280,7 +282,7 @@ struct parser
             return;
         }
         ++p_;
-        parse_ip_v6(ec);
+        parse_ip_v6(pt.ip, ec);
         if(ec)
             return;
         if(p_ == end_)
@@ -303,7 +305,7 @@ struct parser
         error_code& ec)
     {
         auto const p0 = p_;
-        if(match_ip_v4())
+        if(match_ip_v4(pt.ip))
         {
             pt.host = host_type::ipv4;
             auto const p1 = p_;
@@ -325,8 +327,13 @@ struct parser
             pt.host = host_type::name;
     }
 
+    // The IP matchers are constant expressions,
+    // which the literal parser calls as well;
+    // errors are returned as values.
+
+    BOOST_URL_CONSTEXPR14
     short
-    match_octet()
+    match_octet() noexcept
     {
         short v = 0;
         if(p_ >= end_)
@@ -357,8 +364,12 @@ struct parser
         return v;
     }
 
+    // stores the address in
+    // addr[0..3] on success
+    BOOST_URL_CONSTEXPR14
     bool
-    match_ip_v4()
+    match_ip_v4(
+        unsigned char* addr) noexcept
     {
         auto a = match_octet();
         if( a == -1 ||
@@ -381,82 +392,71 @@ struct parser
         auto d = match_octet();
         if(d == -1)
             return false;
+        addr[0] = static_cast<unsigned char>(a);
+        addr[1] = static_cast<unsigned char>(b);
+        addr[2] = static_cast<unsigned char>(c);
+        addr[3] = static_cast<unsigned char>(d);
         return true;
     }
 
+    // p_ != end_
+    BOOST_URL_CONSTEXPR14
     long
-    parse_word(
-        error_code& ec) noexcept
+    parse_word(error& e) noexcept
     {
-        BOOST_ASSERT(p_ != end_);
         auto digit =
             hex_digit(*p_);
         if(digit == -1)
         {
-            ec = error::syntax;
+            e = error::syntax;
             return -1;
         }
         long v = digit;
         ++p_;
-
-        if(p_ == end_)
-            return v;
-        digit =
-            hex_digit(*p_);
-        if(digit == -1)
-            return v;
-        v = 16 * v + digit;
-        ++p_;
-
-        if(p_ == end_)
-            return v;
-        digit =
-            hex_digit(*p_);
-        if(digit == -1)
-            return v;
-        v = 16 * v + digit;
-        ++p_;
-
-        if(p_ == end_)
-            return v;
-        digit =
-            hex_digit(*p_);
-        if(digit == -1)
-            return v;
-        v = 16 * v + digit;
-        ++p_;
-
+        for(int i = 0; i < 3; ++i)
+        {
+            if(p_ == end_)
+                return v;
+            digit =
+                hex_digit(*p_);
+            if(digit == -1)
+                return v;
+            v = 16 * v + digit;
+            ++p_;
+        }
         return v;
     }
 
     // return `true` if the hex
     // word could be 0..255 if
     // interpreted as decimal
+    static
+    constexpr
     bool
-    maybe_octet(long word)
+    maybe_octet(long word) noexcept
     {
-        if(word > 0x255)
-            return false;
-        if(((word >>  4) & 0xf) > 9)
-            return false;
-        if((word & 0xf) > 9)
-            return false;
-        return true;
+        return
+            word <= 0x255 &&
+            ((word >>  4) & 0xf) <= 9 &&
+            (word & 0xf) <= 9;
     }
 
-    void
+    // stores the address in addr[0..15]
+    BOOST_URL_CONSTEXPR14
+    error
     parse_ip_v6(
-        error_code& ec) noexcept
+        unsigned char* addr) noexcept
     {
         if(p_ == end_)
-        {
-            ec = error::syntax;
-            return;
-        }
+            return error::syntax;
         int n = 8; // words needed
         bool b = false; // got '::'
         bool c = false; // need colon
         long word = 0;
+        std::uint16_t w[8] = {}; // the words
+        int nw = 0; // number of words
+        int gap = 8; // position of "::"
+        error e = error();
         for(;;)
         {
             if(p_ == end_)
@@ -464,27 +464,22 @@ struct parser
                 if(b)
                     break;
                 // not enough words
-                BOOST_ASSERT(n > 0);
-                ec = error::syntax;
-                return;
+                return error::syntax;
             }
             if(*p_ == ':')
             {
                 ++p_;
                 if(p_ == end_)
-                {
-                    ec = error::syntax;
-                    return;
-                }
+                    return error::syntax;
                 if(*p_ == ':')
                 {
                     if(b)
                     {
                         // two '::'
-                        ec = error::syntax;
-                        return;
+                        return error::syntax;
                     }
                     ++p_;
+                    gap = nw;
                     --n;
                     if(n == 0)
                         break;
@@ -493,9 +488,12 @@ struct parser
                 }
                 else if(c)
                 {
-                    word = parse_word(ec);
-                    if(ec)
-                        return;
+                    word = parse_word(e);
+                    if(e != error())
+                        return e;
+                    if(nw < 8)
+                        w[nw++] = static_cast<
+                            std::uint16_t>(word);
                     --n;
                     if(n == 0)
                         break;
@@ -503,8 +501,7 @@ struct parser
                 else
                 {
                     // can't start with ':'
-                    ec = error::syntax;
-                    return;
+                    return error::syntax;
                 }
             }
             else if(*p_ == '.')
@@ -512,57 +509,44 @@ struct parser
                 if(! b && n > 1)
                 {
                     // not enough words
-                    ec = error::syntax;
-                    return;
+                    return error::syntax;
                 }
                 if(! maybe_octet(word))
                 {
                     // invalid octet
-                    ec = error::syntax;
-                    return;
+                    return error::syntax;
                 }
                 ++p_;
-                auto m = match_octet();
-                if( m == -1)
-                {
-                    ec = error::syntax;
-                    return;
-                }
-                if(p_ >= end_)
-                {
-                    ec = error::syntax;
-                    return;
-                }
-                if(*p_ != '.')
-                {
-                    ec = error::syntax;
-                    return;
-                }
+                auto const m1 = match_octet();
+                if( m1 == -1 ||
+                    p_ >= end_ ||
+                    *p_ != '.')
+                    return error::syntax;
                 ++p_;
-                m = match_octet();
-                if( m == -1)
-                {
-                    ec = error::syntax;
-                    return;
-                }
-                if(p_ >= end_)
-                {
-                    ec = error::syntax;
-                    return;
-                }
-                if(*p_ != '.')
-                {
-                    ec = error::syntax;
-                    return;
-                }
+                auto const m2 = match_octet();
+                if( m2 == -1 ||
+                    p_ >= end_ ||
+                    *p_ != '.')
+                    return error::syntax;
                 ++p_;
-                m = match_octet();
-                if(m == -1)
-                {
-                    ec = error::syntax;
-                    return;
-                }
-                return;
+                auto const m3 = match_octet();
+                if(m3 == -1)
+                    return error::syntax;
+                // the last word was the hex digits
+                // of the first octet, in decimal
+                auto const m0 =
+                    100 * ((word >> 8) & 0xf) +
+                     10 * ((word >> 4) & 0xf) +
+                           (word & 0xf);
+                if(nw > 0)
+                    --nw;
+                if(nw < 8)
+                    w[nw++] = static_cast<
+                        std::uint16_t>((m0 << 8) | m1);
+                if(nw < 8)
+                    w[nw++] = static_cast<
+                        std::uint16_t>((m2 << 8) | m3);
+                break;
             }
             else if(b && hex_digit(*p_) == -1)
             {
@@ -571,9 +555,12 @@ struct parser
             }
             else if(! c)
             {
-                word = parse_word(ec);
-                if(ec)
-                    return;
+                word = parse_word(e);
+                if(e != error())
+                    return e;
+                if(nw < 8)
+                    w[nw++] = static_cast<
+                        std::uint16_t>(word);
                 --n;
                 if(n == 0)
                     break;
@@ -582,24 +569,70 @@ struct parser
             else
             {
                 // ':' divides words
-                ec = error::syntax;
-                return;
+                return error::syntax;
             }
         }
+
+        // zeroes replace "::"
+        if(gap > nw)
+            gap = nw;
+        for(int i = 0; i < 16; ++i)
+            addr[i] = 0;
+        for(int i = 0; i < nw; ++i)
+        {
+            auto const j = i < gap ?
+                i : 8 - nw + i;
+            addr[2 * j] = static_cast<
+                unsigned char>(w[i] >> 8);
+            addr[2 * j + 1] = static_cast<
+                unsigned char>(w[i] & 0xff);
+        }
+        return error();
     }
 
-    // port = *DIGIT
     void
+    parse_ip_v6(
+        unsigned char* addr,
+        error_code& ec) noexcept
+    {
+        auto const e =
+            parse_ip_v6(addr);
+        if(e != error())
+            ec = e;
+    }
+
+    // port = *DIGIT
+    //
+    // Returns the value of the port,
+    // or 0 if it is empty or too large
+    std::uint16_t
     match_port() noexcept
     {
+        std::uint32_t v = 0;
         while(p_ < end_)
         {
             auto const digit = static_cast<
                 unsigned char>(*p_ - '0');
             if(digit > 9)
                 break;
+            // saturate past 65535
+            if(v <= 0xffff)
+                v = 10 * v + digit;
             ++p_;
         }
+        if(v > 0xffff)
+            return 0;
+        return static_cast<
+            std::uint16_t>(v);
+    }
+
+    // scheme ":"
+    void
+    mark_scheme(parts& pt) noexcept
+    {
+        mark(pt, id_scheme);
+        pt.scheme_id = string_to_scheme(
+            make_string(begin_, p_ - 1));
     }
 
     //------------------------------------------------------
@@ -657,7 +690,7 @@ struct parser
                 pchar_pct_set();
             // segment-nz
             p_ = e.parse(
-                p_ + 1, end_, ec);
+                p_, end_, ec);
             if(ec)
                 return;
             while(p_ < end_)
@@ -837,13 +870,21 @@ parse_url(
     string_view s,
     error_code& ec) noexcept
 {
+    // offsets are stored in 32 bits
+    if(s.size() > BOOST_URL_MAX_STRING_SIZE)
+    {
+        ec = error::invalid;
+        return;
+    }
     parser pr(s);
     if( pr.match_scheme() &&
         pr.match_literal(":"))
     {
         // absolute-URI
-        pr.mark(pt, id_scheme);
+        pr.mark_scheme(pt);
         pr.parse_hier_part(pt, ec);
+        if(ec)
+            return;
     }
     else
     {
@@ -869,6 +910,135 @@ parse_url(
         ec = error::syntax;
 }
 
+// absolute-form of an http or https URL
+// with a reg-name or IPv4address host.
+// Returns false for anything else, which
+// may leave pt partially filled in.
+inline
+bool
+parse_http_absolute_form(
+    parser& pr,
+    parts& pt,
+    error_code& ec) noexcept
+{
+    auto const s = pr.make_string(
+        pr.p_, pr.end_);
+    std::size_t n = 0;
+    if(s.size() > 4 && s[4] == ':')
+        n = 4;
+    else if(s.size() > 5 && s[5] == ':')
+        n = 5;
+    auto const k =
+        string_to_scheme(s.substr(0, n));
+    if( k != scheme::http &&
+        k != scheme::https)
+        return false;
+    if(s.substr(n + 1, 2) != "//")
+        return false;
+
+    // reg-name / IPv4address
+    auto const h = pr.p_ + n + 3;
+    auto const p = reg_name_pct_set().parse(
+        h, pr.end_, ec);
+    if(ec)
+        return true;
+    if( p == h || (
+        p < pr.end_ && (
+            *p == '@' ||
+            *p == '[')))
+        return false;
+
+    pr.p_ += n + 1;
+    pr.mark(pt, id_scheme);
+    pt.scheme_id = k;
+    pr.p_ = h;
+    pr.mark(pt, id_user);
+    pr.mark(pt, id_password);
+    parser v4(h, p);
+    if( v4.match_ip_v4(pt.ip) &&
+        v4.done())
+        pt.host = host_type::ipv4;
+    else
+        pt.host = host_type::name;
+    pr.p_ = p;
+    pr.mark(pt, id_host);
+    if( pr.p_ < pr.end_ &&
+        *pr.p_ == ':')
+    {
+        ++pr.p_;
+        pt.port_number = pr.match_port();
+        pr.mark(pt, id_port);
+    }
+    if( pr.p_ < pr.end_ &&
+        *pr.p_ != '/' &&
+        *pr.p_ != '?')
+    {
+        // maybe userinfo
+        return false;
+    }
+    pr.parse_path_abempty(pt, ec);
+    return true;
+}
+
+// request-target (rfc7230 section 5.3)
+//
+// origin-form and absolute-form. The common
+// case of an http or https URL is parsed
+// directly, anything else by parse_url.
+inline
+void
+parse_request_target(
+    parts& pt,
+    string_view s,
+    error_code& ec) noexcept
+{
+    // offsets are stored in 32 bits
+    if(s.size() > BOOST_URL_MAX_STRING_SIZE)
+    {
+        ec = error::invalid;
+        return;
+    }
+    parser pr(s);
+    if( ! s.empty() &&
+        s[0] == '/')
+    {
+        // origin-form = absolute-path [ "?" query ]
+        auto const e =
+            pchar_pct_set();
+        while( pr.p_ < pr.end_ &&
+            *pr.p_ == '/')
+        {
+            pr.p_ = e.parse(
+                pr.p_ + 1, pr.end_, ec);
+            if(ec)
+                return;
+            ++pt.nseg;
+        }
+        pr.mark(pt, id_path);
+    }
+    else if(! parse_http_absolute_form(
+        pr, pt, ec))
+    {
+        // absolute-URI
+        pt = parts();
+        parse_url(pt, s, ec);
+        if(ec)
+            return;
+        if( pt.length(id_scheme) == 0 ||
+            pt.length(id_frag) != 0)
+            ec = error::syntax;
+        return;
+    }
+    if(ec)
+        return;
+    pr.parse_query(pt, ec);
+    if(ec)
+        return;
+    // no fragment
+    if(! pr.done())
+        ec = error::syntax;
+}
+
 // origin
 // VFALCO This should throw not return error code
 inline
@@ -891,7 +1061,7 @@ parse_origin(
         ec = error::syntax;
         return;
     }
-    pr.mark(pt, id_scheme);
+    pr.mark_scheme(pt);
     pr.parse_hier_part(pt, ec);
 
     // authority
@@ -911,28 +1081,60 @@ inline
 void
 parse_scheme(
     parts& pt,
-    string_view s)
+    string_view s,
+    error_code& ec) noexcept
 {
     parser pr(s);
     if(! pr.match_scheme())
-        invalid_part::raise();
+    {
+        ec = error::bad_scheme_start_char;
+        return;
+    }
     if(! pr.done())
-        invalid_part::raise();
+    {
+        ec = error::bad_scheme_char;
+        return;
+    }
     pr.mark(pt, id_scheme);
+    pt.scheme_id = string_to_scheme(s);
 }
 
 inline
 void
-parse_authority(
+parse_scheme(
     parts& pt,
     string_view s)
 {
-    parser pr(s);
     error_code ec;
-    pr.parse_authority(pt, ec);
+    parse_scheme(pt, s, ec);
     if(ec)
         invalid_part::raise();
+}
+
+inline
+void
+parse_authority(
+    parts& pt,
+    string_view s,
+    error_code& ec) noexcept
+{
+    parser pr(s);
+    pr.parse_authority(pt, ec);
+    if(ec)
+        return;
     if(! pr.done())
+        ec = error::syntax;
+}
+
+inline
+void
+parse_authority(
+    parts& pt,
+    string_view s)
+{
+    error_code ec;
+    parse_authority(pt, s, ec);
+    if(ec)
         invalid_part::raise();
 }
 
@@ -940,14 +1142,26 @@ inline
 void
 parse_userinfo(
     parts& pt,
-    string_view s)
+    string_view s,
+    error_code& ec) noexcept
 {
     parser pr(s);
-    error_code ec;
     pr.parse_userinfo(pt, ec);
     if(ec)
-        invalid_part::raise();
+        return;
     if(! pr.done())
+        ec = error::bad_userinfo_char;
+}
+
+inline
+void
+parse_userinfo(
+    parts& pt,
+    string_view s)
+{
+    error_code ec;
+    parse_userinfo(pt, s, ec);
+    if(ec)
         invalid_part::raise();
 }
 
@@ -955,14 +1169,26 @@ inline
 void
 parse_hostname(
     parts& pt,
-    string_view s)
+    string_view s,
+    error_code& ec) noexcept
 {
     parser pr(s);
-    error_code ec;
     pr.parse_hostname(pt, ec);
     if(ec)
-        invalid_part::raise();
+        return;
     if(! pr.done())
+        ec = error::syntax;
+}
+
+inline
+void
+parse_hostname(
+    parts& pt,
+    string_view s)
+{
+    error_code ec;
+    parse_hostname(pt, s, ec);
+    if(ec)
         invalid_part::raise();
 }
 
@@ -983,7 +1209,7 @@ parse_plain_hostname(
             return;
         }
         ec = {};
-        if(pr.match_ip_v4())
+        if(pr.match_ip_v4(pt.ip))
         {
             if(pr.done())
             {
@@ -1001,73 +1227,147 @@ parse_plain_hostname(
     pt.host = host_type::name;
 }
 
+// Returns the value of the port,
+// or 0 if it is empty or too large
 inline
-void
-match_port(string_view s)
+std::uint16_t
+match_port(
+    string_view s,
+    error_code& ec) noexcept
 {
     parser pr(s);
-    error_code ec;
-    pr.match_port();
+    auto const n = pr.match_port();
     if(! pr.done())
+        ec = error::bad_port_char;
+    return n;
+}
+
+inline
+std::uint16_t
+match_port(string_view s)
+{
+    error_code ec;
+    auto const n = match_port(s, ec);
+    if(ec)
         invalid_part::raise();
+    return n;
 }
 
 inline
 void
-match_path_abempty(string_view s)
+match_path_abempty(
+    string_view s,
+    error_code& ec) noexcept
 {
     parts pt;
     parser pr(s);
-    error_code ec;
     pr.parse_path_abempty(pt, ec);
     if(ec)
-        invalid_part::raise();
+        return;
     if(! pr.done())
+        ec = error::syntax;
+}
+
+inline
+void
+match_path_abempty(string_view s)
+{
+    error_code ec;
+    match_path_abempty(s, ec);
+    if(ec)
         invalid_part::raise();
 }
 
 inline
 void
-match_path_absolute(string_view s)
+match_path_absolute(
+    string_view s,
+    error_code& ec) noexcept
 {
     parts pt;
     parser pr(s);
-    error_code ec;
     pr.parse_path_absolute(pt, ec);
     if(ec)
-        invalid_part::raise();
+        return;
     if(! pr.done())
+        ec = error::syntax;
+}
+
+inline
+void
+match_path_absolute(string_view s)
+{
+    error_code ec;
+    match_path_absolute(s, ec);
+    if(ec)
         invalid_part::raise();
 }
 
 inline
 void
-match_path_noscheme(string_view s)
+match_path_noscheme(
+    string_view s,
+    error_code& ec) noexcept
 {
     parts pt;
     parser pr(s);
-    error_code ec;
     pr.parse_path_noscheme(pt, ec);
     if(ec)
-        invalid_part::raise();
+        return;
     if(! pr.done())
+        ec = error::syntax;
+}
+
+inline
+void
+match_path_noscheme(string_view s)
+{
+    error_code ec;
+    match_path_noscheme(s, ec);
+    if(ec)
         invalid_part::raise();
 }
 
 inline
 void
-match_path_rootless(string_view s)
+match_path_rootless(
+    string_view s,
+    error_code& ec) noexcept
 {
     parts pt;
     parser pr(s);
-    error_code ec;
     pr.parse_path_rootless(pt, ec);
     if(ec)
-        invalid_part::raise();
+        return;
     if(! pr.done())
+        ec = error::syntax;
+}
+
+inline
+void
+match_path_rootless(string_view s)
+{
+    error_code ec;
+    match_path_rootless(s, ec);
+    if(ec)
         invalid_part::raise();
 }
 
+// Return the number of params in a
+// valid encoded query, including the '?'
+inline
+std::size_t
+count_params(
+    string_view s) noexcept
+{
+    parts pt;
+    parser pr(s);
+    error_code ec;
+    pr.parse_query(pt, ec);
+    BOOST_ASSERT(! ec);
+    return pt.nparam;
+}
+
 } // detail
 } // urls
 } // boost
@@ -11,8 +11,11 @@
 #define BOOST_URL_DETAIL_PARTS_HPP
 
 #include <boost/url/host_type.hpp>
+#include <boost/url/scheme.hpp>
 #include <boost/url/detail/char_type.hpp>
 #include <boost/url/error.hpp>
+#include <algorithm>
+#include <cstdint>
 
 namespace boost {
 namespace urls {
@@ -33,19 +36,41 @@ enum
 
 //----------------------------------------------------------
 
+// No URL may exceed BOOST_URL_MAX_STRING_SIZE,
+// so 32-bit offsets and counts are sufficient.
+// This keeps each view at half the size it
+// would have using std::size_t.
 struct parts
 {
-    std::size_t offset[
-        detail::id_end + 1];
-    std::size_t nseg = 0;
-    std::size_t nparam = 0;
+    using size_type = std::uint32_t;
+
+    BOOST_STATIC_ASSERT(
+        BOOST_URL_MAX_STRING_SIZE <=
+            static_cast<size_type>(-1));
+
+    size_type offset[
+        detail::id_end + 1] = {};
+    size_type nseg = 0;
+    size_type nparam = 0;
     host_type host = host_type::none;
+    urls::scheme scheme_id = urls::scheme::unknown;
+    std::uint16_t port_number = 0;
+
+    // The address in network byte order, valid
+    // when host is ipv4 (4 bytes) or ipv6
+    unsigned char ip[16] = {};
 
-    parts()
+    // usable in constant expressions
+    constexpr parts() = default;
+
+    // copy the host type and address
+    void
+    set_host(
+        parts const& pt) noexcept
     {
-        std::fill(
-            offset,
-            offset + id_end + 1, 0);
+        host = pt.host;
+        std::copy(
+            pt.ip, pt.ip + 16, ip);
     }
 
     std::size_t
@@ -94,7 +119,8 @@ struct parts
         std::size_t n) noexcept
     {
         auto const n0 = length(id);
-        auto const d = n - n0;
+        auto const d = static_cast<
+            size_type>(n - n0);
         for(auto i = id + 1;
             i <= id_end; ++i)
             offset[i] += d;
@@ -108,7 +134,7 @@ struct parts
         BOOST_ASSERT(id < detail::id_end - 1);
         BOOST_ASSERT(n <= length(id));
         offset[id + 1] = offset[id] +
-            static_cast<std::size_t>(n);
+            static_cast<size_type>(n);
     }
 };
 
@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_DETAIL_SEGMENT_OFFSETS_HPP
+#define BOOST_URL_DETAIL_SEGMENT_OFFSETS_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <boost/assert.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+// The start of each path segment relative
+// to the beginning of the path, followed by
+// the size of the path. This is the state of
+// a segments_index, kept here so the segment
+// modifiers of url_base can update it.
+struct segment_offsets
+{
+    std::vector<std::uint32_t> v;
+
+    // Return the number of segments
+    std::size_t
+    size() const noexcept
+    {
+        return v.size() - 1;
+    }
+
+    // Return the index of the segment
+    // which starts at the path offset rel
+    std::size_t
+    find(std::size_t rel) const noexcept
+    {
+        auto const it = std::lower_bound(
+            v.begin(), v.end(), static_cast<
+                std::uint32_t>(rel));
+        BOOST_ASSERT(it != v.end() &&
+            *it == rel);
+        return it - v.begin();
+    }
+
+    // Make on_insert non-throwing
+    void
+    reserve_one()
+    {
+        v.reserve(v.size() + 1);
+    }
+
+    // n characters were inserted
+    // at the start of segment i
+    void
+    on_insert(
+        std::size_t i,
+        std::size_t n) noexcept
+    {
+        BOOST_ASSERT(i < v.size());
+        BOOST_ASSERT(
+            v.capacity() > v.size());
+        // the new segment starts where
+        // segment i used to start
+        v.insert(v.begin() + i, v[i]);
+        auto const d = static_cast<
+            std::uint32_t>(n);
+        for(auto j = i + 1;
+            j < v.size(); ++j)
+            v[j] += d;
+    }
+
+    // segments [i0, i1), d characters
+    // in total, were erased
+    void
+    on_erase(
+        std::size_t i0,
+        std::size_t i1,
+        std::size_t d) noexcept
+    {
+        BOOST_ASSERT(i0 <= i1);
+        BOOST_ASSERT(i1 < v.size());
+        BOOST_ASSERT(v[i1] - v[i0] == d);
+        v.erase(
+            v.begin() + i0,
+            v.begin() + i1);
+        auto const n = static_cast<
+            std::uint32_t>(d);
+        for(auto j = i0;
+            j < v.size(); ++j)
+            v[j] -= n;
+    }
+};
+
+} // detail
+} // urls
+} // boost
+
+#endif
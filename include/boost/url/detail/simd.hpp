@@ -0,0 +1,245 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_DETAIL_SIMD_HPP
+#define BOOST_URL_DETAIL_SIMD_HPP
+
+#include <boost/url/detail/config.hpp>
+#include <cstddef>
+
+#ifdef BOOST_URL_USE_SSE2
+# include <emmintrin.h>
+# ifdef _MSC_VER
+#  include <intrin.h>
+# endif
+#endif
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+// Returns true if c is an unreserved character,
+// which every percent-encoding set allows:
+//
+//  unreserved = ALPHA / DIGIT / "-" / "." / "_" / "~"
+//
+inline
+bool
+is_unreserved(char c) noexcept
+{
+    auto const u =
+        static_cast<unsigned char>(c);
+    if(static_cast<unsigned char>(
+            (u | 0x20) - 'a') < 26)
+        return true;
+    if(static_cast<unsigned char>(
+            u - '0') < 10)
+        return true;
+    return
+        u == '-' || u == '.' ||
+        u == '_' || u == '~';
+}
+
+// Returns true if c may appear in a path, query,
+// or fragment without being escaped, that is
+// pchar / "/" / "?" without "%"
+//
+//  "!" / "$" / "&"..";" / "=" / "?"..."Z" /
+//  "_" / "a"..."z" / "~"
+//
+inline
+bool
+is_frag_char(char c) noexcept
+{
+    auto const u =
+        static_cast<unsigned char>(c);
+    if(static_cast<unsigned char>(
+            u - 'a') < 26)
+        return true;
+    if(static_cast<unsigned char>(
+            u - '?') < 28)
+        return true;
+    if(static_cast<unsigned char>(
+            u - '&') < 22)
+        return true;
+    return
+        u == '!' || u == '$' || u == '=' ||
+        u == '_' || u == '~';
+}
+
+#ifdef BOOST_URL_USE_SSE2
+
+// Index of the lowest set bit, mask != 0
+inline
+unsigned
+ctz(unsigned mask) noexcept
+{
+#ifdef _MSC_VER
+    unsigned long i;
+    _BitScanForward(&i, mask);
+    return static_cast<unsigned>(i);
+#else
+    return static_cast<unsigned>(
+        __builtin_ctz(mask));
+#endif
+}
+
+// Returns a 16-bit mask with one
+// bit set for each unreserved byte
+inline
+unsigned
+unreserved_mask(__m128i v) noexcept
+{
+    // x in [lo, lo+n] when
+    // saturate(x - lo - n) == 0
+    auto const zero = _mm_setzero_si128();
+    auto const in_range =
+        [zero](__m128i x, char lo, char n)
+        {
+            return _mm_cmpeq_epi8(
+                _mm_subs_epu8(
+                    _mm_sub_epi8(x,
+                        _mm_set1_epi8(lo)),
+                    _mm_set1_epi8(n)),
+                zero);
+        };
+    auto m = in_range(
+        _mm_or_si128(v,
+            _mm_set1_epi8(0x20)),
+        'a', 25);                       // ALPHA
+    m = _mm_or_si128(m,
+        in_range(v, '0', 9));           // DIGIT
+    m = _mm_or_si128(m,
+        in_range(v, '-', 1));           // "-" / "."
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(
+        v, _mm_set1_epi8('_')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(
+        v, _mm_set1_epi8('~')));
+    return static_cast<unsigned>(
+        _mm_movemask_epi8(m));
+}
+
+// Returns a 16-bit mask with one bit
+// set for each byte of is_frag_char
+inline
+unsigned
+frag_mask(__m128i v) noexcept
+{
+    auto const zero = _mm_setzero_si128();
+    auto const in_range =
+        [zero](__m128i x, char lo, char n)
+        {
+            return _mm_cmpeq_epi8(
+                _mm_subs_epu8(
+                    _mm_sub_epi8(x,
+                        _mm_set1_epi8(lo)),
+                    _mm_set1_epi8(n)),
+                zero);
+        };
+    auto m = in_range(v, 'a', 25);
+    m = _mm_or_si128(m,
+        in_range(v, '?', 27));          // "?"..."Z"
+    m = _mm_or_si128(m,
+        in_range(v, '&', 21));          // "&"..";"
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(
+        v, _mm_set1_epi8('!')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(
+        v, _mm_set1_epi8('$')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(
+        v, _mm_set1_epi8('=')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(
+        v, _mm_set1_epi8('_')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(
+        v, _mm_set1_epi8('~')));
+    return static_cast<unsigned>(
+        _mm_movemask_epi8(m));
+}
+
+#endif
+
+/*  Return the first character in [first, last)
+    which is not unreserved, or last.
+
+    This is used to skip the runs of characters
+    which need no further classification, before
+    falling back to the table-driven loops.
+*/
+inline
+char const*
+skip_unreserved(
+    char const* first,
+    char const* last) noexcept
+{
+#ifdef BOOST_URL_USE_SSE2
+    while(last - first >= 16)
+    {
+        auto const mask = unreserved_mask(
+            _mm_loadu_si128(reinterpret_cast<
+                __m128i const*>(first)));
+        if(mask != 0xffff)
+            return first + ctz(~mask);
+        first += 16;
+    }
+#endif
+    while(first != last &&
+        is_unreserved(*first))
+        ++first;
+    return first;
+}
+
+/*  Return the first character in [first, last)
+    which is not is_frag_char, or last.
+
+    Everything after the authority of a URL is
+    made of these characters, escapes, and at
+    most one '#', so a long path or query is
+    checked at the speed of this loop.
+*/
+inline
+char const*
+skip_frag(
+    char const* first,
+    char const* last) noexcept
+{
+#ifdef BOOST_URL_USE_SSE2
+    while(last - first >= 32)
+    {
+        // two loads per test of the mask
+        auto const m0 = frag_mask(
+            _mm_loadu_si128(reinterpret_cast<
+                __m128i const*>(first)));
+        auto const m1 = frag_mask(
+            _mm_loadu_si128(reinterpret_cast<
+                __m128i const*>(first + 16)));
+        auto const mask = m0 | (m1 << 16);
+        if(mask != 0xffffffff)
+            return first + ctz(~mask);
+        first += 32;
+    }
+    if(last - first >= 16)
+    {
+        auto const mask = frag_mask(
+            _mm_loadu_si128(reinterpret_cast<
+                __m128i const*>(first)));
+        if(mask != 0xffff)
+            return first + ctz(~mask);
+        first += 16;
+    }
+#endif
+    while(first != last &&
+        is_frag_char(*first))
+        ++first;
+    return first;
+}
+
+} // detail
+} // urls
+} // boost
+
+#endif
@@ -11,31 +11,117 @@
 #define BOOST_URL_DETAIL_STORAGE_HPP
 
 #include <boost/url/config.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/growth_policy.hpp>
+#include <boost/url/detail/instrument.hpp>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
+#include <utility>
 
 namespace boost {
 namespace urls {
 namespace detail {
 
-struct storage
+// The buffer of a url_base. The pointer and
+// sizes live here so that operations which fit
+// in the current capacity, the common case in
+// the setters, are inline. Only growth goes
+// through the virtual function.
+class storage
 {
-    virtual std::size_t capacity() const noexcept = 0;
-    BOOST_URL_NODISCARD virtual char* reserve(std::size_t n) = 0;
+protected:
+    char* p_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t cap_ = 0;
+
+    storage() = default;
+
+    storage(
+        char* p,
+        std::size_t cap) noexcept
+        : p_(p)
+        , cap_(cap)
+    {
+    }
+
+    ~storage() = default;
+
+    // Make the capacity at least n, where
+    // n > cap_, preserving the contents
+    virtual void grow(std::size_t n) = 0;
+
+    // Make the capacity as small as
+    // possible, preserving the contents
+    virtual void shrink() = 0;
+
+public:
+    std::size_t
+    capacity() const noexcept
+    {
+        return cap_;
+    }
+
+    BOOST_URL_NODISCARD
+    char*
+    reserve(std::size_t n)
+    {
+        if(n > cap_)
+            grow(n);
+        return p_;
+    }
 
-    virtual std::size_t size() const noexcept = 0;
-    BOOST_URL_NODISCARD virtual char* resize(std::size_t n) = 0;
+    BOOST_URL_NODISCARD
+    char*
+    shrink_to_fit()
+    {
+        if(size_ < cap_)
+            shrink();
+        return p_;
+    }
+
+    std::size_t
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    BOOST_URL_NODISCARD
+    char*
+    resize(std::size_t n)
+    {
+        if(n > cap_)
+            grow(n);
+        if(p_)
+        {
+            size_ = n;
+            p_[n] = 0;
+        }
+        return p_;
+    }
 };
 
-template<class Allocator>
+// Allocators may provide a try_extend found
+// by argument-dependent lookup, to grow the
+// most recent allocation in place.
+template<class Allocator, class Pointer>
+bool
+try_extend(
+    Allocator&,
+    Pointer,
+    std::size_t,
+    std::size_t) noexcept
+{
+    return false;
+}
+
+template<
+    class Allocator,
+    class GrowthPolicy>
 class alloc_storage
     : public storage
 {
     Allocator a_;
-    char* p_ = nullptr;
-    std::size_t size_ = 0;
-    std::size_t cap_ = 0;
 
     using traits =
         std::allocator_traits<
@@ -49,6 +135,18 @@ public:
     {
     }
 
+    // takes ownership of the buffer
+    alloc_storage(
+        alloc_storage&& other) noexcept
+        : storage(other.p_, other.cap_)
+        , a_(std::move(other.a_))
+    {
+        size_ = other.size_;
+        other.p_ = nullptr;
+        other.size_ = 0;
+        other.cap_ = 0;
+    }
+
     ~alloc_storage()
     {
         if(p_)
@@ -56,28 +154,39 @@ public:
                 p_, cap_ + 1);
     }
 
-    std::size_t
-    capacity() const noexcept override
+    Allocator
+    get_allocator() const noexcept
     {
-        return cap_;
+        return a_;
     }
 
-    BOOST_URL_NODISCARD
-    char*
-    reserve(std::size_t n) override
+    // exchange buffers, the
+    // allocators must be equal
+    void
+    swap(alloc_storage& other) noexcept
     {
-        if(n <= cap_)
-            return p_;
+        std::swap(p_, other.p_);
+        std::swap(size_, other.size_);
+        std::swap(cap_, other.cap_);
+    }
 
-        std::size_t cap =
-            traits::max_size(a_);
-        if(cap_ < cap - cap_)
+private:
+    void
+    grow(std::size_t n) override
+    {
+        BOOST_ASSERT(n > cap_);
+        auto const cap =
+            GrowthPolicy::capacity(
+                cap_, n, traits::max_size(a_));
+        BOOST_ASSERT(cap >= n);
+        if( p_ && try_extend(a_,
+            p_, cap_ + 1, cap + 1))
         {
-            cap = 2 * cap_;
-            if( cap < n)
-                cap = n;
+            cap_ = cap;
+            return;
         }
         auto p = a_.allocate(cap + 1);
+        BOOST_URL_COUNT(++counters().reallocations);
         if(p_)
         {
             std::memcpy(
@@ -88,34 +197,76 @@ public:
         }
         p_ = p;
         cap_ = cap;
-        return p_;
     }
 
-    std::size_t
-    size() const noexcept override
+    void
+    shrink() override
     {
-        return size_;
+        BOOST_ASSERT(size_ < cap_);
+        if(size_ == 0)
+        {
+            a_.deallocate(p_, cap_ + 1);
+            p_ = nullptr;
+            cap_ = 0;
+            return;
+        }
+        auto p = a_.allocate(size_ + 1);
+        BOOST_URL_COUNT(++counters().reallocations);
+        std::memcpy(p, p_, size_ + 1);
+        a_.deallocate(p_, cap_ + 1);
+        p_ = p;
+        cap_ = size_;
+    }
+};
+
+// Storage in a caller-provided buffer of
+// cap + 1 characters. Nothing is allocated,
+// and growing past cap throws before the
+// buffer is touched.
+class fixed_storage
+    : public storage
+{
+public:
+    fixed_storage(
+        char* p,
+        std::size_t cap) noexcept
+        : storage(p, cap)
+    {
+        p_[0] = 0;
     }
 
-    BOOST_URL_NODISCARD
-    char*
-    resize(std::size_t n) override
+private:
+    void
+    grow(std::size_t) override
+    {
+        too_large::raise();
+    }
+
+    void
+    shrink() noexcept override
+    {
+    }
+};
+
+template<std::size_t N>
+struct static_storage_member
+{
+    char buf_[N + 1];
+    fixed_storage st_;
+
+    static_storage_member() noexcept
+        : st_(buf_, N)
     {
-        if( char* p = reserve(n) )
-        {
-            size_ = n;
-            p[n] = 0;
-            return p;
-        }
-        else
-            return p;
     }
 };
 
-template<class Allocator>
+template<
+    class Allocator,
+    class GrowthPolicy>
 struct storage_member
 {
-    alloc_storage<Allocator> st_;
+    alloc_storage<
+        Allocator, GrowthPolicy> st_;
 
     explicit
     storage_member(
@@ -123,6 +274,8 @@ struct storage_member
         : st_(alloc)
     {
     }
+    storage_member(
+        storage_member&&) = default;
 };
 
 } // detail
@@ -0,0 +1,870 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_DETAIL_TABLE_PARSE_HPP
+#define BOOST_URL_DETAIL_TABLE_PARSE_HPP
+
+#include <boost/url/detail/char_type.hpp>
+#include <boost/url/detail/parse.hpp>
+#include <boost/url/detail/parts.hpp>
+#include <boost/url/error.hpp>
+#include <cstdint>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+/*  Single-pass URL parser
+
+    Each byte is mapped once, through a table
+    built at compile time, to one of a handful of
+    character classes. Every part of the URL is
+    then a set of classes, so that a state only
+    tests one bit per byte. Outside of the
+    authority, runs of unreserved characters are
+    skipped in bulk first. This accepts exactly
+    the same strings as parse_url and produces
+    the same parts; the tests check this on
+    random input.
+
+    The authority is scanned once as userinfo.
+    When no '@' follows, the bytes already seen
+    are the host and port, so there is no need
+    to backtrack. IP literals are handed to the
+    IPv6 matcher of the recursive parser.
+*/
+
+enum char_class : unsigned char
+{
+    cc_other = 0,   // not allowed anywhere
+    cc_alpha,       // ALPHA
+    cc_digit,       // DIGIT
+    cc_mark,        // '+' / '-' / '.'
+    cc_unres,       // '_' / '~'
+    cc_sub,         // sub-delims except '&', '+', '='
+    cc_amp,         // '&'
+    cc_eq,          // '='
+    cc_colon,       // ':'
+    cc_at,          // '@'
+    cc_slash,       // '/'
+    cc_quest,       // '?'
+    cc_hash,        // '#'
+    cc_pct,         // '%'
+    cc_lbracket     // '['
+};
+
+constexpr
+unsigned char
+classify(unsigned char c) noexcept
+{
+    return
+        ((c >= 'A' && c <= 'Z') ||
+         (c >= 'a' && c <= 'z')) ? cc_alpha :
+        (c >= '0' && c <= '9') ? cc_digit :
+        (c == '+' || c == '-' || c == '.') ? cc_mark :
+        (c == '_' || c == '~') ? cc_unres :
+        (c == '!' || c == '$' || c == '\'' ||
+         c == '(' || c == ')' || c == '*' ||
+         c == ',' || c == ';') ? cc_sub :
+        c == '&' ? cc_amp :
+        c == '=' ? cc_eq :
+        c == ':' ? cc_colon :
+        c == '@' ? cc_at :
+        c == '/' ? cc_slash :
+        c == '?' ? cc_quest :
+        c == '#' ? cc_hash :
+        c == '%' ? cc_pct :
+        c == '[' ? cc_lbracket :
+        cc_other;
+}
+
+// The class of every byte, as a static member
+// of a class template so that it may be used
+// in constant expressions
+template<class = void>
+struct char_class_table
+{
+#define BOOST_URL_CC4(n) \
+    classify(n), classify(n+1), classify(n+2), classify(n+3)
+#define BOOST_URL_CC16(n) \
+    BOOST_URL_CC4(n), BOOST_URL_CC4(n+4), \
+    BOOST_URL_CC4(n+8), BOOST_URL_CC4(n+12)
+#define BOOST_URL_CC64(n) \
+    BOOST_URL_CC16(n), BOOST_URL_CC16(n+16), \
+    BOOST_URL_CC16(n+32), BOOST_URL_CC16(n+48)
+    static constexpr unsigned char tab[256] = {
+        BOOST_URL_CC64(0),   BOOST_URL_CC64(64),
+        BOOST_URL_CC64(128), BOOST_URL_CC64(192) };
+#undef BOOST_URL_CC64
+#undef BOOST_URL_CC16
+#undef BOOST_URL_CC4
+};
+
+template<class T>
+constexpr unsigned char char_class_table<T>::tab[256];
+
+constexpr
+unsigned char
+char_class_of(char c) noexcept
+{
+    return char_class_table<>::tab[
+        static_cast<unsigned char>(c)];
+}
+
+// The classes accepted by each state
+enum : std::uint16_t
+{
+    cm_scheme =
+        (1 << cc_alpha) | (1 << cc_digit) |
+        (1 << cc_mark),
+
+    cm_reg_name =
+        cm_scheme | (1 << cc_unres) |
+        (1 << cc_sub) | (1 << cc_amp) |
+        (1 << cc_eq) | (1 << cc_pct),
+
+    cm_userinfo =
+        cm_reg_name | (1 << cc_colon),
+
+    cm_pchar =
+        cm_userinfo | (1 << cc_at),
+
+    cm_pchar_nc =
+        cm_reg_name | (1 << cc_at),
+
+    cm_segments =
+        cm_pchar | (1 << cc_slash),
+
+    cm_frag =
+        cm_segments | (1 << cc_quest),
+
+    cm_qkey =
+        cm_frag & ~(1 << cc_eq),
+
+    cm_qval =
+        cm_frag & ~(1 << cc_amp)
+};
+
+// tracks whether a host is an IPv4address
+struct ipv4_state
+{
+    unsigned v = 0;
+    unsigned len = 0;
+    unsigned dots = 0;
+    bool ok = true;
+    unsigned char addr[4] = {};
+
+    BOOST_URL_CONSTEXPR14
+    void
+    digit(unsigned d) noexcept
+    {
+        // no leading zeroes
+        if(len == 1 && v == 0)
+            ok = false;
+        v = 10 * v + d;
+        ++len;
+        if(v > 255)
+            ok = false;
+    }
+
+    BOOST_URL_CONSTEXPR14
+    void
+    dot() noexcept
+    {
+        if(len == 0 || dots >= 3)
+            ok = false;
+        else
+            addr[dots] = static_cast<
+                unsigned char>(v);
+        ++dots;
+        len = 0;
+        v = 0;
+    }
+
+    // stores the address on success
+    BOOST_URL_CONSTEXPR14
+    bool
+    done(unsigned char* dest) noexcept
+    {
+        if(! ok ||
+            dots != 3 ||
+            len == 0)
+            return false;
+        addr[3] = static_cast<
+            unsigned char>(v);
+        for(int i = 0; i < 4; ++i)
+            dest[i] = addr[i];
+        return true;
+    }
+};
+
+// accumulates a port number,
+// which is 0 if too large
+struct port_state
+{
+    std::uint32_t v = 0;
+
+    BOOST_URL_CONSTEXPR14
+    void
+    digit(unsigned d) noexcept
+    {
+        if(v <= 0xffff)
+            v = 10 * v + d;
+    }
+
+    BOOST_URL_CONSTEXPR14
+    std::uint16_t
+    value() const noexcept
+    {
+        if(v > 0xffff)
+            return 0;
+        return static_cast<
+            std::uint16_t>(v);
+    }
+};
+
+//----------------------------------------------------------
+
+class table_parser
+{
+    char const* const begin_;
+    char const* const end_;
+    char const* p_;
+    parts pt_;
+
+    bool
+    in(unsigned char cc,
+        std::uint16_t mask) const noexcept
+    {
+        return ((mask >> cc) & 1) != 0;
+    }
+
+    // set the end of part id
+    void
+    mark(int id) noexcept
+    {
+        pt_.offset[id + 1] =
+            static_cast<parts::size_type>(
+                p_ - begin_);
+    }
+
+    void
+    escape(error_code& ec) noexcept
+    {
+        pct_encoding::check_escape(
+            p_ + 1, end_, ec);
+        p_ += 3;
+    }
+
+    // skip the bytes in the set
+    void
+    scan(
+        std::uint16_t mask,
+        error_code& ec) noexcept
+    {
+        if(! in(cc_unres, mask))
+            return;
+        while(p_ < end_)
+        {
+            // runs of unreserved are common
+            p_ = skip_unreserved(p_, end_);
+            if(p_ == end_)
+                break;
+            auto const cc =
+                char_class_of(*p_);
+            if(! in(cc, mask))
+                break;
+            if(cc == cc_pct)
+            {
+                escape(ec);
+                if(ec)
+                    return;
+                continue;
+            }
+            ++p_;
+        }
+    }
+
+    // host = IP-literal / IPv4address / reg-name
+    void
+    parse_host(error_code& ec) noexcept
+    {
+        if( p_ < end_ &&
+            *p_ == '[')
+        {
+            parser pr(p_ + 1, end_);
+            pr.parse_ip_v6(pt_.ip, ec);
+            if(ec)
+                return;
+            if( pr.p_ == end_ ||
+                *pr.p_ != ']')
+            {
+                ec = error::syntax;
+                return;
+            }
+            p_ = pr.p_ + 1;
+            pt_.host = host_type::ipv6;
+        }
+        else
+        {
+            auto const p0 = p_;
+            ipv4_state v4;
+            while(p_ < end_)
+            {
+                auto const cc =
+                    char_class_of(*p_);
+                if(! in(cc, cm_reg_name))
+                    break;
+                if(cc == cc_digit)
+                    v4.digit(*p_ - '0');
+                else if(*p_ == '.')
+                    v4.dot();
+                else
+                    v4.ok = false;
+                if(cc == cc_pct)
+                {
+                    escape(ec);
+                    if(ec)
+                        return;
+                    continue;
+                }
+                ++p_;
+            }
+            if(v4.done(pt_.ip))
+                pt_.host = host_type::ipv4;
+            else if(p_ != p0)
+                pt_.host = host_type::name;
+        }
+        mark(id_host);
+
+        // port
+        if( p_ < end_ &&
+            *p_ == ':')
+        {
+            ++p_;
+            port_state pn;
+            while( p_ < end_ &&
+                char_class_of(*p_) == cc_digit)
+                pn.digit(*p_++ - '0');
+            pt_.port_number = pn.value();
+        }
+        mark(id_port);
+    }
+
+    // authority = [ userinfo "@" ] host [ ":" port ]
+    void
+    parse_authority(error_code& ec) noexcept
+    {
+        auto const p0 = p_;
+        char const* colon = nullptr;
+        bool port = true;
+        port_state pn;
+        ipv4_state v4;
+        while(p_ < end_)
+        {
+            auto const cc =
+                char_class_of(*p_);
+            if(! in(cc, cm_userinfo))
+                break;
+            if(cc == cc_colon)
+            {
+                if(colon)
+                    port = false;
+                else
+                    colon = p_;
+            }
+            else if(colon)
+            {
+                if(cc != cc_digit)
+                    port = false;
+                else
+                    pn.digit(*p_ - '0');
+            }
+            else if(cc == cc_digit)
+            {
+                v4.digit(*p_ - '0');
+            }
+            else if(*p_ == '.')
+            {
+                v4.dot();
+            }
+            else
+            {
+                v4.ok = false;
+            }
+            if(cc == cc_pct)
+            {
+                escape(ec);
+                if(ec)
+                    return;
+                continue;
+            }
+            ++p_;
+        }
+
+        if( p_ < end_ &&
+            *p_ == '@')
+        {
+            // userinfo "@"
+            auto const p1 = p_;
+            p_ = colon ? colon : p1;
+            mark(id_user);
+            p_ = p1 + 1;
+            mark(id_password);
+            parse_host(ec);
+            return;
+        }
+
+        auto const p1 = p_;
+        p_ = p0;
+        mark(id_user);
+        mark(id_password);
+        if(p1 == p0)
+        {
+            // possibly an IP-literal
+            parse_host(ec);
+            return;
+        }
+
+        // the bytes seen are host [ ":" port ]
+        if(! colon)
+            colon = p1;
+        else if(! port)
+        {
+            ec = error::syntax;
+            return;
+        }
+        if(v4.done(pt_.ip))
+            pt_.host = host_type::ipv4;
+        else if(colon != p0)
+            pt_.host = host_type::name;
+        p_ = colon;
+        mark(id_host);
+        p_ = p1;
+        mark(id_port);
+        pt_.port_number = pn.value();
+    }
+
+    // path, which starts at p0. The first
+    // segment, of the characters in the set
+    // first, is scanned from p_
+    void
+    parse_path(
+        char const* p0,
+        std::uint16_t first,
+        error_code& ec) noexcept
+    {
+        std::size_t n = 0;
+        if( p0 == end_ ||
+            *p0 != '/')
+        {
+            // path-rootless / path-noscheme
+            scan(first, ec);
+            if(ec)
+                return;
+            if(p_ == p0)
+            {
+                // path-empty
+                mark(id_path);
+                return;
+            }
+            if( p_ < end_ &&
+                *p_ != '/')
+            {
+                // a path-noscheme
+                // followed by ':'
+                mark(id_path);
+                pt_.nseg = 1;
+                return;
+            }
+            n = 1;
+        }
+        while(p_ < end_)
+        {
+            p_ = skip_unreserved(p_, end_);
+            if(p_ == end_)
+                break;
+            auto const cc =
+                char_class_of(*p_);
+            if(! in(cc, cm_segments))
+                break;
+            if(cc == cc_slash)
+            {
+                ++n;
+                ++p_;
+                continue;
+            }
+            if(cc == cc_pct)
+            {
+                escape(ec);
+                if(ec)
+                    return;
+                continue;
+            }
+            ++p_;
+        }
+        mark(id_path);
+        pt_.nseg = static_cast<
+            parts::size_type>(n);
+    }
+
+    // hier-part / relative-part
+    void
+    parse_hier_part(
+        std::uint16_t first,
+        error_code& ec) noexcept
+    {
+        if( end_ - p_ >= 2 &&
+            p_[0] == '/' &&
+            p_[1] == '/')
+        {
+            p_ += 2;
+            parse_authority(ec);
+            if(ec)
+                return;
+            // path-abempty
+            first = 0;
+        }
+        parse_path(p_, first, ec);
+    }
+
+    // query = *( pchar / "/" / "?" )
+    void
+    parse_query(error_code& ec) noexcept
+    {
+        std::size_t n = 1;
+        auto mask = cm_qkey;
+        ++p_;
+        while(p_ < end_)
+        {
+            p_ = skip_unreserved(p_, end_);
+            if(p_ == end_)
+                break;
+            auto const cc =
+                char_class_of(*p_);
+            if(! in(cc, mask))
+            {
+                if( mask == cm_qkey &&
+                    cc == cc_eq)
+                {
+                    mask = cm_qval;
+                    ++p_;
+                    continue;
+                }
+                if( mask == cm_qval &&
+                    cc == cc_amp)
+                {
+                    mask = cm_qkey;
+                    ++n;
+                    ++p_;
+                    continue;
+                }
+                break;
+            }
+            if(cc == cc_pct)
+            {
+                escape(ec);
+                if(ec)
+                    return;
+                continue;
+            }
+            ++p_;
+        }
+        mark(id_query);
+        pt_.nparam = static_cast<
+            parts::size_type>(n);
+    }
+
+public:
+    explicit
+    table_parser(
+        string_view s) noexcept
+        : begin_(s.data())
+        , end_(begin_ + s.size())
+        , p_(begin_)
+    {
+    }
+
+    void
+    parse(
+        parts& pt,
+        error_code& ec) noexcept
+    {
+        // scheme ":"
+        if( p_ < end_ &&
+            char_class_of(*p_) == cc_alpha)
+        {
+            ++p_;
+            while( p_ < end_ && in(
+                char_class_of(*p_), cm_scheme))
+                ++p_;
+            if( p_ < end_ &&
+                *p_ == ':')
+            {
+                // absolute-URI
+                ++p_;
+                mark(id_scheme);
+                pt_.scheme_id = string_to_scheme(
+                    string_view(begin_,
+                        p_ - 1 - begin_));
+                parse_hier_part(
+                    cm_pchar, ec);
+            }
+            else
+            {
+                // relative-ref, the scheme
+                // characters begin the path
+                parse_path(begin_,
+                    cm_pchar_nc, ec);
+            }
+        }
+        else
+        {
+            // relative-ref
+            parse_hier_part(
+                cm_pchar_nc, ec);
+        }
+        if(ec)
+            return;
+
+        if( p_ < end_ &&
+            *p_ == '?')
+        {
+            parse_query(ec);
+            if(ec)
+                return;
+        }
+
+        if( p_ < end_ &&
+            *p_ == '#')
+        {
+            ++p_;
+            scan(cm_frag, ec);
+            if(ec)
+                return;
+            mark(id_frag);
+        }
+
+        if(p_ != end_)
+        {
+            ec = error::syntax;
+            return;
+        }
+
+        // parts which are absent are
+        // empty, at the end of the previous
+        for(int i = id_user;
+            i <= id_end; ++i)
+            if(pt_.offset[i] <
+                    pt_.offset[i - 1])
+                pt_.offset[i] =
+                    pt_.offset[i - 1];
+        pt = pt_;
+    }
+
+    // Parse only the part id of the URL s,
+    // whose boundaries were found already by
+    // find_parts, and update its parts. The
+    // authority is parsed for id_host.
+    static
+    void
+    parse_part(
+        int id,
+        char const* s,
+        parts& pt,
+        error_code& ec) noexcept
+    {
+        auto const at = [s, &pt](int i)
+        {
+            return s + pt.offset[i];
+        };
+        switch(id)
+        {
+        case id_host:
+        {
+            if(pt.length(id_user, id_path) == 0)
+                return;
+            table_parser pr(string_view(
+                s, pt.offset[id_path]));
+            pr.pt_ = pt;
+            pr.p_ = at(id_user) + 2;
+            pr.parse_authority(ec);
+            if(! ec && pr.p_ != pr.end_)
+                ec = error::syntax;
+            if(ec)
+                return;
+            for(int i = id_user;
+                    i <= id_port; ++i)
+                pt.offset[i + 1] =
+                    pr.pt_.offset[i + 1];
+            pt.set_host(pr.pt_);
+            pt.port_number = pr.pt_.port_number;
+            return;
+        }
+
+        case id_path:
+        {
+            // as parse_hier_part
+            std::uint16_t first = 0;
+            if(pt.length(id_user, id_path) == 0)
+                first = pt.length(id_scheme) > 0 ?
+                    cm_pchar : cm_pchar_nc;
+            table_parser pr(string_view(
+                s, pt.offset[id_query]));
+            pr.pt_ = pt;
+            pr.p_ = at(id_path);
+            pr.parse_path(pr.p_, first, ec);
+            if(! ec && pr.p_ != pr.end_)
+                ec = error::syntax;
+            if(ec)
+                return;
+            pt.nseg = pr.pt_.nseg;
+            return;
+        }
+
+        case id_query:
+        {
+            if(pt.length(id_query) == 0)
+                return;
+            table_parser pr(string_view(
+                s, pt.offset[id_frag]));
+            pr.pt_ = pt;
+            pr.p_ = at(id_query);
+            pr.parse_query(ec);
+            if(! ec && pr.p_ != pr.end_)
+                ec = error::syntax;
+            if(ec)
+                return;
+            pt.nparam = pr.pt_.nparam;
+            return;
+        }
+
+        case id_frag:
+        {
+            if(pt.length(id_frag) == 0)
+                return;
+            table_parser pr(string_view(
+                s, pt.offset[id_end]));
+            pr.p_ = at(id_frag) + 1;
+            pr.scan(cm_frag, ec);
+            if(! ec && pr.p_ != pr.end_)
+                ec = error::syntax;
+            return;
+        }
+
+        default:
+            BOOST_ASSERT(false);
+            return;
+        }
+    }
+};
+
+// URL (a.k.a. URI-reference), single-pass
+inline
+void
+parse_url_table(
+    parts& pt,
+    string_view s,
+    error_code& ec) noexcept
+{
+    // offsets are stored in 32 bits
+    if(s.size() > BOOST_URL_MAX_STRING_SIZE)
+    {
+        ec = error::invalid;
+        return;
+    }
+    table_parser pr(s);
+    pr.parse(pt, ec);
+}
+
+// Find the boundaries of the parts of a URL,
+// parsing only the scheme. The authority, if
+// any, is the user part; the path, query, and
+// fragment are not checked. A part is parsed
+// later by table_parser::parse_part.
+inline
+void
+find_parts(
+    parts& pt,
+    string_view s,
+    error_code& ec) noexcept
+{
+    if(s.size() > BOOST_URL_MAX_STRING_SIZE)
+    {
+        ec = error::invalid;
+        return;
+    }
+    auto const begin = s.data();
+    auto const end = begin + s.size();
+    auto p = begin;
+    auto const mark = [&](int id)
+    {
+        pt.offset[id + 1] = static_cast<
+            parts::size_type>(p - begin);
+    };
+
+    // scheme ":"
+    if( p < end &&
+        char_class_of(*p) == cc_alpha)
+    {
+        ++p;
+        while( p < end && ((cm_scheme >>
+                char_class_of(*p)) & 1))
+            ++p;
+        if( p < end &&
+            *p == ':')
+        {
+            ++p;
+            pt.scheme_id = string_to_scheme(
+                string_view(begin,
+                    p - 1 - begin));
+        }
+        else
+        {
+            p = begin;
+        }
+    }
+    mark(id_scheme);
+
+    // '#' cannot appear before the fragment,
+    // nor '?' before the query
+    auto h = static_cast<char const*>(
+        std::memchr(p, '#', end - p));
+    if(! h)
+        h = end;
+    auto q = static_cast<char const*>(
+        std::memchr(p, '?', h - p));
+    if(! q)
+        q = h;
+
+    // "//" authority, up to the path
+    if( q - p >= 2 &&
+        p[0] == '/' &&
+        p[1] == '/')
+    {
+        auto const a = static_cast<char const*>(
+            std::memchr(p + 2, '/', q - p - 2));
+        p = a ? a : q;
+    }
+    for(int i = id_user; i <= id_port; ++i)
+        mark(i);
+    p = q;
+    mark(id_path);
+    p = h;
+    mark(id_query);
+    p = end;
+    mark(id_frag);
+}
+
+} // detail
+} // urls
+} // boost
+
+#endif
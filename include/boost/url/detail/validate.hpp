@@ -0,0 +1,290 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_DETAIL_VALIDATE_HPP
+#define BOOST_URL_DETAIL_VALIDATE_HPP
+
+#include <boost/url/detail/char_type.hpp>
+#include <boost/url/detail/parse.hpp>
+#include <boost/url/detail/simd.hpp>
+#include <boost/url/detail/table_parse.hpp>
+#include <boost/url/error.hpp>
+#include <cstdint>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+/*  URL validator
+
+    This accepts exactly the same strings as
+    parse_url and reports the same errors, but
+    keeps no parts, so there are no offsets to
+    store and nothing to count.
+
+    After the authority, a path, query, and
+    fragment together are the characters of
+    is_frag_char, escapes, and at most one '#'.
+    Only the first segment of a relative path
+    differs, as it may not hold a ':'. So the
+    rest of the URL is checked in one loop over
+    skip_frag, which stops only at an escape,
+    a '#', or an error.
+*/
+class validator
+{
+    char const* const begin_;
+    char const* const end_;
+    char const* p_;
+
+    static
+    bool
+    in(unsigned char cc,
+        std::uint16_t mask) noexcept
+    {
+        return ((mask >> cc) & 1) != 0;
+    }
+
+    static
+    bool
+    is_digit(char c) noexcept
+    {
+        return static_cast<unsigned char>(
+            c - '0') < 10;
+    }
+
+    // skip the bytes in the set
+    void
+    scan(
+        std::uint16_t mask,
+        error_code& ec) noexcept
+    {
+        while(p_ < end_)
+        {
+            p_ = skip_unreserved(p_, end_);
+            if(p_ == end_)
+                break;
+            auto const cc =
+                char_class_of(*p_);
+            if(! in(cc, mask))
+                break;
+            if(cc == cc_pct)
+            {
+                pct_encoding::check_escape(
+                    p_ + 1, end_, ec);
+                if(ec)
+                    return;
+                p_ += 3;
+                continue;
+            }
+            ++p_;
+        }
+    }
+
+    // host [ ":" port ]
+    void
+    host(error_code& ec) noexcept
+    {
+        if( p_ < end_ &&
+            *p_ == '[')
+        {
+            unsigned char ip[16];
+            parser pr(p_ + 1, end_);
+            pr.parse_ip_v6(ip, ec);
+            p_ = pr.p_;
+            if(ec)
+                return;
+            if( p_ == end_ ||
+                *p_ != ']')
+            {
+                ec = error::syntax;
+                return;
+            }
+            ++p_;
+        }
+        else
+        {
+            // an IPv4address is a reg-name
+            scan(cm_reg_name, ec);
+            if(ec)
+                return;
+        }
+        if( p_ < end_ &&
+            *p_ == ':')
+        {
+            ++p_;
+            while( p_ < end_ &&
+                is_digit(*p_))
+                ++p_;
+        }
+    }
+
+    // authority = [ userinfo "@" ] host [ ":" port ]
+    void
+    authority(error_code& ec) noexcept
+    {
+        auto const p0 = p_;
+        scan(cm_userinfo, ec);
+        if(ec)
+            return;
+        if( p_ < end_ &&
+            *p_ == '@')
+        {
+            ++p_;
+            host(ec);
+            return;
+        }
+        if(p_ == p0)
+        {
+            // possibly an IP-literal
+            host(ec);
+            return;
+        }
+
+        // the bytes seen are host [ ":" port ]
+        auto const p1 = p_;
+        auto const colon = static_cast<
+            char const*>(std::memchr(
+                p0, ':', p1 - p0));
+        if(! colon)
+            return;
+        p_ = colon + 1;
+        while( p_ < p1 &&
+            is_digit(*p_))
+            ++p_;
+        if(p_ != p1)
+            ec = error::syntax;
+    }
+
+    // path, query, and fragment
+    void
+    tail(error_code& ec) noexcept
+    {
+        bool frag = false;
+        for(;;)
+        {
+            p_ = skip_frag(p_, end_);
+            if(p_ == end_)
+                return;
+            if(*p_ == '%')
+            {
+                pct_encoding::check_escape(
+                    p_ + 1, end_, ec);
+                if(ec)
+                    return;
+                p_ += 3;
+                continue;
+            }
+            if( *p_ == '#' &&
+                ! frag)
+            {
+                frag = true;
+                ++p_;
+                continue;
+            }
+            ec = error::syntax;
+            return;
+        }
+    }
+
+public:
+    explicit
+    validator(
+        string_view s) noexcept
+        : begin_(s.data())
+        , end_(begin_ + s.size())
+        , p_(begin_)
+    {
+    }
+
+    // Returns the offset of the error, or
+    // the size of the string if there is none
+    std::size_t
+    validate(error_code& ec) noexcept
+    {
+        // the first segment of a relative path
+        auto first = cm_pchar_nc;
+
+        // scheme ":"
+        if( p_ < end_ &&
+            char_class_of(*p_) == cc_alpha)
+        {
+            auto p = p_ + 1;
+            while( p < end_ && in(
+                char_class_of(*p), cm_scheme))
+                ++p;
+            if( p < end_ &&
+                *p == ':')
+            {
+                // absolute-URI
+                p_ = p + 1;
+                first = cm_pchar;
+            }
+        }
+
+        if( end_ - p_ >= 2 &&
+            p_[0] == '/' &&
+            p_[1] == '/')
+        {
+            p_ += 2;
+            authority(ec);
+            if(ec)
+                return p_ - begin_;
+            // path-abempty
+            if( p_ < end_ &&
+                *p_ != '/' &&
+                *p_ != '?' &&
+                *p_ != '#')
+            {
+                ec = error::syntax;
+                return p_ - begin_;
+            }
+        }
+        else if(first == cm_pchar_nc)
+        {
+            // path-noscheme
+            scan(first, ec);
+            if(ec)
+                return p_ - begin_;
+            if( p_ < end_ &&
+                *p_ == ':')
+            {
+                ec = error::syntax;
+                return p_ - begin_;
+            }
+        }
+
+        tail(ec);
+        return p_ - begin_;
+    }
+};
+
+// URL (a.k.a. URI-reference), without parts
+inline
+std::size_t
+validate_url(
+    string_view s,
+    error_code& ec) noexcept
+{
+    // offsets are stored in 32 bits
+    if(s.size() > BOOST_URL_MAX_STRING_SIZE)
+    {
+        ec = error::invalid;
+        return 0;
+    }
+    validator v(s);
+    return v.validate(ec);
+}
+
+} // detail
+} // urls
+} // boost
+
+#endif
@@ -121,7 +121,44 @@ enum class error
     incomplete_pct_encoding,
 
     /// Illegal reserved character in encoded string.
-    illegal_reserved_char
+    illegal_reserved_char,
+
+    //---
+
+    /** More input is needed to complete the URL.
+
+        This error is returned by @ref url_parser
+        when every byte of the input belongs to the
+        URL, and the URL may continue.
+    */
+    need_more,
+
+    //---
+
+    /// The string is not valid UTF-8.
+    bad_utf8,
+
+    /// A punycode label is malformed.
+    bad_punycode,
+
+    /// An internationalized label contains a character which is not allowed.
+    bad_idn_char,
+
+    /// A label of the host is longer than 63 characters.
+    label_too_long,
+
+    //---
+
+    /// A serialized URL is corrupt.
+    bad_serialized_url,
+
+    /// Serialized URLs are in an unsupported version of the format.
+    unsupported_version,
+
+    //---
+
+    /// The output buffer is too small.
+    buffer_full
 };
 
 enum class condition
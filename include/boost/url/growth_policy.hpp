@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_GROWTH_POLICY_HPP
+#define BOOST_URL_GROWTH_POLICY_HPP
+
+#include <boost/url/config.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+
+/*  A growth policy decides the capacity of the
+    buffer of a basic_url which must grow. It is a
+    type with this static member function:
+
+        std::size_t
+        capacity(
+            std::size_t cap,    // current capacity
+            std::size_t n,      // needed, n > cap
+            std::size_t max     // largest allowed
+            ) noexcept;
+
+    which returns the new capacity, at least n
+    and at most max.
+*/
+
+/** A growth policy which doubles the capacity.
+
+    The capacity becomes the larger of twice the
+    old capacity and the size needed, so a URL
+    built by many small changes is reallocated a
+    logarithmic number of times. This is the
+    default for @ref basic_url.
+*/
+struct geometric_growth
+{
+    static
+    std::size_t
+    capacity(
+        std::size_t cap,
+        std::size_t n,
+        std::size_t max) noexcept
+    {
+        if(cap >= max - cap)
+            return max;
+        if(n < 2 * cap)
+            return 2 * cap;
+        return n;
+    }
+};
+
+/** A growth policy which allocates exactly the size needed.
+
+    This wastes no memory, which suits URLs that
+    are set once and kept for a long time, at the
+    cost of a reallocation for every change which
+    makes the URL longer.
+*/
+struct exact_growth
+{
+    static
+    std::size_t
+    capacity(
+        std::size_t,
+        std::size_t n,
+        std::size_t) noexcept
+    {
+        return n;
+    }
+};
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,182 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_HASH_HPP
+#define BOOST_URL_HASH_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/url_view.hpp>
+#include <cstddef>
+#include <functional>
+
+namespace boost {
+namespace urls {
+
+/*  Every function below treats two URLs alike
+    when url_base::normalize would make them the
+    same string. The encoded characters are read
+    in place and put in normal form as they are
+    hashed or compared.
+
+    The only exception is a path with dot segments
+    longer than the internal buffer, which is copied
+    to allocated memory so they can be removed.
+*/
+
+/** Return a hash of a URL in normal form.
+
+    The value is the same for URLs which are
+    equal after calling @ref url_base::normalize
+    with @ref normalize_flags::all, and the same
+    in every process and on every platform.
+
+    @par Example
+    @code
+    assert( hash_url( url_view( "HTTP://Example.com:80/a/./b%7e" ) ) ==
+            hash_url( url_view( "http://example.com/a/b~" ) ) );
+    @endcode
+
+    @par Exception Safety
+
+    Strong guarantee.
+    Calls to allocate may throw.
+
+    @see equivalent
+*/
+BOOST_URL_DECL
+std::size_t
+hash_url(url_view const& u);
+
+/** Return a hash of the origin of a URL in normal form.
+
+    The origin is the scheme and the authority.
+    The value is the same for URLs whose origins
+    are equal after normalization.
+
+    @par Exception Safety
+
+    No-throw guarantee.
+*/
+BOOST_URL_DECL
+std::size_t
+hash_origin(url_view const& u) noexcept;
+
+/** Return a hash of the path of a URL in normal form.
+
+    The value is the same for URLs whose paths
+    are equal after normalization, including the
+    removal of dot segments.
+
+    @par Exception Safety
+
+    Strong guarantee.
+    Calls to allocate may throw.
+*/
+BOOST_URL_DECL
+std::size_t
+hash_path(url_view const& u);
+
+/** Return a hash of the query parameters of a URL, in any order.
+
+    The query is split at each ampersand ('&'), and
+    the value is the same for URLs which have the
+    same parameters in normal form, the same number
+    of times each, in any order. A URL with no query
+    and a URL with an empty query hash differently.
+
+    @par Exception Safety
+
+    No-throw guarantee.
+*/
+BOOST_URL_DECL
+std::size_t
+hash_query_unordered(url_view const& u) noexcept;
+
+/** Return `true` if two URLs are the same in normal form.
+
+    This function returns `true` when the URLs
+    would be equal after calling @ref url_base::normalize
+    with @ref normalize_flags::all on each, without
+    modifying or copying them.
+
+    @par Exception Safety
+
+    Strong guarantee.
+    Calls to allocate may throw.
+
+    @see hash_url
+*/
+BOOST_URL_DECL
+bool
+equivalent(
+    url_view const& u0,
+    url_view const& u1);
+
+//----------------------------------------------------------
+
+/** A function object which returns the hash of a URL in normal form.
+
+    @see url_equal
+*/
+struct url_hash
+{
+    std::size_t
+    operator()(url_view const& u) const
+    {
+        return hash_url(u);
+    }
+};
+
+/** A function object which returns `true` if two URLs are the same in normal form.
+
+    @par Example
+    @code
+    std::unordered_set<url, url_hash, url_equal> seen;
+    @endcode
+
+    @see url_hash
+*/
+struct url_equal
+{
+    bool
+    operator()(
+        url_view const& u0,
+        url_view const& u1) const
+    {
+        return equivalent(u0, u1);
+    }
+};
+
+} // urls
+} // boost
+
+namespace std {
+
+/** The hash of a URL in normal form.
+
+    @see boost::urls::hash_url
+*/
+template<>
+struct hash<boost::urls::url_view>
+{
+    std::size_t
+    operator()(
+        boost::urls::url_view const& u) const
+    {
+        return boost::urls::hash_url(u);
+    }
+};
+
+} // std
+
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/hash.ipp>
+#endif
+
+#endif
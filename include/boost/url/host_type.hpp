@@ -23,7 +23,7 @@ namespace urls {
 
     @see url_view::host, url_base::host
 */
-enum class host_type
+enum class host_type : unsigned char
 {
     /** No host is specified.
     */
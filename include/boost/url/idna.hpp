@@ -0,0 +1,201 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IDNA_HPP
+#define BOOST_URL_IDNA_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/error.hpp>
+#include <string>
+
+namespace boost {
+namespace urls {
+
+/** Return the punycode encoding of a string.
+
+    The UTF-8 string `s` is encoded as described
+    in rfc3492, without the `"xn--"` prefix used
+    for the labels of a host. Its characters are
+    not mapped or checked.
+
+    @par Example
+    @code
+    assert( punycode_encode( "b\xc3\xbc" "cher" ) == "bcher-kva" );
+    @endcode
+
+    @par Exception Safety
+
+    Throws @ref invalid_part if `s` is not valid
+    UTF-8. Calls to allocate may throw.
+
+    @param s The string to encode.
+*/
+BOOST_URL_DECL
+std::string
+punycode_encode(string_view s);
+
+/** Return the punycode encoding of a string.
+
+    This function behaves as the overload without
+    the error code, except that errors are reported
+    by setting `ec` and returning an empty string.
+
+    @param s The string to encode.
+
+    @param ec Set to the error, if any occurred.
+*/
+BOOST_URL_DECL
+std::string
+punycode_encode(
+    string_view s,
+    error_code& ec);
+
+/** Return the UTF-8 string encoded in punycode.
+
+    The punycode string `s`, without its `"xn--"`
+    prefix, is decoded as described in rfc3492.
+
+    @par Exception Safety
+
+    Throws @ref invalid_part if `s` is not a valid
+    punycode string. Calls to allocate may throw.
+
+    @param s The string to decode.
+*/
+BOOST_URL_DECL
+std::string
+punycode_decode(string_view s);
+
+/** Return the UTF-8 string encoded in punycode.
+
+    This function behaves as the overload without
+    the error code, except that errors are reported
+    by setting `ec` and returning an empty string.
+
+    @param s The string to decode.
+
+    @param ec Set to the error, if any occurred.
+*/
+BOOST_URL_DECL
+std::string
+punycode_decode(
+    string_view s,
+    error_code& ec);
+
+/** Return the ASCII form of an internationalized host name.
+
+    The UTF-8 host name `s` is split into labels
+    at each full stop, including the ideographic
+    and fullwidth full stops. Letters with simple
+    lowercase forms are lowercased. Each label
+    containing a character beyond ASCII is then
+    replaced by `"xn--"` followed by its punycode
+    encoding, as done by the ToASCII operation of
+    IDNA. Those labels may contain only letters,
+    digits, and hyphens, and must be no longer than
+    63 characters once encoded. Labels which are
+    entirely ASCII are copied, lowercased.
+
+    This is the conversion applied by
+    @ref url_base::set_host to a host name which
+    is not ASCII. The full mapping and normalization
+    tables of UTS #46 are not applied; names should
+    be in normalization form C.
+
+    @par Example
+    @code
+    assert( idna_to_ascii( "M\xc3\xbcnchen.de" ) == "xn--mnchen-3ya.de" );
+    @endcode
+
+    @par Exception Safety
+
+    Throws @ref invalid_part if `s` is not valid
+    UTF-8, or has a label which can not be
+    converted. Calls to allocate may throw.
+
+    @param s The host name to convert.
+
+    @see idna_to_unicode
+*/
+BOOST_URL_DECL
+std::string
+idna_to_ascii(string_view s);
+
+/** Return the ASCII form of an internationalized host name.
+
+    This function behaves as the overload without
+    the error code, except that errors are reported
+    by setting `ec` and returning an empty string.
+
+    @param s The host name to convert.
+
+    @param ec Set to the error, if any occurred.
+*/
+BOOST_URL_DECL
+std::string
+idna_to_ascii(
+    string_view s,
+    error_code& ec);
+
+/** Return the Unicode form of a host name.
+
+    Each label of `s` which begins with `"xn--"`,
+    in any case, is replaced by the UTF-8 string
+    its punycode encodes, as done by the ToUnicode
+    operation of IDNA. The other labels are copied
+    as they are. A string without such labels is
+    returned unchanged, so the result of
+    @ref url_view::encoded_host may be passed
+    directly.
+
+    @par Example
+    @code
+    url_view u( "http://xn--bcher-kva.example/" );
+    assert( idna_to_unicode( u.encoded_host() ) == "b\xc3\xbc" "cher.example" );
+    @endcode
+
+    @par Exception Safety
+
+    Throws @ref invalid_part if a label beginning
+    with `"xn--"` is not valid punycode, or is
+    longer than 63 characters. Calls to allocate
+    may throw.
+
+    @param s The host name to convert.
+
+    @see idna_to_ascii
+*/
+BOOST_URL_DECL
+std::string
+idna_to_unicode(string_view s);
+
+/** Return the Unicode form of a host name.
+
+    This function behaves as the overload without
+    the error code, except that errors are reported
+    by setting `ec` and returning an empty string.
+
+    @param s The host name to convert.
+
+    @param ec Set to the error, if any occurred.
+*/
+BOOST_URL_DECL
+std::string
+idna_to_unicode(
+    string_view s,
+    error_code& ec);
+
+} // urls
+} // boost
+
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/idna.ipp>
+#endif
+
+#endif
@@ -0,0 +1,145 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_DECODED_VIEW_IPP
+#define BOOST_URL_IMPL_DECODED_VIEW_IPP
+
+#include <boost/url/decoded_view.hpp>
+#include <boost/url/detail/hash.hpp>
+#include <ostream>
+
+namespace boost {
+namespace urls {
+
+int
+decoded_view::
+compare(string_view s) const noexcept
+{
+    auto it = begin();
+    auto const last = end();
+    auto p = s.data();
+    auto const p1 = p + s.size();
+    for(;;)
+    {
+        if(it == last)
+            return p == p1 ? 0 : -1;
+        if(p == p1)
+            return 1;
+        auto const c0 =
+            static_cast<unsigned char>(*it);
+        auto const c1 =
+            static_cast<unsigned char>(*p);
+        if(c0 != c1)
+            return c0 < c1 ? -1 : 1;
+        ++it;
+        ++p;
+    }
+}
+
+int
+decoded_view::
+compare(
+    decoded_view const& other) const noexcept
+{
+    // no escapes on either side
+    if( s_.find('%') == string_view::npos)
+        return -other.compare(s_);
+    auto it0 = begin();
+    auto const last0 = end();
+    auto it1 = other.begin();
+    auto const last1 = other.end();
+    for(;;)
+    {
+        if(it0 == last0)
+            return it1 == last1 ? 0 : -1;
+        if(it1 == last1)
+            return 1;
+        auto const c0 =
+            static_cast<unsigned char>(*it0);
+        auto const c1 =
+            static_cast<unsigned char>(*it1);
+        if(c0 != c1)
+            return c0 < c1 ? -1 : 1;
+        ++it0;
+        ++it1;
+    }
+}
+
+bool
+decoded_view::
+starts_with(string_view s) const noexcept
+{
+    if(s_.size() < s.size())
+        return false; // trivial reject
+    auto it = begin();
+    auto const last = end();
+    for(auto c : s)
+    {
+        if(it == last || *it != c)
+            return false;
+        ++it;
+    }
+    return true;
+}
+
+bool
+decoded_view::
+ends_with(string_view s) const noexcept
+{
+    if(s_.size() < s.size())
+        return false; // trivial reject
+    auto it = end();
+    auto const first = begin();
+    auto p = s.data() + s.size();
+    while(p != s.data())
+    {
+        if(it == first)
+            return false;
+        --it;
+        --p;
+        if(*it != *p)
+            return false;
+    }
+    return true;
+}
+
+std::size_t
+decoded_view::
+hash() const noexcept
+{
+    return detail::hash_encoded_key(s_);
+}
+
+std::ostream&
+operator<<(
+    std::ostream& os,
+    decoded_view const& v)
+{
+    // write runs without escapes directly
+    auto p = v.s_.data();
+    auto const p1 = p + v.s_.size();
+    while(p < p1)
+    {
+        auto q = p;
+        while(q < p1 && *q != '%')
+            ++q;
+        os.write(p, q - p);
+        if(q == p1)
+            break;
+        os.put(*decoded_view(
+            string_view(q, 3)).begin());
+        p = q + 3;
+    }
+    return os;
+}
+
+} // urls
+} // boost
+
+#endif
@@ -117,6 +117,18 @@ case error::missing_port: return "missing port";
 case error::bad_pct_encoding_digit: return "bad pct-encoding digit";
 case error::incomplete_pct_encoding: return "incomplete pct-encoding";
 case error::illegal_reserved_char: return "illegal reserved char";
+
+case error::need_more: return "need more";
+
+case error::bad_utf8: return "bad utf8";
+case error::bad_punycode: return "bad punycode";
+case error::bad_idn_char: return "bad idn char";
+case error::label_too_long: return "label too long";
+
+case error::bad_serialized_url: return "bad serialized url";
+case error::unsupported_version: return "unsupported version";
+
+case error::buffer_full: return "buffer full";
             }
         }
 
@@ -146,6 +158,14 @@ case error::missing_port:
 case error::bad_pct_encoding_digit:
 case error::incomplete_pct_encoding:
 case error::illegal_reserved_char:
+
+case error::bad_utf8:
+case error::bad_punycode:
+case error::bad_idn_char:
+case error::label_too_long:
+
+case error::bad_serialized_url:
+case error::unsupported_version:
     return condition::parse_error;
             }
         }
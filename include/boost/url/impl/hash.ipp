@@ -0,0 +1,358 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_HASH_IPP
+#define BOOST_URL_IMPL_HASH_IPP
+
+#include <boost/url/hash.hpp>
+#include <boost/url/decoded_view.hpp>
+#include <boost/url/detail/hash.hpp>
+#include <boost/url/detail/normalize.hpp>
+#include <memory>
+
+namespace boost {
+namespace urls {
+namespace detail {
+
+// Returns true if a segment of the path
+// is "." or "..", possibly encoded
+inline
+bool
+has_dot_segment(string_view s) noexcept
+{
+    if( s.find('.') == string_view::npos &&
+        s.find('%') == string_view::npos)
+        return false;
+    auto p = s.data();
+    auto const end = p + s.size();
+    while(p <= end)
+    {
+        auto q = p;
+        while(q < end && *q != '/')
+            ++q;
+        auto const n = q - p;
+        if(n > 0 && n <= 6)
+        {
+            decoded_view const d(
+                string_view(p, n));
+            if(d == "." || d == "..")
+                return true;
+        }
+        p = q + 1;
+    }
+    return false;
+}
+
+/*  The parts of a URL in the range [first, last)
+    of part ids, as they would be after normalize.
+    Each part is read in place and put in normal
+    form while reading, except a path with dot
+    segments, which is written in normal form to
+    a buffer so that they can be removed.
+*/
+class normal_url
+{
+    struct range
+    {
+        char const* p;
+        char const* end;
+        bool fold;
+    };
+
+    range r_[id_end];
+    std::size_t n_ = 0;
+    std::unique_ptr<char[]> big_;
+    char buf_[512];
+
+    void
+    add(string_view s, bool fold) noexcept
+    {
+        if(s.empty())
+            return;
+        r_[n_++] = { s.data(),
+            s.data() + s.size(), fold };
+    }
+
+    inline
+    void
+    add_path(url_view const& u);
+
+public:
+    inline
+    normal_url(
+        url_view const& u,
+        int first,
+        int last);
+
+    template<class Sink>
+    void
+    write(Sink& s) const noexcept
+    {
+        for(std::size_t i = 0; i < n_; ++i)
+            write_normal(s, r_[i].p,
+                r_[i].end, r_[i].fold);
+    }
+
+    inline
+    bool
+    equal(normal_url const& other) const noexcept;
+};
+
+normal_url::
+normal_url(
+    url_view const& u,
+    int first,
+    int last)
+{
+    auto const& pt = u.pt_;
+    for(int id = first; id < last; ++id)
+    {
+        auto const s = pt.get(id, u.s_);
+        switch(id)
+        {
+        case id_scheme:
+            add(s, true);
+            break;
+
+        case id_host:
+            add(s,
+                pt.host == host_type::name ||
+                pt.host == host_type::ipv6);
+            break;
+
+        case id_port:
+            // an empty or default port is removed
+            if( s.size() == 1 || (
+                pt.port_number != 0 &&
+                pt.port_number == urls::default_port(
+                    pt.scheme_id)))
+                break;
+            add(s, false);
+            break;
+
+        case id_path:
+            add_path(u);
+            break;
+
+        default:
+            add(s, false);
+            break;
+        }
+    }
+}
+
+void
+normal_url::
+add_path(url_view const& u)
+{
+    auto const& pt = u.pt_;
+    auto const s = pt.get(id_path, u.s_);
+    if(s.empty())
+        return;
+    bool const authority =
+        u.has_authority();
+    // as in url_base::normalize
+    bool const dots =
+        pt.length(id_scheme) > 0 ||
+        s.front() == '/';
+    bool const prefix =
+        ! authority &&
+        s.size() > 1 &&
+        s[0] == '/' &&
+        s[1] == '/';
+    if( ! dots || (
+        ! prefix &&
+        ! has_dot_segment(s)))
+    {
+        add(s, false);
+        return;
+    }
+    // the prefix "/." needs two more
+    char* p = buf_;
+    if(s.size() + 2 > sizeof(buf_))
+    {
+        big_.reset(new char[s.size() + 2]);
+        p = big_.get();
+    }
+    buffer_sink b{p};
+    write_normal(b, s.data(),
+        s.data() + s.size(), false);
+    auto n = remove_dot_segments(p, p, b.p);
+    if( n > 1 &&
+        p[0] == '/' &&
+        p[1] == '/' &&
+        ! authority)
+    {
+        std::memmove(p + 2, p, n);
+        p[0] = '/';
+        p[1] = '.';
+        n += 2;
+    }
+    // already in normal
+    // form, which is kept
+    add(string_view(p, n), false);
+}
+
+bool
+normal_url::
+equal(normal_url const& other) const noexcept
+{
+    // reads the parts one after the other
+    struct cursor
+    {
+        normal_url const& u;
+        std::size_t i;
+        normal_reader r;
+
+        explicit
+        cursor(normal_url const& u_) noexcept
+            : u(u_)
+            , i(0)
+            , r(nullptr, nullptr, false)
+        {
+            if(u.n_ > 0)
+                r = normal_reader(u.r_[0].p,
+                    u.r_[0].end, u.r_[0].fold);
+        }
+
+        bool
+        next(char& c) noexcept
+        {
+            while(r.empty())
+            {
+                if(++i >= u.n_)
+                    return false;
+                r = normal_reader(u.r_[i].p,
+                    u.r_[i].end, u.r_[i].fold);
+            }
+            c = r.next();
+            return true;
+        }
+    };
+
+    cursor c0(*this);
+    cursor c1(other);
+    for(;;)
+    {
+        char a = 0;
+        char b = 0;
+        bool const more0 = c0.next(a);
+        bool const more1 = c1.next(b);
+        if(more0 != more1)
+            return false;
+        if(! more0)
+            return true;
+        if(a != b)
+            return false;
+    }
+}
+
+} // detail
+
+std::size_t
+hash_url(url_view const& u)
+{
+    detail::normal_url const n(u,
+        detail::id_scheme,
+        detail::id_end);
+    detail::hash_stream h;
+    n.write(h);
+    return static_cast<
+        std::size_t>(h.finish());
+}
+
+std::size_t
+hash_origin(url_view const& u) noexcept
+{
+    // the origin has no path, so
+    // nothing is ever allocated
+    detail::normal_url const n(u,
+        detail::id_scheme,
+        detail::id_path);
+    detail::hash_stream h;
+    n.write(h);
+    return static_cast<
+        std::size_t>(h.finish());
+}
+
+std::size_t
+hash_path(url_view const& u)
+{
+    detail::normal_url const n(u,
+        detail::id_path,
+        detail::id_query);
+    detail::hash_stream h;
+    n.write(h);
+    return static_cast<
+        std::size_t>(h.finish());
+}
+
+std::size_t
+hash_query_unordered(
+    url_view const& u) noexcept
+{
+    if(u.query_part().empty())
+        return static_cast<std::size_t>(
+            detail::hash_stream().finish());
+    // The sum of the hashes of the
+    // parameters is independent of
+    // their order.
+    std::uint64_t sum = 0;
+    std::uint64_t count = 0;
+    auto const q = u.encoded_query();
+    auto p = q.data();
+    auto const end = p + q.size();
+    for(;;)
+    {
+        auto e = static_cast<char const*>(
+            std::memchr(p, '&', end - p));
+        if(! e)
+            e = end;
+        detail::hash_stream h;
+        detail::write_normal(h, p, e, false);
+        sum += h.finish();
+        ++count;
+        if(e == end)
+            break;
+        p = e + 1;
+    }
+    detail::hash_stream h(1);
+    for(int i = 0; i < 64; i += 8)
+    {
+        h.put(static_cast<char>(sum >> i));
+        h.put(static_cast<char>(count >> i));
+    }
+    return static_cast<
+        std::size_t>(h.finish());
+}
+
+bool
+equivalent(
+    url_view const& u0,
+    url_view const& u1)
+{
+    auto const s0 = u0.encoded_url();
+    auto const s1 = u1.encoded_url();
+    if( s0.size() == s1.size() &&
+        std::memcmp(s0.data(),
+            s1.data(), s0.size()) == 0)
+        return true;
+    detail::normal_url const n0(u0,
+        detail::id_scheme,
+        detail::id_end);
+    detail::normal_url const n1(u1,
+        detail::id_scheme,
+        detail::id_end);
+    return n0.equal(n1);
+}
+
+} // urls
+} // boost
+
+#endif
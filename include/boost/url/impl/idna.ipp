@@ -0,0 +1,663 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_IDNA_IPP
+#define BOOST_URL_IMPL_IDNA_IPP
+
+#include <boost/url/idna.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+namespace detail {
+
+// The parameters of punycode, rfc3492 section 5
+struct punycode
+{
+    static constexpr std::uint32_t base = 36;
+    static constexpr std::uint32_t tmin = 1;
+    static constexpr std::uint32_t tmax = 26;
+    static constexpr std::uint32_t skew = 38;
+    static constexpr std::uint32_t damp = 700;
+    static constexpr std::uint32_t initial_bias = 72;
+    static constexpr std::uint32_t initial_n = 0x80;
+    static constexpr std::uint32_t max =
+        static_cast<std::uint32_t>(-1);
+
+    // returned for an invalid sequence
+    static constexpr std::uint32_t bad =
+        static_cast<std::uint32_t>(-1);
+
+    // the longest label of a host name
+    static constexpr std::size_t max_label = 63;
+
+    static
+    char
+    encode_digit(std::uint32_t d) noexcept
+    {
+        return "abcdefghijklmnopqrstuvwxyz0123456789"[d];
+    }
+
+    // Returns the value of a digit, or
+    // base if c is not a digit. Upper and
+    // lower case letters are the same.
+    static
+    std::uint32_t
+    decode_digit(char c) noexcept
+    {
+        static constexpr unsigned char tab[] =
+            "\x24\x24\x24\x24\x24\x24\x24\x24\x24\x24\x24\x24\x24\x24\x24\x24" //   0...15
+            "\x24\x24\x24\x24\x24\x24\x24\x24\x24\x24\x24\x24\x24\x24\x24\x24" //  16...31
+            "\x24\x24\x24\x24\x24\x24\x24\x24\x24\x24\x24\x24\x24\x24\x24\x24" //  32...47
+            "\x1a\x1b\x1c\x1d\x1e\x1f\x20\x21\x22\x23\x24\x24\x24\x24\x24\x24" //  48...63
+            "\x24\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e" //  64...79
+            "\x0f\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x24\x24\x24\x24\x24" //  80...95
+            "\x24\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0a\x0b\x0c\x0d\x0e" //  96..111
+            "\x0f\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x24\x24\x24\x24\x24" // 112..127
+            ;
+        auto const u = static_cast<
+            unsigned char>(c);
+        if(u > 127)
+            return base;
+        return tab[u];
+    }
+
+    // rfc3492 section 6.1
+    static
+    std::uint32_t
+    adapt(
+        std::uint32_t delta,
+        std::uint32_t n,
+        bool first) noexcept
+    {
+        delta = first ?
+            delta / damp : delta / 2;
+        delta += delta / n;
+        std::uint32_t k = 0;
+        while(delta > ((base - tmin) * tmax) / 2)
+        {
+            delta /= base - tmin;
+            k += base;
+        }
+        return k + (base - tmin + 1) *
+            delta / (delta + skew);
+    }
+
+    static
+    std::uint32_t
+    threshold(
+        std::uint32_t k,
+        std::uint32_t bias) noexcept
+    {
+        if(k <= bias)
+            return tmin;
+        if(k >= bias + tmax)
+            return tmax;
+        return k - bias;
+    }
+};
+
+// Returns the code point at p and moves p
+// past it, or punycode::bad if the bytes
+// are not the shortest UTF-8 sequence of a
+// scalar value.
+inline
+std::uint32_t
+utf8_decode(
+    char const*& p,
+    char const* end) noexcept
+{
+    auto const u = [](char c)
+    {
+        return static_cast<
+            unsigned char>(c);
+    };
+    std::uint32_t c = u(*p);
+    if(c < 0x80)
+    {
+        ++p;
+        return c;
+    }
+    std::size_t n;
+    std::uint32_t least;
+    if(c < 0xc2)
+        return punycode::bad;
+    if(c < 0xe0)
+    {
+        n = 1;
+        least = 0x80;
+        c &= 0x1f;
+    }
+    else if(c < 0xf0)
+    {
+        n = 2;
+        least = 0x800;
+        c &= 0x0f;
+    }
+    else if(c < 0xf5)
+    {
+        n = 3;
+        least = 0x10000;
+        c &= 0x07;
+    }
+    else
+    {
+        return punycode::bad;
+    }
+    if(static_cast<std::size_t>(
+            end - p) <= n)
+        return punycode::bad;
+    for(std::size_t i = 1; i <= n; ++i)
+    {
+        auto const b = u(p[i]);
+        if((b & 0xc0) != 0x80)
+            return punycode::bad;
+        c = (c << 6) | (b & 0x3f);
+    }
+    if( c < least ||
+        c > 0x10ffff ||
+        (c >= 0xd800 && c <= 0xdfff))
+        return punycode::bad;
+    p += n + 1;
+    return c;
+}
+
+inline
+void
+utf8_append(
+    std::string& s,
+    std::uint32_t c)
+{
+    auto const ch = [](std::uint32_t v)
+    {
+        return static_cast<char>(v);
+    };
+    if(c < 0x80)
+    {
+        s.push_back(ch(c));
+    }
+    else if(c < 0x800)
+    {
+        s.push_back(ch(0xc0 | (c >> 6)));
+        s.push_back(ch(0x80 | (c & 0x3f)));
+    }
+    else if(c < 0x10000)
+    {
+        s.push_back(ch(0xe0 | (c >> 12)));
+        s.push_back(ch(0x80 | ((c >> 6) & 0x3f)));
+        s.push_back(ch(0x80 | (c & 0x3f)));
+    }
+    else
+    {
+        s.push_back(ch(0xf0 | (c >> 18)));
+        s.push_back(ch(0x80 | ((c >> 12) & 0x3f)));
+        s.push_back(ch(0x80 | ((c >> 6) & 0x3f)));
+        s.push_back(ch(0x80 | (c & 0x3f)));
+    }
+}
+
+// Returns the simple lowercase form of
+// a code point, for the letters of the
+// Latin, Greek, and Cyrillic blocks which
+// have one uppercase and one lowercase form
+inline
+std::uint32_t
+idna_map(std::uint32_t c) noexcept
+{
+    struct range
+    {
+        std::uint32_t first;
+        std::uint32_t last;
+        std::uint32_t delta;
+    };
+    static constexpr range tab[] = {
+        { 0x0041, 0x005a, 32 },     // A-Z
+        { 0x00c0, 0x00d6, 32 },     // Latin-1
+        { 0x00d8, 0x00de, 32 },
+        { 0x0391, 0x03a1, 32 },     // Greek
+        { 0x03a3, 0x03ab, 32 },
+        { 0x0400, 0x040f, 80 },     // Cyrillic
+        { 0x0410, 0x042f, 32 },
+    };
+    if(c < 0x41 || c > 0x42f)
+        return c;
+    for(auto const& r : tab)
+        if(c >= r.first && c <= r.last)
+            return c + r.delta;
+    return c;
+}
+
+// Returns true if c separates labels
+inline
+bool
+is_label_sep(std::uint32_t c) noexcept
+{
+    return
+        c == '.' ||
+        c == 0x3002 ||      // ideographic full stop
+        c == 0xff0e ||      // fullwidth full stop
+        c == 0xff61;        // halfwidth ideographic full stop
+}
+
+// Append the punycode encoding of the
+// UTF-8 string [first, last), which was
+// checked already, mapping each code
+// point if map is true.
+inline
+void
+punycode_append(
+    std::string& dest,
+    char const* first,
+    char const* last,
+    bool map,
+    error_code& ec)
+{
+    using P = punycode;
+    auto const next = [map](
+        char const*& p, char const* end)
+    {
+        auto const c = utf8_decode(p, end);
+        return map ? idna_map(c) : c;
+    };
+
+    // the basic code points, in order
+    std::uint32_t h = 0;
+    std::uint32_t total = 0;
+    for(auto p = first; p < last;)
+    {
+        auto const c = next(p, last);
+        ++total;
+        if(c < 0x80)
+        {
+            dest.push_back(
+                static_cast<char>(c));
+            ++h;
+        }
+    }
+    auto const b = h;
+    if(b > 0)
+        dest.push_back('-');
+
+    auto n = P::initial_n;
+    std::uint32_t delta = 0;
+    auto bias = P::initial_bias;
+    while(h < total)
+    {
+        // the smallest code point not
+        // yet handled, at least n
+        auto m = P::max;
+        for(auto p = first; p < last;)
+        {
+            auto const c = next(p, last);
+            if(c >= n && c < m)
+                m = c;
+        }
+        if(m - n > (P::max - delta) / (h + 1))
+        {
+            ec = error::bad_punycode;
+            return;
+        }
+        delta += (m - n) * (h + 1);
+        n = m;
+        for(auto p = first; p < last;)
+        {
+            auto const c = next(p, last);
+            if(c < n && ++delta == 0)
+            {
+                ec = error::bad_punycode;
+                return;
+            }
+            if(c != n)
+                continue;
+            auto q = delta;
+            for(auto k = P::base;; k += P::base)
+            {
+                auto const t =
+                    P::threshold(k, bias);
+                if(q < t)
+                    break;
+                dest.push_back(P::encode_digit(
+                    t + (q - t) % (P::base - t)));
+                q = (q - t) / (P::base - t);
+            }
+            dest.push_back(
+                P::encode_digit(q));
+            bias = P::adapt(
+                delta, h + 1, h == b);
+            delta = 0;
+            ++h;
+        }
+        ++delta;
+        ++n;
+    }
+}
+
+// Decode the punycode string s into the code
+// points out[0..n), returning n. Each code
+// point takes at least one character of s,
+// so out must hold s.size() code points.
+inline
+std::size_t
+punycode_decode(
+    string_view s,
+    std::uint32_t* out,
+    error_code& ec) noexcept
+{
+    using P = punycode;
+
+    // the basic code points
+    // precede the last hyphen
+    std::size_t count = 0;
+    std::size_t in = 0;
+    auto const dash = s.rfind('-');
+    if(dash != string_view::npos)
+    {
+        for(std::size_t i = 0;
+            i < dash; ++i)
+        {
+            auto const c = static_cast<
+                unsigned char>(s[i]);
+            if(c >= 0x80)
+            {
+                ec = error::bad_punycode;
+                return 0;
+            }
+            out[count++] = c;
+        }
+        in = dash + 1;
+    }
+
+    auto n = P::initial_n;
+    std::uint32_t i = 0;
+    auto bias = P::initial_bias;
+    while(in < s.size())
+    {
+        auto const oldi = i;
+        std::uint32_t w = 1;
+        for(auto k = P::base;; k += P::base)
+        {
+            if(in >= s.size())
+            {
+                ec = error::bad_punycode;
+                return 0;
+            }
+            auto const d =
+                P::decode_digit(s[in++]);
+            if( d >= P::base ||
+                d > (P::max - i) / w)
+            {
+                ec = error::bad_punycode;
+                return 0;
+            }
+            i += d * w;
+            auto const t =
+                P::threshold(k, bias);
+            if(d < t)
+                break;
+            if(w > P::max / (P::base - t))
+            {
+                ec = error::bad_punycode;
+                return 0;
+            }
+            w *= P::base - t;
+        }
+        auto const len = static_cast<
+            std::uint32_t>(count + 1);
+        bias = P::adapt(
+            i - oldi, len, oldi == 0);
+        if(i / len > P::max - n)
+        {
+            ec = error::bad_punycode;
+            return 0;
+        }
+        n += i / len;
+        i %= len;
+        if( n > 0x10ffff ||
+            (n >= 0xd800 && n <= 0xdfff))
+        {
+            ec = error::bad_punycode;
+            return 0;
+        }
+        for(auto j = count; j > i; --j)
+            out[j] = out[j - 1];
+        out[i++] = n;
+        ++count;
+    }
+    ec = {};
+    return count;
+}
+
+// Returns true if the label is "xn--" in any case
+inline
+bool
+is_ace_prefix(string_view s) noexcept
+{
+    return
+        s.size() >= 4 &&
+        (s[0] | 0x20) == 'x' &&
+        (s[1] | 0x20) == 'n' &&
+        s[2] == '-' &&
+        s[3] == '-';
+}
+
+} // detail
+
+std::string
+punycode_encode(
+    string_view s,
+    error_code& ec)
+{
+    auto const end = s.data() + s.size();
+    for(auto p = s.data(); p < end;)
+    {
+        if(detail::utf8_decode(p, end) ==
+            detail::punycode::bad)
+        {
+            ec = error::bad_utf8;
+            return {};
+        }
+    }
+    std::string r;
+    r.reserve(s.size() + 8);
+    ec = {};
+    detail::punycode_append(
+        r, s.data(), end, false, ec);
+    if(ec)
+        return {};
+    return r;
+}
+
+std::string
+punycode_encode(string_view s)
+{
+    error_code ec;
+    auto r = punycode_encode(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return r;
+}
+
+std::string
+punycode_decode(
+    string_view s,
+    error_code& ec)
+{
+    std::vector<std::uint32_t> v(s.size());
+    auto const n = detail::punycode_decode(
+        s, v.data(), ec);
+    if(ec)
+        return {};
+    std::string r;
+    r.reserve(s.size() * 2);
+    for(std::size_t i = 0; i < n; ++i)
+        detail::utf8_append(r, v[i]);
+    return r;
+}
+
+std::string
+punycode_decode(string_view s)
+{
+    error_code ec;
+    auto r = punycode_decode(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return r;
+}
+
+std::string
+idna_to_ascii(
+    string_view s,
+    error_code& ec)
+{
+    using P = detail::punycode;
+    ec = {};
+    std::string r;
+    r.reserve(s.size() + 16);
+    auto p = s.data();
+    auto const end = p + s.size();
+    for(;;)
+    {
+        // find the end of the label,
+        // and check its characters
+        auto const first = p;
+        auto last = end;
+        bool ascii = true;
+        bool ldh = true;
+        std::uint32_t sep = 0;
+        while(p < end)
+        {
+            auto const q = p;
+            auto c = detail::utf8_decode(p, end);
+            if(c == P::bad)
+            {
+                ec = error::bad_utf8;
+                return {};
+            }
+            if(detail::is_label_sep(c))
+            {
+                last = q;
+                sep = c;
+                break;
+            }
+            c = detail::idna_map(c);
+            if(c >= 0x80)
+            {
+                // C1 controls and no-break space
+                if(c <= 0xa0)
+                    ldh = false;
+                ascii = false;
+            }
+            else if(! (
+                (c >= 'a' && c <= 'z') ||
+                (c >= '0' && c <= '9') ||
+                c == '-'))
+            {
+                ldh = false;
+            }
+        }
+
+        if(ascii)
+        {
+            for(auto it = first; it < last; ++it)
+                r.push_back(static_cast<char>(
+                    detail::idna_map(static_cast<
+                        unsigned char>(*it))));
+        }
+        else
+        {
+            if(! ldh)
+            {
+                ec = error::bad_idn_char;
+                return {};
+            }
+            auto const n = r.size();
+            r.append("xn--", 4);
+            detail::punycode_append(
+                r, first, last, true, ec);
+            if(ec)
+                return {};
+            if(r.size() - n > P::max_label)
+            {
+                ec = error::label_too_long;
+                return {};
+            }
+        }
+        if(sep == 0)
+            break;
+        r.push_back('.');
+    }
+    return r;
+}
+
+std::string
+idna_to_ascii(string_view s)
+{
+    error_code ec;
+    auto r = idna_to_ascii(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return r;
+}
+
+std::string
+idna_to_unicode(
+    string_view s,
+    error_code& ec)
+{
+    using P = detail::punycode;
+    std::string r;
+    r.reserve(s.size() * 2);
+    for(;;)
+    {
+        auto const i = s.find('.');
+        auto const label = s.substr(0, i);
+        if(! detail::is_ace_prefix(label))
+        {
+            r.append(label.data(), label.size());
+        }
+        else
+        {
+            if(label.size() > P::max_label)
+            {
+                ec = error::label_too_long;
+                return {};
+            }
+            std::uint32_t v[P::max_label];
+            auto const n = detail::punycode_decode(
+                label.substr(4), v, ec);
+            if(ec)
+                return {};
+            for(std::size_t j = 0; j < n; ++j)
+                detail::utf8_append(r, v[j]);
+        }
+        if(i == string_view::npos)
+            break;
+        r.push_back('.');
+        s.remove_prefix(i + 1);
+    }
+    ec = {};
+    return r;
+}
+
+std::string
+idna_to_unicode(string_view s)
+{
+    error_code ec;
+    auto r = idna_to_unicode(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return r;
+}
+
+} // urls
+} // boost
+
+#endif
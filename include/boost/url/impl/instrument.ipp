@@ -0,0 +1,39 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_INSTRUMENT_IPP
+#define BOOST_URL_IMPL_INSTRUMENT_IPP
+
+#include <boost/url/instrument.hpp>
+#include <boost/url/detail/instrument.hpp>
+
+namespace boost {
+namespace urls {
+
+instrument_counters
+instrument_snapshot() noexcept
+{
+#ifdef BOOST_URL_INSTRUMENT
+    return detail::counters();
+#else
+    return {};
+#endif
+}
+
+void
+instrument_reset() noexcept
+{
+    BOOST_URL_COUNT(
+        detail::counters() = {});
+}
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,116 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_INTERNED_URL_IPP
+#define BOOST_URL_IMPL_INTERNED_URL_IPP
+
+#include <boost/url/interned_url.hpp>
+
+namespace boost {
+namespace urls {
+
+// copy the path, query, and fragment
+// of u, and point the tail view at them
+void
+interned_url::
+set_tail(url_view const& u)
+{
+    auto const s = u.pt_.get(
+        detail::id_path,
+        detail::id_end,
+        u.s_);
+    t_.assign(s.data(), s.size());
+    auto& pt = tv_.pt_;
+    pt = detail::parts();
+    auto const n0 =
+        u.pt_.offset[detail::id_path];
+    for(int i = detail::id_path + 1;
+            i <= detail::id_end; ++i)
+        pt.offset[i] = u.pt_.offset[i] - n0;
+    pt.nseg = u.pt_.nseg;
+    pt.nparam = u.pt_.nparam;
+    tv_.s_ = t_.data();
+}
+
+interned_url::
+interned_url(
+    url_view const& u,
+    origin_pool& pool)
+{
+    set_tail(u);
+    o_ = pool.intern(u);
+}
+
+interned_url::
+interned_url(
+    interned_url const& other)
+    : o_(other.o_)
+    , t_(other.t_)
+    , tv_(other.tv_)
+{
+    tv_.s_ = t_.data();
+}
+
+interned_url::
+interned_url(
+    interned_url&& other) noexcept
+    : o_(std::move(other.o_))
+    , t_(std::move(other.t_))
+    , tv_(other.tv_)
+{
+    // the characters of a short
+    // string move with the object
+    tv_.s_ = t_.data();
+    other.tv_ = url_view();
+}
+
+interned_url&
+interned_url::
+operator=(interned_url const& other)
+{
+    if(this == &other)
+        return *this;
+    t_ = other.t_;
+    o_ = other.o_;
+    tv_ = other.tv_;
+    tv_.s_ = t_.data();
+    return *this;
+}
+
+interned_url&
+interned_url::
+operator=(interned_url&& other) noexcept
+{
+    if(this == &other)
+        return *this;
+    o_ = std::move(other.o_);
+    t_ = std::move(other.t_);
+    tv_ = other.tv_;
+    tv_.s_ = t_.data();
+    other.tv_ = url_view();
+    return *this;
+}
+
+std::string
+interned_url::
+encoded_url() const
+{
+    auto const o = encoded_origin();
+    auto const t = tv_.encoded_url();
+    std::string s;
+    s.reserve(o.size() + t.size());
+    s.append(o.data(), o.size());
+    s.append(t.data(), t.size());
+    return s;
+}
+
+} // urls
+} // boost
+
+#endif
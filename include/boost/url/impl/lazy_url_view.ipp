@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_LAZY_URL_VIEW_IPP
+#define BOOST_URL_IMPL_LAZY_URL_VIEW_IPP
+
+#include <boost/url/lazy_url_view.hpp>
+#include <boost/url/detail/table_parse.hpp>
+
+namespace boost {
+namespace urls {
+
+void
+lazy_url_view::
+check(
+    int id,
+    error_code& ec) const noexcept
+{
+    unsigned char bit = 0;
+    switch(id)
+    {
+    case detail::id_host:  bit = ok_authority; break;
+    case detail::id_path:  bit = ok_path; break;
+    case detail::id_query: bit = ok_query; break;
+    default:
+        BOOST_ASSERT(id == detail::id_frag);
+        bit = ok_fragment;
+        break;
+    }
+    if(ok_ & bit)
+        return;
+    // the parts change only on success
+    detail::table_parser::parse_part(
+        id, v_.s_, v_.pt_, ec);
+    if(! ec)
+        ok_ |= bit;
+}
+
+url_view const&
+lazy_url_view::
+get(int id) const
+{
+    error_code ec;
+    check(id, ec);
+    if(ec)
+        invalid_part::raise();
+    return v_;
+}
+
+lazy_url_view::
+lazy_url_view(string_view s)
+{
+    error_code ec;
+    detail::find_parts(v_.pt_, s, ec);
+    if(ec)
+        invalid_part::raise();
+    v_.s_ = s.data();
+    ok_ = 0;
+}
+
+url_view
+lazy_url_view::
+validate(error_code& ec) const noexcept
+{
+    ec = {};
+    check(detail::id_host, ec);
+    if(! ec)
+        check(detail::id_path, ec);
+    if(! ec)
+        check(detail::id_query, ec);
+    if(! ec)
+        check(detail::id_frag, ec);
+    if(ec)
+        return url_view();
+    return v_;
+}
+
+url_view
+lazy_url_view::
+validate() const
+{
+    error_code ec;
+    auto const v = validate(ec);
+    if(ec)
+        invalid_part::raise();
+    return v;
+}
+
+} // urls
+} // boost
+
+#endif
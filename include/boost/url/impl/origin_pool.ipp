@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_ORIGIN_POOL_IPP
+#define BOOST_URL_IMPL_ORIGIN_POOL_IPP
+
+#include <boost/url/origin_pool.hpp>
+
+namespace boost {
+namespace urls {
+
+auto
+origin_pool::
+intern(url_view const& u) ->
+    std::shared_ptr<entry const>
+{
+    auto const s = u.encoded_origin();
+    std::lock_guard<std::mutex> lock(m_);
+    auto const it = map_.find(s);
+    if(it != map_.end())
+        return it->second;
+
+    // The entry does not move, so the
+    // key and the view can refer to
+    // the characters which it owns.
+    auto e = std::make_shared<entry>();
+    e->s.assign(s.data(), s.size());
+    auto& pt = e->v.pt_;
+    pt = u.pt_;
+    auto const n = static_cast<
+        detail::parts::size_type>(s.size());
+    for(int i = detail::id_path + 1;
+            i <= detail::id_end; ++i)
+        pt.offset[i] = n;
+    pt.nseg = 0;
+    pt.nparam = 0;
+    e->v.s_ = e->s.data();
+    std::shared_ptr<entry const> ce(std::move(e));
+    map_.emplace(string_view(
+        ce->s.data(), ce->s.size()), ce);
+    return ce;
+}
+
+std::size_t
+origin_pool::
+size() const
+{
+    std::lock_guard<std::mutex> lock(m_);
+    return map_.size();
+}
+
+std::size_t
+origin_pool::
+collect() noexcept
+{
+    std::lock_guard<std::mutex> lock(m_);
+    std::size_t n = 0;
+    auto it = map_.begin();
+    while(it != map_.end())
+    {
+        // new references are only made
+        // while holding the lock
+        if(it->second.use_count() == 1)
+        {
+            it = map_.erase(it);
+            ++n;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return n;
+}
+
+} // urls
+} // boost
+
+#endif
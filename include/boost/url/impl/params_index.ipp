@@ -0,0 +1,107 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_PARAMS_INDEX_IPP
+#define BOOST_URL_IMPL_PARAMS_INDEX_IPP
+
+#include <boost/url/params_index.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/detail/hash.hpp>
+
+namespace boost {
+namespace urls {
+
+params_index::
+params_index(
+    url_view::params_type const& p,
+    slot* buf,
+    std::size_t n)
+    : p_(p)
+    , tab_(buf)
+    , mask_(slots_needed(p.size()) - 1)
+{
+    if(n < mask_ + 1)
+        too_large::raise();
+    for(std::size_t i = 0; i <= mask_; ++i)
+        tab_[i] = { 0, 0 };
+    for(auto it = p_.begin(),
+        last = p_.end(); it != last; ++it)
+    {
+        auto const h = static_cast<
+            std::uint32_t>(detail::hash_encoded_key(
+                it->encoded_key()));
+        auto i = h & mask_;
+        while(tab_[i].off != 0)
+            i = (i + 1) & mask_;
+        tab_[i].hash = h;
+        tab_[i].off = static_cast<
+            std::uint32_t>(it.off_ + 1);
+    }
+}
+
+bool
+params_index::
+contains(string_view key) const noexcept
+{
+    return find(key) != p_.end();
+}
+
+std::size_t
+params_index::
+count(string_view key) const noexcept
+{
+    std::size_t n = 0;
+    auto const h = static_cast<
+        std::uint32_t>(detail::hash_key(key));
+    for(auto i = h & mask_;
+        tab_[i].off != 0;
+        i = (i + 1) & mask_)
+    {
+        if(tab_[i].hash != h)
+            continue;
+        iterator const it(&p_,
+            static_cast<std::size_t>(
+                tab_[i].off) - 1);
+        if(detail::key_equal(
+                it->encoded_key(), key))
+            ++n;
+    }
+    return n;
+}
+
+auto
+params_index::
+find(string_view key) const noexcept ->
+    iterator
+{
+    // Keys with the same hash share a home
+    // slot, so the first match on the probe
+    // sequence is the first in the query.
+    auto const h = static_cast<
+        std::uint32_t>(detail::hash_key(key));
+    for(auto i = h & mask_;
+        tab_[i].off != 0;
+        i = (i + 1) & mask_)
+    {
+        if(tab_[i].hash != h)
+            continue;
+        iterator const it(&p_,
+            static_cast<std::size_t>(
+                tab_[i].off) - 1);
+        if(detail::key_equal(
+                it->encoded_key(), key))
+            return it;
+    }
+    return p_.end();
+}
+
+} // urls
+} // boost
+
+#endif
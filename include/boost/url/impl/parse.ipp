@@ -0,0 +1,141 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_PARSE_IPP
+#define BOOST_URL_IMPL_PARSE_IPP
+
+#include <boost/url/parse.hpp>
+#include <boost/url/detail/instrument.hpp>
+#include <boost/url/detail/parse.hpp>
+#include <boost/url/detail/table_parse.hpp>
+#include <boost/url/detail/validate.hpp>
+
+namespace boost {
+namespace urls {
+
+url_view
+parse_uri(
+    string_view s,
+    error_code& ec) noexcept
+{
+    url_view v;
+    detail::parts pt;
+    ec = {};
+    detail::parse_url(pt, s, ec);
+    BOOST_URL_COUNT(detail::count_parse(ec));
+    if(ec)
+        return v;
+    v.s_ = s.data();
+    v.pt_ = pt;
+    return v;
+}
+
+url_view
+parse_uri(
+    string_view s,
+    parser_kind k,
+    error_code& ec) noexcept
+{
+    url_view v;
+    detail::parts pt;
+    ec = {};
+    if(k == parser_kind::table)
+        detail::parse_url_table(pt, s, ec);
+    else
+        detail::parse_url(pt, s, ec);
+    BOOST_URL_COUNT(detail::count_parse(ec));
+    if(ec)
+        return v;
+    v.s_ = s.data();
+    v.pt_ = pt;
+    return v;
+}
+
+result<url_view>
+parse_uri(
+    string_view s) noexcept
+{
+    error_code ec;
+    auto const v = parse_uri(s, ec);
+    if(ec)
+        return ec;
+    return v;
+}
+
+std::size_t
+validate_url(
+    string_view s,
+    error_code& ec) noexcept
+{
+    ec = {};
+    return detail::validate_url(s, ec);
+}
+
+bool
+is_valid_uri(
+    string_view s) noexcept
+{
+    error_code ec;
+    detail::validate_url(s, ec);
+    return ! ec;
+}
+
+url_view
+parse_request_target(
+    string_view s,
+    error_code& ec) noexcept
+{
+    url_view v;
+    detail::parts pt;
+    ec = {};
+    detail::parse_request_target(pt, s, ec);
+    BOOST_URL_COUNT(detail::count_parse(ec));
+    if(ec)
+        return v;
+    v.s_ = s.data();
+    v.pt_ = pt;
+    return v;
+}
+
+result<url_view>
+parse_request_target(
+    string_view s) noexcept
+{
+    error_code ec;
+    auto const v =
+        parse_request_target(s, ec);
+    if(ec)
+        return ec;
+    return v;
+}
+
+std::size_t
+parse_urls(
+    string_view const* first,
+    string_view const* last,
+    url_view* out,
+    error_code* ec) noexcept
+{
+    std::size_t n = 0;
+    for(;first != last; ++first, ++out)
+    {
+        error_code e;
+        *out = parse_uri(*first, e);
+        if(! e)
+            ++n;
+        if(ec)
+            *ec++ = e;
+    }
+    return n;
+}
+
+} // urls
+} // boost
+
+#endif
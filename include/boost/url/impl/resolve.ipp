@@ -0,0 +1,176 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_RESOLVE_IPP
+#define BOOST_URL_IMPL_RESOLVE_IPP
+
+#include <boost/url/resolve.hpp>
+#include <boost/url/detail/instrument.hpp>
+#include <boost/url/detail/normalize.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+void
+resolve(
+    url_view const& base,
+    url_view const& ref,
+    url_base& dest,
+    error_code& ec)
+{
+    using detail::id_scheme;
+    using detail::id_user;
+    using detail::id_path;
+    using detail::id_query;
+    using detail::id_frag;
+    using detail::id_end;
+
+    ec = {};
+    if(base.pt_.length(id_scheme) == 0)
+    {
+        ec = error::missing_scheme;
+        return;
+    }
+
+    // rfc3986 5.2.2
+    //
+    // Choose the URL each part of the
+    // target comes from. The path is the
+    // concatenation of p0 and p1, whose
+    // dot segments are removed if dots.
+    url_view const* sch = &base;
+    url_view const* auth = &base;
+    url_view const* query = &ref;
+    string_view p0;
+    string_view p1 = ref.encoded_path();
+    bool dots = true;
+    if(ref.pt_.length(id_scheme) > 0)
+    {
+        sch = &ref;
+        auth = &ref;
+    }
+    else if(ref.has_authority())
+    {
+        auth = &ref;
+    }
+    else if(p1.empty())
+    {
+        p1 = base.encoded_path();
+        dots = false;
+        if(ref.pt_.length(id_query) == 0)
+            query = &base;
+    }
+    else if(p1.front() != '/')
+    {
+        // rfc3986 5.2.3
+        auto const bp = base.encoded_path();
+        if( base.has_authority() &&
+            bp.empty())
+            p0 = "/";
+        else
+            p0 = bp.substr(0, bp.rfind('/') + 1);
+    }
+
+    auto const& ps = sch->pt_;
+    auto const& pa = auth->pt_;
+    auto const& pq = query->pt_;
+    auto const& pf = ref.pt_;
+    std::size_t n[id_end] = {};
+    n[id_scheme] = ps.length(id_scheme);
+    for(int id = id_user; id < id_path; ++id)
+        n[id] = pa.length(id);
+    n[id_path] = p0.size() + p1.size();
+    n[id_query] = pq.length(id_query);
+    n[id_frag] = pf.length(id_frag);
+    std::size_t total = 0;
+    for(int id = 0; id < id_end; ++id)
+        total += n[id];
+    if(total > BOOST_URL_MAX_STRING_SIZE)
+        too_large::raise();
+
+    // write
+    auto const s = dest.a_.resize(total);
+    auto p = s;
+    auto const copy = [&p](string_view v)
+    {
+        if(v.empty())
+            return;
+        std::memcpy(p, v.data(), v.size());
+        p += v.size();
+    };
+    copy(ps.get(id_scheme, sch->s_));
+    copy(pa.get(id_user, id_path, auth->s_));
+    auto const path = p;
+    copy(p0);
+    copy(p1);
+    if(dots)
+    {
+        auto np = detail::remove_dot_segments(
+            path, path, p);
+        // A path which would begin with "//"
+        // when there is no authority is
+        // prefixed with "/." to keep it a path.
+        // It could only begin that way if a dot
+        // segment was removed, so it fits.
+        if( np > 1 &&
+            path[0] == '/' &&
+            path[1] == '/' &&
+            n[id_user] == 0)
+        {
+            BOOST_ASSERT(p - (path + np) >= 2);
+            std::memmove(path + 2, path, np);
+            BOOST_URL_COUNT(detail::counters().bytes_moved += np);
+            path[0] = '/';
+            path[1] = '.';
+            np += 2;
+        }
+        n[id_path] = np;
+        p = path + np;
+    }
+    copy(pq.get(id_query, query->s_));
+    copy(pf.get(id_frag, ref.s_));
+    total = p - s;
+    dest.s_ = dest.a_.resize(total);
+
+    detail::parts pt;
+    for(int id = 0; id < id_end; ++id)
+        pt.offset[id + 1] =
+            pt.offset[id] + static_cast<
+                detail::parts::size_type>(n[id]);
+    BOOST_ASSERT(pt.offset[id_end] == total);
+    pt.scheme_id = ps.scheme_id;
+    pt.set_host(pa);
+    pt.port_number = pa.port_number;
+    auto const pv = pt.get(id_path, dest.s_);
+    pt.nseg = pv.empty() ? 0 :
+        static_cast<detail::parts::size_type>(
+            std::count(pv.begin(), pv.end(), '/') +
+            (pv.front() != '/'));
+    pt.nparam = pq.nparam;
+    dest.pt_ = pt;
+}
+
+void
+resolve(
+    url_view const& base,
+    url_view const& ref,
+    url_base& dest)
+{
+    error_code ec;
+    resolve(base, ref, dest, ec);
+    if(ec)
+        invalid_part::raise();
+}
+
+} // urls
+} // boost
+
+#endif
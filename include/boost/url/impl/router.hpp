@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_ROUTER_HPP
+#define BOOST_URL_IMPL_ROUTER_HPP
+
+namespace boost {
+namespace urls {
+
+bool
+router::
+match(
+    url_view const& u,
+    match_results& m) const noexcept
+{
+    return match(u.segments(), m);
+}
+
+template<class Iterator>
+bool
+router::
+match(
+    std::uint32_t k,
+    Iterator it,
+    Iterator end,
+    match_results& m) const noexcept
+{
+    auto const& nd = nodes_[k];
+    if(it == end)
+    {
+        if(nd.route == npos)
+            return false;
+        m.route_ = nd.route;
+        return true;
+    }
+    auto const s = it->encoded_string();
+    auto next = it;
+    ++next;
+
+    // a literal, then a parameter, then *
+    if(nd.nedge > 0)
+    {
+        auto const child =
+            find(nd, decoded_view(s));
+        if( child != npos &&
+            match(child, next, end, m))
+            return true;
+    }
+    if(nd.param != npos)
+    {
+        auto const n = m.n_;
+        m.v_[m.n_++] = s;
+        if(match(nd.param, next, end, m))
+            return true;
+        m.n_ = n;
+    }
+    if(nd.star != npos)
+    {
+        auto p1 = s.data() + s.size();
+        for(; next != end; ++next)
+        {
+            auto const t =
+                next->encoded_string();
+            p1 = t.data() + t.size();
+        }
+        m.v_[m.n_++] = string_view(
+            s.data(), p1 - s.data());
+        m.route_ = nd.star;
+        return true;
+    }
+    return false;
+}
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,372 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_ROUTER_IPP
+#define BOOST_URL_IMPL_ROUTER_IPP
+
+#include <boost/url/router.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/detail/char_type.hpp>
+
+namespace boost {
+namespace urls {
+
+namespace detail {
+
+// one segment of a pattern
+struct route_segment
+{
+    enum kind_type
+    {
+        literal,
+        param,
+        star
+    };
+
+    kind_type kind;
+
+    // the parameter name, or the
+    // decoded literal in the buffer
+    string_view name;
+    std::size_t off;
+    std::size_t len;
+};
+
+// Parse one segment of a pattern, appending
+// the decoded characters of a literal to buf
+inline
+route_segment
+parse_route_segment(
+    string_view s,
+    std::string& buf)
+{
+    route_segment rs{
+        route_segment::literal, {}, 0, 0 };
+    if(s == "*")
+    {
+        rs.kind = route_segment::star;
+        rs.name = "*";
+        return rs;
+    }
+    if( ! s.empty() &&
+        s.front() == '{')
+    {
+        if( s.size() < 3 ||
+            s.back() != '}')
+            invalid_part::raise();
+        rs.kind = route_segment::param;
+        rs.name = s.substr(1, s.size() - 2);
+        for(auto c : rs.name)
+            if(c == '{' || c == '}')
+                invalid_part::raise();
+        return rs;
+    }
+    rs.off = buf.size();
+    auto p = s.data();
+    auto const end = p + s.size();
+    while(p < end)
+    {
+        if(*p == '{' || *p == '}')
+            invalid_part::raise();
+        if(*p != '%')
+        {
+            buf.push_back(*p++);
+            continue;
+        }
+        if( end - p < 3 ||
+            hex_digit(p[1]) == -1 ||
+            hex_digit(p[2]) == -1)
+            invalid_part::raise();
+        buf.push_back(static_cast<char>(
+            (hex_digit(p[1]) << 4) +
+                hex_digit(p[2])));
+        p += 3;
+    }
+    rs.len = buf.size() - rs.off;
+    return rs;
+}
+
+} // detail
+
+router::
+router()
+{
+    // the root
+    nodes_.emplace_back();
+}
+
+std::size_t
+router::
+insert(string_view pattern)
+{
+    // Split and check the pattern
+    // before changing anything
+    std::vector<detail::route_segment> v;
+    std::string buf;
+    std::size_t ncap = 0;
+    std::size_t nkey = 0;
+    if(! pattern.empty())
+    {
+        auto s = pattern;
+        if(s.front() == '/')
+            s.remove_prefix(1);
+        for(;;)
+        {
+            auto const i = s.find('/');
+            v.push_back(detail::parse_route_segment(
+                s.substr(0, i), buf));
+            if(v.back().kind !=
+                detail::route_segment::literal)
+            {
+                ++ncap;
+                nkey += v.back().name.size();
+            }
+            if(i == string_view::npos)
+                break;
+            if(v.back().kind ==
+                detail::route_segment::star)
+                invalid_part::raise();
+            s.remove_prefix(i + 1);
+        }
+    }
+    if(ncap > max_captures)
+        too_large::raise();
+
+    // a route which matches the same
+    // paths must not exist already
+    {
+        auto k = std::uint32_t(0);
+        bool found = true;
+        for(auto const& rs : v)
+        {
+            auto const& nd = nodes_[k];
+            if(rs.kind ==
+                detail::route_segment::star)
+            {
+                found = nd.star != npos;
+                break;
+            }
+            if(rs.kind ==
+                detail::route_segment::param)
+            {
+                k = nd.param;
+            }
+            else
+            {
+                auto const key = string_view(
+                    buf.data() + rs.off, rs.len);
+                auto const i = lower_bound(nd, key);
+                k = (i < nd.edge + nd.nedge &&
+                    key_of(edges_[i]) == key) ?
+                        edges_[i].child : npos;
+            }
+            if(k == npos)
+            {
+                found = false;
+                break;
+            }
+        }
+        if(found && (v.empty() || v.back().kind !=
+                detail::route_segment::star))
+            found = nodes_[k].route != npos;
+        if(found)
+            invalid_part::raise();
+    }
+
+    // Nothing below allocates, so a
+    // failure leaves the router as it was
+    nodes_.reserve(nodes_.size() + v.size());
+    edges_.reserve(edges_.size() + v.size());
+    keys_.reserve(keys_.size() + buf.size() + nkey);
+    names_.reserve(names_.size() + ncap);
+    routes_.reserve(routes_.size() + 1);
+
+    auto const id = static_cast<
+        std::uint32_t>(routes_.size());
+    routes_.push_back({ static_cast<
+        std::uint32_t>(names_.size()),
+        static_cast<std::uint32_t>(ncap) });
+    auto k = std::uint32_t(0);
+    for(auto const& rs : v)
+    {
+        if(rs.kind ==
+            detail::route_segment::literal)
+        {
+            k = literal(k, string_view(
+                buf.data() + rs.off, rs.len));
+            continue;
+        }
+        names_.emplace_back(
+            static_cast<std::uint32_t>(keys_.size()),
+            static_cast<std::uint32_t>(rs.name.size()));
+        keys_.append(rs.name.data(), rs.name.size());
+        if(rs.kind ==
+            detail::route_segment::star)
+        {
+            nodes_[k].star = id;
+            return id;
+        }
+        if(nodes_[k].param == npos)
+        {
+            nodes_[k].param = static_cast<
+                std::uint32_t>(nodes_.size());
+            nodes_.emplace_back();
+        }
+        k = nodes_[k].param;
+    }
+    nodes_[k].route = id;
+    return id;
+}
+
+bool
+router::
+match(
+    url_view::segments_type const& segs,
+    match_results& m) const noexcept
+{
+    m.r_ = this;
+    m.n_ = 0;
+    if(match(0, segs.begin(), segs.end(), m))
+        return true;
+    m.n_ = 0;
+    return false;
+}
+
+bool
+router::
+match(
+    url_base::segments_type const& segs,
+    match_results& m) const noexcept
+{
+    m.r_ = this;
+    m.n_ = 0;
+    if(match(0, segs.begin(), segs.end(), m))
+        return true;
+    m.n_ = 0;
+    return false;
+}
+
+string_view
+router::
+key_of(edge const& e) const noexcept
+{
+    return string_view(
+        keys_.data() + e.key, e.len);
+}
+
+std::uint32_t
+router::
+lower_bound(
+    node const& nd,
+    string_view key) const noexcept
+{
+    auto lo = nd.edge;
+    auto hi = nd.edge + nd.nedge;
+    while(lo < hi)
+    {
+        auto const mid = lo + (hi - lo) / 2;
+        if(key_of(edges_[mid]).compare(key) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+// Returns the child of node k for a literal,
+// adding it if necessary. Edges of each node
+// are contiguous and sorted by key.
+std::uint32_t
+router::
+literal(
+    std::uint32_t k,
+    string_view key)
+{
+    auto const i = lower_bound(nodes_[k], key);
+    if( i < nodes_[k].edge + nodes_[k].nedge &&
+        key_of(edges_[i]) == key)
+        return edges_[i].child;
+    auto const child = static_cast<
+        std::uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+    edge const e{
+        static_cast<std::uint32_t>(keys_.size()),
+        static_cast<std::uint32_t>(key.size()),
+        child };
+    keys_.append(key.data(), key.size());
+    auto& nd = nodes_[k];
+    if(nd.nedge == 0)
+    {
+        nd.edge = static_cast<
+            std::uint32_t>(edges_.size());
+        edges_.push_back(e);
+    }
+    else
+    {
+        edges_.insert(edges_.begin() + i, e);
+        // the edges of the nodes
+        // after this one moved up
+        for(std::size_t j = 0;
+            j < nodes_.size(); ++j)
+            if( j != k &&
+                nodes_[j].nedge > 0 &&
+                nodes_[j].edge >= i)
+                ++nodes_[j].edge;
+    }
+    ++nd.nedge;
+    return child;
+}
+
+std::uint32_t
+router::
+find(
+    node const& nd,
+    decoded_view s) const noexcept
+{
+    auto lo = nd.edge;
+    auto hi = nd.edge + nd.nedge;
+    while(lo < hi)
+    {
+        auto const mid = lo + (hi - lo) / 2;
+        auto const r = s.compare(
+            key_of(edges_[mid]));
+        if(r == 0)
+            return edges_[mid].child;
+        if(r < 0)
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    return npos;
+}
+
+//----------------------------------------------------------
+
+string_view
+router::
+match_results::
+operator[](string_view name) const noexcept
+{
+    if(! r_)
+        return {};
+    auto const& ri = r_->routes_[route_];
+    for(std::size_t i = 0; i < ri.nname; ++i)
+    {
+        auto const& nm = r_->names_[ri.name + i];
+        if(string_view(r_->keys_.data() +
+                nm.first, nm.second) == name)
+            return v_[i];
+    }
+    return {};
+}
+
+} // urls
+} // boost
+
+#endif
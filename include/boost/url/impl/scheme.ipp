@@ -11,98 +11,323 @@
 #define BOOST_URL_IMPL_SCHEME_IPP
 
 #include <boost/url/scheme.hpp>
+#include <boost/url/error.hpp>
 #include <boost/url/detail/char_type.hpp>
+#include <cstdint>
+#include <cstring>
 
 namespace boost {
 namespace urls {
 
-scheme
-string_to_scheme(
-    string_view s) noexcept
+namespace detail {
+
+/*  The known schemes
+
+    Each name of up to eight characters is read
+    as a little-endian word, with every byte or'ed
+    with 0x20. This folds the case of the letters
+    and leaves the digits, '+', '-', and '.' as
+    they are, so the word is the key of the name
+    in any case. The key is multiplied by mult and
+    the top byte of the product is its slot. The
+    multiplier is chosen so that no two keys have
+    the same slot, so a lookup reads one slot and
+    makes one comparison.
+*/
+class scheme_table
 {
-    using detail::to_lower;
+public:
+    static constexpr std::size_t nslot = 256;
+    static constexpr std::size_t max_added = 32;
+    static constexpr std::size_t nid =
+        static_cast<std::size_t>(
+            scheme::wss) + 1 + max_added;
+
+    // a multiplier which separates the
+    // special schemes, checked below
+    static constexpr std::uint64_t builtin_mult =
+        0x9E3779B97F4A7C15ULL;
+
+    static
+    constexpr
+    std::uint64_t
+    key_of(
+        char const* s,
+        std::size_t i = 0) noexcept
+    {
+        return s[i] == 0 ? 0 : (
+            static_cast<std::uint64_t>(
+                static_cast<unsigned char>(
+                    s[i]) | 0x20) << (8 * i)) |
+            key_of(s, i + 1);
+    }
+
+    static
+    constexpr
+    std::size_t
+    slot_of(
+        std::uint64_t key,
+        std::uint64_t mult) noexcept
+    {
+        return static_cast<std::size_t>(
+            (key * mult) >> 56);
+    }
+
+    // Returns the key of s, or 0 if s is
+    // empty, too long, or has a control
+    // character which would fold into a
+    // character of a scheme
+    static
+    std::uint64_t
+    key_of(string_view s) noexcept
+    {
+        constexpr std::uint64_t lo =
+            0x0101010101010101ULL;
+        auto const n = s.size();
+        if(n - 1 >= 8)
+            return 0;
+        unsigned char b[8] = {};
+        std::memcpy(b, s.data(), n);
+        std::uint64_t const w =
+            static_cast<std::uint64_t>(b[0]) |
+            static_cast<std::uint64_t>(b[1]) << 8 |
+            static_cast<std::uint64_t>(b[2]) << 16 |
+            static_cast<std::uint64_t>(b[3]) << 24 |
+            static_cast<std::uint64_t>(b[4]) << 32 |
+            static_cast<std::uint64_t>(b[5]) << 40 |
+            static_cast<std::uint64_t>(b[6]) << 48 |
+            static_cast<std::uint64_t>(b[7]) << 56;
+        // the bytes of the string
+        auto const used = n == 8 ?
+            ~std::uint64_t(0) :
+            (std::uint64_t(1) << (8 * n)) - 1;
+        // any byte below 0x20, with the
+        // padding set to 0x20
+        auto const t = w | (~used & (lo * 0x20));
+        if(((t - lo * 0x20) & ~t & (lo * 0x80)) != 0)
+            return 0;
+        return w | (used & (lo * 0x20));
+    }
+
+    std::uint64_t mult = builtin_mult;
+    std::uint64_t key[nslot] = {};
+    unsigned char id[nslot] = {};
+
+    // by id; port has an entry for every
+    // value of scheme, so it needs no check
+    char name[nid][8] = {};
+    unsigned char len[nid] = {};
+    std::uint16_t port[256] = {};
+    std::size_t count = 0;
+
+    scheme_table() noexcept
+    {
+        add("ftp", 21);
+        add("file", 0);
+        add("http", 80);
+        add("https", 443);
+        add("ws", 80);
+        add("wss", 443);
+    }
+
+    unsigned char
+    find(std::uint64_t k) const noexcept
+    {
+        auto const i = slot_of(k, mult);
+        return key[i] == k ? id[i] : 0;
+    }
+
+    // Returns false if another multiplier
+    // is needed to keep the hash perfect
+    bool
+    place(
+        std::uint64_t k,
+        unsigned char v) noexcept
+    {
+        auto const i = slot_of(k, mult);
+        if(key[i] != 0)
+            return false;
+        key[i] = k;
+        id[i] = v;
+        return true;
+    }
+
+    void
+    add(
+        char const* s,
+        std::uint16_t p) noexcept
+    {
+        auto const n = std::strlen(s);
+        auto const v = static_cast<
+            unsigned char>(++count);
+        std::memcpy(name[v], s, n);
+        len[v] = static_cast<unsigned char>(n);
+        port[v] = p;
+        auto const ok = place(key_of(
+            string_view(s, n)), v);
+        BOOST_ASSERT(ok);
+        (void)ok;
+    }
 
-    switch(s.size())
+    // Find a multiplier which places every
+    // key in its own slot, including k
+    bool
+    rehash(
+        std::uint64_t k,
+        unsigned char v) noexcept
     {
-    case 2: // ws
-        if( tolower(s[0]) == 'w' &&
-            tolower(s[1]) == 's')
-            return scheme::ws;
-        break;
-
-    case 3:
-        switch(tolower(s[0]))
+        std::uint64_t keys[nid];
+        unsigned char ids[nid];
+        std::size_t n = 0;
+        for(std::size_t i = 0; i < nslot; ++i)
         {
-        case 'w': // wss
-            if( tolower(s[1]) == 's' &&
-                tolower(s[2]) == 's')
-                return scheme::wss;
-            break;
-
-        case 'f': // ftp
-            if( tolower(s[1]) == 't' &&
-                tolower(s[2]) == 'p')
-                return scheme::ftp;
-            break;
-
-        default:
-            break;
+            if(key[i] == 0)
+                continue;
+            keys[n] = key[i];
+            ids[n++] = id[i];
         }
-        break;
+        keys[n] = k;
+        ids[n++] = v;
 
-    case 4:
-        switch(tolower(s[0]))
+        // the multipliers are tried in the
+        // same order on every platform
+        auto m = mult;
+        for(int tries = 0; tries < 100000; ++tries)
         {
-        case 'f': // file
-            if( tolower(s[1]) == 'i' &&
-                tolower(s[2]) == 'l' &&
-                tolower(s[3]) == 'e')
-                return scheme::file;
-            break;
-
-        case 'h': // http
-            if( tolower(s[1]) == 't' &&
-                tolower(s[2]) == 't' &&
-                tolower(s[3]) == 'p')
-                return scheme::http;
-            break;
-
-        default:
-            break;
+            // splitmix64
+            m += 0x9E3779B97F4A7C15ULL;
+            auto z = m;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            z = (z ^ (z >> 31)) | 1;
+            unsigned char used[nslot] = {};
+            std::size_t i = 0;
+            for(; i < n; ++i)
+            {
+                auto const j = slot_of(keys[i], z);
+                if(used[j])
+                    break;
+                used[j] = 1;
+            }
+            if(i < n)
+                continue;
+            mult = z;
+            std::memset(key, 0, sizeof(key));
+            std::memset(id, 0, sizeof(id));
+            for(i = 0; i < n; ++i)
+                place(keys[i], ids[i]);
+            return true;
         }
-        break;
-
-    case 5: // https
-        if( tolower(s[0]) == 'h' &&
-            tolower(s[1]) == 't' &&
-            tolower(s[2]) == 't' &&
-            tolower(s[3]) == 'p' &&
-            tolower(s[4]) == 's')
-            return scheme::https;
-        break;
-
-    default:
-        break;
+        return false;
     }
-    return scheme::unknown;
+};
+
+constexpr bool
+builtin_distinct(
+    char const* const* names,
+    std::size_t i,
+    std::size_t j) noexcept
+{
+    return names[i] == nullptr ? true :
+        names[j] == nullptr ?
+            builtin_distinct(names, i + 1, i + 2) :
+        scheme_table::slot_of(
+            scheme_table::key_of(names[i]),
+            scheme_table::builtin_mult) !=
+        scheme_table::slot_of(
+            scheme_table::key_of(names[j]),
+            scheme_table::builtin_mult) &&
+        builtin_distinct(names, i, j + 1);
+}
+
+constexpr char const* builtin_schemes[] = {
+    "ftp", "file", "http", "https", "ws", "wss",
+    nullptr, nullptr };
+
+static_assert(builtin_distinct(
+    builtin_schemes, 0, 1),
+    "builtin_mult must separate the special schemes");
+
+inline
+scheme_table&
+schemes() noexcept
+{
+    static scheme_table t;
+    return t;
+}
+
+} // detail
+
+scheme
+string_to_scheme(
+    string_view s) noexcept
+{
+    return static_cast<scheme>(
+        detail::schemes().find(
+            detail::scheme_table::key_of(s)));
 }
 
 string_view
 to_string(scheme s) noexcept
 {
-    switch(s)
+    auto const& t = detail::schemes();
+    auto const i = static_cast<
+        std::size_t>(s);
+    if( i == 0 ||
+        i > t.count)
+        return "<unknown>";
+    return string_view(
+        t.name[i], t.len[i]);
+}
+
+std::uint16_t
+default_port(scheme s) noexcept
+{
+    // unknown and unused ids have port 0
+    return detail::schemes().port[
+        static_cast<unsigned char>(s)];
+}
+
+scheme
+register_scheme(
+    string_view name,
+    std::uint16_t port)
+{
+    using T = detail::scheme_table;
+    auto& t = detail::schemes();
+    if( name.empty() ||
+        name.size() > 8 ||
+        ! detail::is_alpha(name[0]))
+        invalid_part::raise();
+    for(auto c : name)
+        if(! detail::is_scheme_char(c))
+            invalid_part::raise();
+    auto const k = T::key_of(name);
+    BOOST_ASSERT(k != 0);
+    auto const v = t.find(k);
+    if(v != 0)
     {
-    case scheme::ftp:   return "ftp";
-    case scheme::file:  return "file";
-    case scheme::http:  return "http";
-    case scheme::https: return "https";
-    case scheme::ws:    return "ws";
-    case scheme::wss:   return "wss";
-
-    default:
-        break;
+        if( is_special(static_cast<scheme>(v)) ||
+            t.port[v] != port)
+            invalid_part::raise();
+        return static_cast<scheme>(v);
     }
-    return "<unknown>";
+    if(t.count + 1 >= T::nid)
+        too_large::raise();
+    auto const id = static_cast<
+        unsigned char>(t.count + 1);
+    if( ! t.place(k, id) &&
+        ! t.rehash(k, id))
+        too_large::raise();
+    // the name is stored in lower case
+    for(std::size_t i = 0; i < name.size(); ++i)
+        t.name[id][i] = static_cast<char>(
+            (k >> (8 * i)) & 0xff);
+    t.len[id] = static_cast<
+        unsigned char>(name.size());
+    t.port[id] = port;
+    ++t.count;
+    return static_cast<scheme>(id);
 }
 
 } // urls
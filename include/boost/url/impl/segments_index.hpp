@@ -0,0 +1,35 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_SEGMENTS_INDEX_HPP
+#define BOOST_URL_IMPL_SEGMENTS_INDEX_HPP
+
+namespace boost {
+namespace urls {
+
+auto
+segments_index::
+begin() const noexcept ->
+    iterator
+{
+    return iterator(this, 0);
+}
+
+auto
+segments_index::
+end() const noexcept ->
+    iterator
+{
+    return iterator(this, size());
+}
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_SEGMENTS_INDEX_IPP
+#define BOOST_URL_IMPL_SEGMENTS_INDEX_IPP
+
+#include <boost/url/segments_index.hpp>
+
+namespace boost {
+namespace urls {
+
+segments_index::
+segments_index(url_base& u)
+    : v_(&u)
+{
+    rebuild();
+}
+
+void
+segments_index::
+rebuild()
+{
+    auto const s = v_->encoded_path();
+    off_.v.clear();
+    off_.v.reserve(v_->pt_.nseg + 1);
+    for(std::size_t i = 0;
+        i < s.size(); ++i)
+    {
+        // a segment starts at the beginning
+        // of the path and at each separator
+        if(i == 0 || s[i] == '/')
+            off_.v.push_back(static_cast<
+                std::uint32_t>(i));
+    }
+    off_.v.push_back(static_cast<
+        std::uint32_t>(s.size()));
+    BOOST_ASSERT(size() == v_->pt_.nseg);
+}
+
+auto
+segments_index::
+operator[](std::size_t i) const noexcept ->
+    value_type
+{
+    BOOST_ASSERT(i < size());
+    string_view s = {
+        v_->s_ + path_offset() + off_.v[i],
+        static_cast<std::size_t>(
+            off_.v[i + 1] - off_.v[i]) };
+    if(! s.empty() &&
+        s.front() == '/')
+        s.remove_prefix(1);
+    return value_type(s);
+}
+
+auto
+segments_index::
+iterator::
+base() const noexcept ->
+    url_base::segments_type::iterator
+{
+    BOOST_ASSERT(i_ <= idx_->size());
+    auto const& v = idx_->off_.v;
+    return url_base::segments_type::iterator(
+        idx_->v_,
+        idx_->path_offset() + v[i_],
+        i_ < idx_->size() ?
+            v[i_ + 1] - v[i_] : 0);
+}
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,499 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_SERIALIZE_IPP
+#define BOOST_URL_IMPL_SERIALIZE_IPP
+
+#include <boost/url/serialize.hpp>
+#include <boost/url/scheme.hpp>
+#include <boost/url/detail/char_type.hpp>
+#include <boost/url/detail/parts.hpp>
+#include <cstdint>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+namespace detail {
+
+/*  The layout of a record:
+
+    varint      size of the encoded URL
+    varint[7]   lengths of the scheme, user,
+                password, host, port, path,
+                and query parts; the fragment
+                is the rest
+    byte        host type
+    byte        special scheme, or 0 for
+                any other scheme
+    varint      number of segments
+    varint      number of params
+    varint      port number
+    byte[4|16]  address, if ipv4 or ipv6
+    byte[size]  the encoded URL
+    byte[4]     check value of the bytes
+                above, little-endian
+*/
+struct serial
+{
+    // the parts with a stored length
+    static constexpr int nlen = id_frag;
+
+    // the size of the check value
+    static constexpr std::size_t ncheck = 4;
+
+    static
+    std::size_t
+    varint_size(std::uint32_t v) noexcept
+    {
+        std::size_t n = 1;
+        while(v >= 0x80)
+        {
+            v >>= 7;
+            ++n;
+        }
+        return n;
+    }
+
+    static
+    char*
+    put(char* p, std::uint32_t v) noexcept
+    {
+        while(v >= 0x80)
+        {
+            *p++ = static_cast<char>(
+                (v & 0x7f) | 0x80);
+            v >>= 7;
+        }
+        *p++ = static_cast<char>(v);
+        return p;
+    }
+
+    // Returns need_more if the buffer ends,
+    // or bad_serialized_url if the value
+    // does not fit in 32 bits
+    static
+    error
+    get(
+        char const*& p,
+        char const* end,
+        std::uint32_t& v) noexcept
+    {
+        // most values fit in one byte
+        if( p != end &&
+            static_cast<unsigned char>(
+                *p) < 0x80)
+        {
+            v = static_cast<
+                unsigned char>(*p++);
+            return {};
+        }
+        v = 0;
+        for(unsigned shift = 0;; shift += 7)
+        {
+            if(p == end)
+                return error::need_more;
+            auto const b = static_cast<
+                unsigned char>(*p++);
+            if( shift == 28 &&
+                b > 0x0f)
+                return error::bad_serialized_url;
+            v |= static_cast<std::uint32_t>(
+                b & 0x7f) << shift;
+            if(b < 0x80)
+                return {};
+        }
+    }
+
+    static
+    std::size_t
+    ip_size(host_type t) noexcept
+    {
+        if(t == host_type::ipv4)
+            return 4;
+        if(t == host_type::ipv6)
+            return 16;
+        return 0;
+    }
+
+    // A check value for finding corrupt
+    // records, not a hash for lookups: the
+    // record is mixed eight bytes at a time,
+    // read little-endian.
+    static
+    std::uint32_t
+    check(
+        char const* p,
+        std::size_t n) noexcept
+    {
+        constexpr std::uint64_t k =
+            0x9E3779B185EBCA87ULL;
+        auto const load = [](
+            unsigned char const* q)
+        {
+            return
+                static_cast<std::uint64_t>(q[0]) |
+                static_cast<std::uint64_t>(q[1]) << 8 |
+                static_cast<std::uint64_t>(q[2]) << 16 |
+                static_cast<std::uint64_t>(q[3]) << 24 |
+                static_cast<std::uint64_t>(q[4]) << 32 |
+                static_cast<std::uint64_t>(q[5]) << 40 |
+                static_cast<std::uint64_t>(q[6]) << 48 |
+                static_cast<std::uint64_t>(q[7]) << 56;
+        };
+        auto u = reinterpret_cast<
+            unsigned char const*>(p);
+        std::uint64_t h = n * k;
+        for(; n >= 8; u += 8, n -= 8)
+        {
+            h ^= load(u);
+            h *= k;
+            h ^= h >> 29;
+        }
+        unsigned char tail[8] = {};
+        std::memcpy(tail, u, n);
+        h ^= load(tail);
+        h *= k;
+        h ^= h >> 32;
+        h *= k;
+        return static_cast<
+            std::uint32_t>(h >> 32);
+    }
+
+    // Returns true if the delimiters which
+    // begin or end each part are in place
+    static
+    bool
+    valid(
+        parts const& pt,
+        char const* s) noexcept
+    {
+        auto const part = [&](int id)
+        {
+            return pt.get(id, s);
+        };
+        auto const scheme = part(id_scheme);
+        if( ! scheme.empty() &&
+            scheme.back() != ':')
+            return false;
+        auto const user = part(id_user);
+        if(user.empty())
+        {
+            // no authority
+            if(pt.length(id_user, id_path) != 0)
+                return false;
+        }
+        else if(user.size() < 2 ||
+            user[0] != '/' || user[1] != '/')
+        {
+            return false;
+        }
+        auto const pass = part(id_password);
+        if( ! pass.empty() && (
+            pass.back() != '@' || (
+                pass.size() > 1 &&
+                pass.front() != ':')))
+            return false;
+        auto const port = part(id_port);
+        if( ! port.empty() &&
+            port.front() != ':')
+            return false;
+        auto const query = part(id_query);
+        if( ! query.empty() &&
+            query.front() != '?')
+            return false;
+        auto const frag = part(id_frag);
+        if( ! frag.empty() &&
+            frag.front() != '#')
+            return false;
+        if( pt.nseg > pt.length(id_path) ||
+            pt.nparam > pt.length(id_query))
+            return false;
+        return true;
+    }
+
+    // Returns true if every '%' in s begins
+    // an escape of two hex digits within s
+    static
+    bool
+    escapes(string_view s) noexcept
+    {
+        auto p = s.data();
+        auto const end = p + s.size();
+        while(p != end)
+        {
+            p = static_cast<char const*>(
+                std::memchr(p, '%', end - p));
+            if(! p)
+                break;
+            if( end - p < 3 ||
+                hex_digit(p[1]) == -1 ||
+                hex_digit(p[2]) == -1)
+                return false;
+            p += 3;
+        }
+        return true;
+    }
+};
+
+} // detail
+
+void
+serialize_header(std::string& dest)
+{
+    dest.append("\x89URL", 4);
+    dest.push_back(static_cast<char>(
+        serialized_url_version));
+}
+
+void
+deserialize_header(
+    string_view& buf,
+    error_code& ec) noexcept
+{
+    if(buf.size() < 5)
+    {
+        if(string_view("\x89URL", 4).substr(
+                0, buf.size()) == buf)
+            ec = error::need_more;
+        else
+            ec = error::bad_serialized_url;
+        return;
+    }
+    if(buf.substr(0, 4) != string_view("\x89URL", 4))
+    {
+        ec = error::bad_serialized_url;
+        return;
+    }
+    if(static_cast<unsigned char>(buf[4]) !=
+        serialized_url_version)
+    {
+        ec = error::unsupported_version;
+        return;
+    }
+    buf.remove_prefix(5);
+    ec = {};
+}
+
+std::size_t
+serialized_size(
+    url_view const& u) noexcept
+{
+    using S = detail::serial;
+    auto const& pt = u.pt_;
+    auto n = S::varint_size(pt.offset[
+        detail::id_end]);
+    for(int id = 0; id < S::nlen; ++id)
+        n += S::varint_size(static_cast<
+            std::uint32_t>(pt.length(id)));
+    n += 2;
+    n += S::varint_size(pt.nseg);
+    n += S::varint_size(pt.nparam);
+    n += S::varint_size(pt.port_number);
+    n += S::ip_size(pt.host);
+    n += pt.offset[detail::id_end];
+    n += S::ncheck;
+    return n;
+}
+
+char*
+serialize_url(
+    url_view const& u,
+    char* dest) noexcept
+{
+    using S = detail::serial;
+    auto const& pt = u.pt_;
+    auto p = S::put(dest, pt.offset[
+        detail::id_end]);
+    for(int id = 0; id < S::nlen; ++id)
+        p = S::put(p, static_cast<
+            std::uint32_t>(pt.length(id)));
+    *p++ = static_cast<char>(pt.host);
+    // schemes added by register_scheme may
+    // have other ids in another process
+    *p++ = is_special(pt.scheme_id) ?
+        static_cast<char>(pt.scheme_id) : 0;
+    p = S::put(p, pt.nseg);
+    p = S::put(p, pt.nparam);
+    p = S::put(p, pt.port_number);
+    auto const nip = S::ip_size(pt.host);
+    if(nip > 0)
+    {
+        std::memcpy(p, pt.ip, nip);
+        p += nip;
+    }
+    auto const n = pt.offset[
+        detail::id_end];
+    if(n > 0)
+    {
+        std::memcpy(p, u.s_, n);
+        p += n;
+    }
+    auto c = S::check(dest, p - dest);
+    for(std::size_t i = 0; i < S::ncheck; ++i)
+    {
+        *p++ = static_cast<char>(c & 0xff);
+        c >>= 8;
+    }
+    return p;
+}
+
+void
+serialize_url(
+    url_view const& u,
+    std::string& dest)
+{
+    auto const n0 = dest.size();
+    dest.resize(n0 + serialized_size(u));
+    auto const end = serialize_url(
+        u, &dest[n0]);
+    BOOST_ASSERT(end ==
+        dest.data() + dest.size());
+    (void)end;
+}
+
+url_view
+deserialize_url(
+    string_view& buf,
+    error_code& ec) noexcept
+{
+    using S = detail::serial;
+    auto const begin = buf.data();
+    auto const end = begin + buf.size();
+    auto p = begin;
+    auto const fail = [&ec](error e)
+    {
+        ec = e;
+        return url_view();
+    };
+
+    std::uint32_t n;
+    std::uint32_t len[S::nlen];
+    std::uint32_t nseg;
+    std::uint32_t nparam;
+    std::uint32_t port;
+    error e = S::get(p, end, n);
+    for(int id = 0; id < S::nlen; ++id)
+        if(e == error{})
+            e = S::get(p, end, len[id]);
+    if(e != error{})
+        return fail(e);
+    if(end - p < 2)
+        return fail(error::need_more);
+    auto const ht = static_cast<
+        unsigned char>(*p++);
+    auto const sid = static_cast<
+        unsigned char>(*p++);
+    e = S::get(p, end, nseg);
+    if(e == error{})
+        e = S::get(p, end, nparam);
+    if(e == error{})
+        e = S::get(p, end, port);
+    if(e != error{})
+        return fail(e);
+    if( ht > static_cast<unsigned char>(
+            host_type::ipvfuture) ||
+        sid > static_cast<unsigned char>(
+            urls::scheme::wss) ||
+        port > 65535 ||
+        n > BOOST_URL_MAX_STRING_SIZE)
+        return fail(error::bad_serialized_url);
+
+    detail::parts pt;
+    pt.host = static_cast<host_type>(ht);
+    pt.scheme_id = static_cast<
+        urls::scheme>(sid);
+    auto const nip = S::ip_size(pt.host);
+    if(static_cast<std::size_t>(end - p) <
+            nip + n + S::ncheck)
+        return fail(error::need_more);
+    std::memcpy(pt.ip, p, nip);
+    p += nip;
+    auto const s = p;
+    p += n;
+
+    // the check value
+    std::uint32_t c = 0;
+    for(std::size_t i = S::ncheck; i-- > 0;)
+        c = (c << 8) | static_cast<
+            unsigned char>(p[i]);
+    if(c != S::check(begin, p - begin))
+        return fail(error::bad_serialized_url);
+    p += S::ncheck;
+
+    // the parts must lie within the URL
+    std::uint32_t off = 0;
+    for(int id = 0; id < S::nlen; ++id)
+    {
+        pt.offset[id] = off;
+        if(len[id] > n - off)
+            return fail(error::bad_serialized_url);
+        off += len[id];
+    }
+    pt.offset[detail::id_frag] = off;
+    pt.offset[detail::id_end] = n;
+    pt.nseg = nseg;
+    pt.nparam = nparam;
+    pt.port_number = static_cast<
+        std::uint16_t>(port);
+    if(! S::valid(pt, s))
+        return fail(error::bad_serialized_url);
+    if( pt.scheme_id == urls::scheme::unknown &&
+        pt.length(detail::id_scheme) > 1)
+        pt.scheme_id = string_to_scheme(
+            string_view(s, pt.length(
+                detail::id_scheme) - 1));
+
+    buf.remove_prefix(p - begin);
+    ec = {};
+    return url_view(s, pt);
+}
+
+url_view
+deserialize_url(
+    string_view& buf,
+    error_code& ec,
+    bool check_escapes) noexcept
+{
+    using S = detail::serial;
+    auto const buf0 = buf;
+    auto const u =
+        deserialize_url(buf, ec);
+    if(ec || ! check_escapes)
+        return u;
+    if( ! S::escapes(u.encoded_user()) ||
+        ! S::escapes(u.encoded_password()) ||
+        ! S::escapes(u.encoded_host()) ||
+        ! S::escapes(u.encoded_path()) ||
+        ! S::escapes(u.encoded_query()) ||
+        ! S::escapes(u.encoded_fragment()))
+    {
+        buf = buf0;
+        ec = error::bad_serialized_url;
+        return url_view();
+    }
+    return u;
+}
+
+url_view
+deserialize_url(
+    string_view& buf)
+{
+    error_code ec;
+    auto const u =
+        deserialize_url(buf, ec);
+    if(ec)
+        invalid_part::raise();
+    return u;
+}
+
+} // urls
+} // boost
+
+#endif
@@ -78,6 +78,75 @@ at( string_view key,
     return it->value(a);
 }
 
+template<class Predicate>
+std::size_t
+url_base::
+params_type::
+erase_if(Predicate pred)
+{
+    compactor c(v_);
+    while(! c.done())
+    {
+        if(pred(c.get()))
+            c.drop();
+        else
+            c.keep();
+    }
+    return c.ndrop_;
+}
+
+template<class Range>
+std::size_t
+url_base::
+params_type::
+retain(Range const& keys)
+{
+    return erase_if(
+        [&keys](value_type const& e)
+        {
+            for(auto const& k : keys)
+                if(detail::key_equal(
+                    e.encoded_key(),
+                    string_view(k)))
+                    return false;
+            return true;
+        });
+}
+
+template<class FwdIt>
+void
+url_base::
+params_type::
+append(
+    FwdIt first,
+    FwdIt last)
+{
+    // size everything first, so the
+    // storage is resized only once
+    std::size_t n = 0;
+    std::size_t count = 0;
+    for(auto it = first; it != last; ++it)
+    {
+        n += encoded_size(
+            string_view((*it).first),
+            string_view((*it).second));
+        ++count;
+    }
+    if(count == 0)
+        return;
+    auto dest = grow(n, count);
+    char sep = dest == v_->s_ +
+        v_->pt_.offset[detail::id_query] ?
+            '?' : '&';
+    for(auto it = first; it != last; ++it)
+    {
+        dest = encode(dest, sep,
+            string_view((*it).first),
+            string_view((*it).second));
+        sep = '&';
+    }
+}
+
 bool
 url_base::
 params_type::
@@ -11,8 +11,12 @@
 #define BOOST_URL_IMPL_URL_BASE_IPP
 
 #include <boost/url/error.hpp>
+#include <boost/url/idna.hpp>
 #include <boost/url/url_base.hpp>
+#include <boost/url/detail/instrument.hpp>
+#include <boost/url/detail/normalize.hpp>
 #include <boost/url/detail/parse.hpp>
+#include <algorithm>
 #include <cstring>
 #include <stdexcept>
 
@@ -38,6 +42,16 @@ url_base(
     set_encoded_url(s);
 }
 
+url_base::
+operator url_view() const noexcept
+{
+    url_view v;
+    if(s_)
+        v.s_ = s_;
+    v.pt_ = pt_;
+    return v;
+}
+
 string_view
 url_base::
 encoded_url() const
@@ -63,20 +77,36 @@ url_base::
 set_encoded_url(
     string_view s)
 {
+    error_code ec;
+    set_encoded_url(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_encoded_url(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
     {
         if(s_)
             resize(
                 detail::id_scheme,
                 detail::id_end, 0);
+        pt_ = detail::parts();
         return *this;
     }
-    error_code ec;
-    detail::parser pr(s);
+    if(s.size() > BOOST_URL_MAX_STRING_SIZE)
+        too_large::raise();
     detail::parts pt;
     detail::parse_url(pt, s, ec);
+    BOOST_URL_COUNT(detail::count_parse(ec));
     if(ec)
-        invalid_part::raise();
+        return *this;
     s_ = a_.resize(s.size());
     //---
     pt_ = pt;
@@ -85,24 +115,267 @@ set_encoded_url(
     return *this;
 }
 
+void
+url_base::
+reserve(std::size_t n)
+{
+    if(n > BOOST_URL_MAX_STRING_SIZE)
+        too_large::raise();
+    auto const p = a_.reserve(n);
+    // an empty URL may have no buffer
+    if(s_)
+        s_ = p;
+}
+
+void
+url_base::
+shrink_to_fit()
+{
+    // the parts may have shrunk
+    // without resizing the storage
+    (void)a_.resize(size());
+    auto const p = a_.shrink_to_fit();
+    if(s_)
+        s_ = p;
+}
+
+url_base&
+url_base::
+assign(
+    components const& c)
+{
+    error_code ec;
+    assign(c, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+assign(
+    components const& c,
+    error_code& ec)
+{
+    ec = {};
+    using detail::id_scheme;
+    using detail::id_user;
+    using detail::id_password;
+    using detail::id_host;
+    using detail::id_port;
+    using detail::id_path;
+    using detail::id_query;
+    using detail::id_frag;
+    using detail::id_end;
+
+    // an internationalized name is
+    // converted, as by set_host
+    std::string idn;
+    string_view host = c.host;
+    if(! detail::is_ascii(host))
+    {
+        error_code ec0;
+        idn = idna_to_ascii(host, ec0);
+        if(! ec0)
+            host = idn;
+    }
+
+    // validate
+    detail::parts pt;
+    if(! c.scheme.empty())
+    {
+        detail::parse_scheme(
+            pt, c.scheme, ec);
+        if(ec)
+            return *this;
+    }
+    if(! host.empty())
+        detail::parse_plain_hostname(
+            pt, host);
+    if(! c.port.empty())
+    {
+        pt.port_number =
+            detail::match_port(c.port, ec);
+        if(ec)
+            return *this;
+    }
+    bool const has_auth =
+        c.has_authority ||
+        ! c.user.empty() ||
+        ! c.password.empty() ||
+        ! host.empty() ||
+        ! c.port.empty();
+    if(c.path.empty())
+    {
+    }
+    else if(has_auth)
+    {
+        // path-abempty
+        detail::match_path_abempty(
+            c.path, ec);
+    }
+    else if(c.path.front() == '/')
+    {
+        // path-absolute
+        detail::match_path_absolute(
+            c.path, ec);
+    }
+    else if(c.scheme.empty())
+    {
+        // path-noscheme
+        detail::match_path_noscheme(
+            c.path, ec);
+    }
+    else
+    {
+        // path-rootless
+        detail::match_path_rootless(
+            c.path, ec);
+    }
+    if(ec)
+        return *this;
+
+    // measure
+    auto const eu =
+        detail::userinfo_nc_pct_set();
+    auto const ep =
+        detail::userinfo_pct_set();
+    auto const eh =
+        detail::reg_name_pct_set();
+    auto const eq =
+        detail::query_pct_set();
+    auto const ef =
+        detail::frag_pct_set();
+    bool const name =
+        pt.host == urls::host_type::name;
+    std::size_t n[id_end];
+    n[id_scheme] = c.scheme.empty() ?
+        0 : c.scheme.size() + 1;
+    n[id_user] = ! has_auth ?
+        0 : 2 + eu.encoded_size(c.user);
+    n[id_password] =
+        ! c.password.empty() ?
+            2 + ep.encoded_size(c.password) :
+        ! c.user.empty() ? 1 : 0;
+    n[id_host] = ! name ?
+        host.size() :
+        eh.encoded_size(host);
+    n[id_port] = c.port.empty() ?
+        0 : c.port.size() + 1;
+    n[id_path] = c.path.size();
+    n[id_query] = c.query.empty() ?
+        0 : 1 + eq.encoded_size(c.query);
+    n[id_frag] = c.fragment.empty() ?
+        0 : 1 + ef.encoded_size(c.fragment);
+    std::size_t total = 0;
+    for(int id = 0; id < id_end; ++id)
+        total += n[id];
+    if(total > BOOST_URL_MAX_STRING_SIZE)
+        too_large::raise();
+
+    // write
+    auto p = a_.resize(total);
+    s_ = p;
+    //---
+    if(! c.scheme.empty())
+    {
+        p += c.scheme.copy(
+            p, c.scheme.size());
+        *p++ = ':';
+    }
+    if(has_auth)
+    {
+        *p++ = '/';
+        *p++ = '/';
+        p += eu.encode(p, c.user);
+    }
+    if(! c.password.empty())
+    {
+        *p++ = ':';
+        p += ep.encode(p, c.password);
+        *p++ = '@';
+    }
+    else if(! c.user.empty())
+    {
+        *p++ = '@';
+    }
+    if(name)
+        p += eh.encode(p, host);
+    else
+        p += host.copy(
+            p, host.size());
+    if(! c.port.empty())
+    {
+        *p++ = ':';
+        p += c.port.copy(
+            p, c.port.size());
+    }
+    p += c.path.copy(
+        p, c.path.size());
+    if(! c.query.empty())
+    {
+        *p++ = '?';
+        p += eq.encode(p, c.query);
+    }
+    if(! c.fragment.empty())
+    {
+        *p++ = '#';
+        p += ef.encode(p, c.fragment);
+    }
+    BOOST_ASSERT(p == s_ + total);
+
+    pt.offset[0] = 0;
+    for(int id = 0; id < id_end; ++id)
+        pt.offset[id + 1] =
+            pt.offset[id] + static_cast<
+                detail::parts::size_type>(n[id]);
+    pt.nseg = c.path.empty() ? 0 :
+        static_cast<detail::parts::size_type>(
+            std::count(c.path.begin(),
+                c.path.end(), '/') +
+            (c.path.front() != '/'));
+    pt.nparam = c.query.empty() ? 0 :
+        static_cast<detail::parts::size_type>(
+            detail::count_params(pt.get(
+                id_query, s_)));
+    pt_ = pt;
+    return *this;
+}
+
 url_base&
 url_base::
 set_encoded_origin(
     string_view s)
 {
+    error_code ec;
+    set_encoded_origin(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_encoded_origin(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
     {
         resize(
             detail::id_scheme,
             detail::id_path, 0);
+        pt_.set_host(detail::parts());
+        pt_.scheme_id = urls::scheme::unknown;
+        pt_.port_number = 0;
         return *this;
     }
 
-    error_code ec;
     detail::parts pt;
     detail::parse_origin(pt, s, ec);
     if(ec)
-        invalid_part::raise();
+        return *this;
     auto const dest =
         resize(
             detail::id_scheme,
@@ -123,6 +396,9 @@ set_encoded_origin(
         pt.length(detail::id_host));
     pt_.split(
         detail::id_port, pt.length(detail::id_port));
+    pt_.set_host(pt);
+    pt_.scheme_id = pt.scheme_id;
+    pt_.port_number = pt.port_number;
     return *this;
 }
 
@@ -151,19 +427,37 @@ url_base::
 set_scheme(
     string_view s)
 {
+    error_code ec;
+    set_scheme(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_scheme(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
     {
         resize(detail::id_scheme, 0);
+        pt_.scheme_id = urls::scheme::unknown;
         return *this;
     }
 
     detail::parts pr;
-    detail::parse_scheme(pr, s);
+    detail::parse_scheme(pr, s, ec);
+    if(ec)
+        return *this;
     auto const n = s.size();
     auto const dest =
         resize(detail::id_scheme, n + 1);
     s.copy(dest, n);
     dest[n] = ':';
+    pt_.scheme_id = pr.scheme_id;
     return *this;
 }
 
@@ -205,16 +499,34 @@ url_base::
 set_encoded_authority(
     string_view s)
 {
+    error_code ec;
+    set_encoded_authority(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_encoded_authority(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
     {
         resize(
             detail::id_user,
             detail::id_path, 0);
+        pt_.set_host(detail::parts());
+        pt_.port_number = 0;
         return *this;
     }
 
     detail::parts pt;
-    detail::parse_authority(pt, s);
+    detail::parse_authority(pt, s, ec);
+    if(ec)
+        return *this;
     auto const dest = resize(
         detail::id_user,
         detail::id_path,
@@ -235,6 +547,8 @@ set_encoded_authority(
     BOOST_ASSERT(
         pt_.length(detail::id_port) ==
             pt.length(detail::id_port));
+    pt_.set_host(pt);
+    pt_.port_number = pt.port_number;
     return *this;
 }
 
@@ -316,6 +630,20 @@ url_base::
 set_encoded_userinfo(
     string_view s)
 {
+    error_code ec;
+    set_encoded_userinfo(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_encoded_userinfo(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
     {
         if(pt_.length(
@@ -336,7 +664,9 @@ set_encoded_userinfo(
     }
 
     detail::parts pt;
-    detail::parse_userinfo(pt, s);
+    detail::parse_userinfo(pt, s, ec);
+    if(ec)
+        return *this;
     auto dest = resize(
         detail::id_user,
         detail::id_host,
@@ -357,13 +687,30 @@ url_base::
 set_userinfo_part(
     string_view s)
 {
+    error_code ec;
+    set_userinfo_part(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_userinfo_part(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(! s.empty())
     {
         if(s.back() != '@')
-            invalid_part::raise();
+        {
+            ec = error::syntax;
+            return *this;
+        }
         s.remove_suffix(1);
     }
-    return set_encoded_userinfo(s);
+    return set_encoded_userinfo(s, ec);
 }
 
 string_view
@@ -448,12 +795,28 @@ url_base::
 set_encoded_user(
     string_view s)
 {
+    error_code ec;
+    set_encoded_user(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_encoded_user(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
         return set_user(s);
 
     auto const e =
         detail::userinfo_nc_pct_set();
-    e.validate(s);
+    e.validate(s, ec);
+    if(ec)
+        return *this;
 
     auto const n = s.size();
     if(pt_.length(detail::id_password) != 0)
@@ -576,14 +939,33 @@ url_base::
 set_encoded_password(
     string_view s)
 {
+    error_code ec;
+    set_encoded_password(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_encoded_password(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
         return set_password(s);
 
     auto const e =
         detail::userinfo_pct_set();
     if(s[0] == ':')
-        invalid_part::raise();
-    e.validate(s);
+    {
+        ec = error::bad_userinfo_char;
+        return *this;
+    }
+    e.validate(s, ec);
+    if(ec)
+        return *this;
 
     auto const n = s.size();
     if(pt_.length(detail::id_user) != 0)
@@ -613,12 +995,29 @@ url_base::
 set_password_part(
     string_view s)
 {
+    error_code ec;
+    set_password_part(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_password_part(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
         return set_password(s);
     if(s.size() == 1)
     {
         if(s.front() != ':')
-            invalid_part::raise();
+        {
+            ec = error::syntax;
+            return *this;
+        }
         if(pt_.length(
             detail::id_user) != 0)
         {
@@ -639,7 +1038,7 @@ set_password_part(
             detail::id_user, 2);
     }
     set_encoded_password(
-        s.substr(1));
+        s.substr(1), ec);
     return *this;
 }
 
@@ -673,6 +1072,14 @@ url_base::
 set_host(
     string_view s)
 {
+    if(! detail::is_ascii(s))
+    {
+        // an internationalized name
+        error_code ec;
+        auto const a = idna_to_ascii(s, ec);
+        if(! ec)
+            return set_host(a);
+    }
     if(s.empty())
     {
         // just hostname
@@ -693,6 +1100,7 @@ set_host(
         {
             resize(detail::id_host, 0);
         }
+        pt_.set_host(detail::parts());
         return *this;
     }
     detail::parts pt;
@@ -749,7 +1157,7 @@ set_host(
             e.encode(dest, s);
         }
     }
-    pt_.host = pt.host;
+    pt_.set_host(pt);
     return *this;
 }
 
@@ -758,10 +1166,26 @@ url_base::
 set_encoded_host(
     string_view s)
 {
+    error_code ec;
+    set_encoded_host(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_encoded_host(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
         return set_host(s);
     detail::parts pt;
-    detail::parse_hostname(pt, s);
+    detail::parse_hostname(pt, s, ec);
+    if(ec)
+        return *this;
     if(! has_authority())
     {
         // add authority
@@ -783,7 +1207,7 @@ set_encoded_host(
             s.size());
         s.copy(dest, s.size());
     }
-    pt_.host = pt.host;
+    pt_.set_host(pt);
     return *this;
 }
 
@@ -823,8 +1247,23 @@ set_port(unsigned n)
 
 url_base&
 url_base::
-set_port(string_view s)
+set_port(
+    string_view s)
 {
+    error_code ec;
+    set_port(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_port(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
     {
         // just port
@@ -844,9 +1283,14 @@ set_port(string_view s)
         {
             resize(detail::id_port, 0);
         }
+        pt_.port_number = 0;
         return *this;
     }
-    detail::match_port(s);
+    auto const n =
+        detail::match_port(s, ec);
+    if(ec)
+        return *this;
+    pt_.port_number = n;
     if(! has_authority())
     {
         // add authority
@@ -877,19 +1321,38 @@ set_port(string_view s)
 
 url_base&
 url_base::
-set_port_part(string_view s)
+set_port_part(
+    string_view s)
+{
+    error_code ec;
+    set_port_part(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_port_part(
+    string_view s,
+    error_code& ec)
 {
+    ec = {};
     if(s.empty())
     {
-        set_port(s);
+        set_port(s, ec);
         return *this;
     }
     if(s.front() != ':')
-        invalid_part::raise();
+    {
+        ec = error::bad_port_char;
+        return *this;
+    }
     if(s.size() > 1)
-        return set_port(s.substr(1));
+        return set_port(s.substr(1), ec);
     resize(
         detail::id_port, 1)[0] = ':';
+    pt_.port_number = 0;
     return *this;
 }
 
@@ -913,37 +1376,60 @@ url_base::
 set_encoded_path(
     string_view s)
 {
+    error_code ec;
+    set_encoded_path(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_encoded_path(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     // path-empty
     if(s.empty())
     {
         resize(
             detail::id_path, 0);
+        pt_.nseg = 0;
         return *this;
     }
     if(has_authority())
     {
         // path-abempty
-        detail::match_path_abempty(s);
+        detail::match_path_abempty(s, ec);
     }
     else if(s.front() == '/')
     {
         // path-absolute
-        detail::match_path_absolute(s);
+        detail::match_path_absolute(s, ec);
     }
     else if(pt_.length(
         detail::id_scheme) == 0)
     {
         // path-noscheme
-        detail::match_path_noscheme(s);
+        detail::match_path_noscheme(s, ec);
     }
     else
     {
         // path-rootless
-        detail::match_path_rootless(s);
+        detail::match_path_rootless(s, ec);
     }
+    if(ec)
+        return *this;
     auto const dest = resize(
         detail::id_path, s.size());
     s.copy(dest, s.size());
+    // a segment begins at each '/', and at
+    // the start of a path without a root
+    pt_.nseg = static_cast<
+        detail::parts::size_type>(
+            std::count(s.begin(), s.end(), '/') +
+            (s.front() != '/'));
     return *this;
 }
 
@@ -987,6 +1473,7 @@ set_query(
     if(s.empty())
     {
         resize(detail::id_query, 0);
+        pt_.nparam = 0;
         return *this;
     }
     auto const e =
@@ -998,6 +1485,10 @@ set_query(
         1 + n);
     dest[0] = '?';
     e.encode(dest + 1, s);
+    pt_.nparam = static_cast<
+        detail::parts::size_type>(
+            detail::count_params(
+                query_part()));
     return *this;
 }
 
@@ -1006,19 +1497,40 @@ url_base::
 set_encoded_query(
     string_view s)
 {
+    error_code ec;
+    set_encoded_query(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_encoded_query(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
     {
         resize(detail::id_query, 0);
+        pt_.nparam = 0;
         return *this;
     }
     auto const e =
         detail::query_pct_set();
-    e.validate(s);
+    e.validate(s, ec);
+    if(ec)
+        return *this;
     auto const dest = resize(
         detail::id_query,
         1 + s.size());
     dest[0] = '?';
     s.copy(dest + 1, s.size());
+    pt_.nparam = static_cast<
+        detail::parts::size_type>(
+            detail::count_params(
+                query_part()));
     return *this;
 }
 
@@ -1027,22 +1539,46 @@ url_base::
 set_query_part(
     string_view s)
 {
+    error_code ec;
+    set_query_part(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_query_part(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
     {
         resize(detail::id_query, 0);
+        pt_.nparam = 0;
         return *this;
     }
     if(s.front() != '?')
-        invalid_part::raise();
+    {
+        ec = error::syntax;
+        return *this;
+    }
     s = s.substr(1);
     auto const e =
         detail::query_pct_set();
-    e.validate(s);
+    e.validate(s, ec);
+    if(ec)
+        return *this;
     auto const dest = resize(
         detail::id_query,
         1 + s.size());
     dest[0] = '?';
     s.copy(dest + 1, s.size());
+    pt_.nparam = static_cast<
+        detail::parts::size_type>(
+            detail::count_params(
+                query_part()));
     return *this;
 }
 
@@ -1104,6 +1640,20 @@ url_base::
 set_encoded_fragment(
     string_view s)
 {
+    error_code ec;
+    set_encoded_fragment(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_encoded_fragment(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
     {
         resize(detail::id_frag, 0);
@@ -1111,7 +1661,9 @@ set_encoded_fragment(
     }
     auto const e =
         detail::frag_pct_set();
-    e.validate(s);
+    e.validate(s, ec);
+    if(ec)
+        return *this;
     auto const dest = resize(
         detail::id_frag,
         1 + s.size());
@@ -1125,17 +1677,36 @@ url_base::
 set_fragment_part(
     string_view s)
 {
+    error_code ec;
+    set_fragment_part(s, ec);
+    if(ec)
+        invalid_part::raise();
+    return *this;
+}
+
+url_base&
+url_base::
+set_fragment_part(
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
     if(s.empty())
     {
         resize(detail::id_frag, 0);
         return *this;
     }
     if(s.front() != '#')
-        invalid_part::raise();
+    {
+        ec = error::syntax;
+        return *this;
+    }
     s = s.substr(1);
     auto const e =
         detail::frag_pct_set();
-    e.validate(s);
+    e.validate(s, ec);
+    if(ec)
+        return *this;
     auto const dest = resize(
         detail::id_frag,
         1 + s.size());
@@ -1148,9 +1719,179 @@ set_fragment_part(
 
 url_base&
 url_base::
-normalize()
+normalize(
+    normalize_flags f) noexcept
 {
-    normalize_scheme();
+    using detail::id_scheme;
+    using detail::id_host;
+    using detail::id_port;
+    using detail::id_path;
+    using detail::id_end;
+    auto const has = [f](normalize_flags x)
+    {
+        return (f & x) != normalize_flags::none;
+    };
+
+    if(has(normalize_flags::scheme))
+        normalize_scheme();
+    if(size() == 0)
+        return *this;
+
+    bool const upper = has(
+        normalize_flags::pct_hex);
+    bool const decode = has(
+        normalize_flags::unreserved);
+    bool const lower_host =
+        has(normalize_flags::host) && (
+            pt_.host == urls::host_type::name ||
+            pt_.host == urls::host_type::ipv6);
+    auto const port_len =
+        pt_.length(id_port);
+    bool const drop_port =
+        has(normalize_flags::port) &&
+        port_len > 0 && (
+            port_len == 1 || (
+                pt_.port_number != 0 &&
+                pt_.port_number ==
+                    urls::default_port(
+                        pt_.scheme_id)));
+    bool const dots =
+        has(normalize_flags::path) &&
+        pt_.length(id_path) > 0 && (
+            pt_.length(id_scheme) > 0 ||
+            s_[pt_.offset[id_path]] == '/');
+    if( ! upper &&
+        ! decode &&
+        ! lower_host &&
+        ! drop_port &&
+        ! dots)
+        return *this;
+
+    // Rewrite each part in a single forward
+    // pass. The output never outgrows the
+    // input, so the writer stays behind the
+    // reader in the same buffer.
+    auto const host_len0 =
+        pt_.length(id_host);
+    bool const authority =
+        has_authority();
+    auto const lower = [](char c)
+    {
+        if(static_cast<unsigned char>(
+            c - 'A') < 26)
+            return static_cast<char>(c + 32);
+        return c;
+    };
+    auto const upper_hex = [](char c)
+    {
+        if(static_cast<unsigned char>(
+            c - 'a') < 6)
+            return static_cast<char>(c - 32);
+        return c;
+    };
+    char* w = s_;
+    char const* r = s_;
+    detail::parts::size_type off[id_end + 1];
+    for(int id = id_scheme; id < id_end; ++id)
+    {
+        off[id] = static_cast<
+            detail::parts::size_type>(w - s_);
+        auto const end =
+            s_ + pt_.offset[id + 1];
+        if(id == id_port && drop_port)
+        {
+            r = end;
+            continue;
+        }
+        bool const fold =
+            lower_host && id == id_host;
+        auto const w0 = w;
+        while(r < end)
+        {
+            auto const c = *r;
+            if(c != '%')
+            {
+                *w++ = fold ? lower(c) : c;
+                ++r;
+                continue;
+            }
+            BOOST_ASSERT(end - r >= 3);
+            auto const ch = static_cast<char>(
+                (static_cast<unsigned char>(
+                    detail::hex_digit(r[1])) << 4) +
+                static_cast<unsigned char>(
+                    detail::hex_digit(r[2])));
+            if( decode &&
+                detail::is_unreserved(ch))
+            {
+                *w++ = fold ? lower(ch) : ch;
+            }
+            else
+            {
+                *w++ = '%';
+                *w++ = upper ? upper_hex(r[1]) : r[1];
+                *w++ = upper ? upper_hex(r[2]) : r[2];
+            }
+            r += 3;
+        }
+        if(id == id_path && dots)
+        {
+            auto n = detail::remove_dot_segments(
+                w0, w0, w);
+            // A path which would begin with "//"
+            // when there is no authority is
+            // prefixed with "/." to keep it a path.
+            // Every dot segment removed freed at
+            // least two characters, so it fits.
+            if( n > 1 &&
+                w0[0] == '/' &&
+                w0[1] == '/' &&
+                ! authority)
+            {
+                BOOST_ASSERT(r - (w0 + n) >= 2);
+                std::memmove(w0 + 2, w0, n);
+                BOOST_URL_COUNT(detail::counters().bytes_moved += n);
+                w0[0] = '/';
+                w0[1] = '.';
+                n += 2;
+            }
+            w = w0 + n;
+        }
+    }
+    off[id_end] = static_cast<
+        detail::parts::size_type>(w - s_);
+    *w = '\0';
+
+    // Removing dot segments and adding the
+    // "/." prefix may keep the length and
+    // still change the segments.
+    bool const path_changed =
+        dots ||
+        off[id_path + 1] - off[id_path] !=
+            pt_.length(id_path);
+    for(int id = id_scheme; id <= id_end; ++id)
+        pt_.offset[id] = off[id];
+    if(drop_port)
+        pt_.port_number = 0;
+    if(path_changed)
+    {
+        auto const path = pt_.get(id_path, s_);
+        pt_.nseg = path.empty() ? 0 :
+            static_cast<detail::parts::size_type>(
+                std::count(path.begin(),
+                    path.end(), '/') +
+                (path.front() != '/'));
+    }
+    // Decoding may turn a name
+    // into an IPv4 address
+    if( pt_.host == urls::host_type::name &&
+        pt_.length(id_host) != host_len0)
+    {
+        detail::parts pt;
+        detail::parse_plain_hostname(
+            pt, pt_.get(id_host, s_));
+        pt_.set_host(pt);
+    }
     return *this;
 }
 
@@ -1190,6 +1931,7 @@ iterator() noexcept
     : v_(nullptr)
     , off_(0)
     , n_(0)
+    , dn_(0)
 {
 }
 
@@ -1205,6 +1947,7 @@ iterator(
     {
         off_ = 0;
         n_ = 0;
+        dn_ = 0;
     }
     else if( end ||
         v_->pt_.nseg == 0)
@@ -1212,6 +1955,7 @@ iterator(
         off_ = v_->pt_.offset[
             detail::id_query];
         n_ = 0;
+        dn_ = 0;
     }
     else
     {
@@ -1233,7 +1977,7 @@ operator*() const noexcept ->
     if(! s.empty() &&
         s.front() == '/')
         s = s.substr(1);
-    return value_type(s);
+    return value_type(s, dn_);
 }
 
 auto
@@ -1245,13 +1989,14 @@ operator++() noexcept ->
 {
     BOOST_ASSERT(
         off_ != v_->pt_.offset[
-            detail::id_frag]);
+            detail::id_query]);
     off_ = off_ + n_;
     if(off_ == v_->pt_.offset[
-        detail::id_frag])
+        detail::id_query])
     {
         // end
         n_ = 0;
+        dn_ = 0;
     }
     else
     {
@@ -1277,17 +2022,12 @@ operator--() noexcept ->
     while(--p > begin)
     {
         if(*p == '/')
-        {
-            off_ = p - v_->s_;
-            parse();
-            return *this;
-        }
+            break;
     }
-    // fails for relative-uri
-    //BOOST_ASSERT(*p == '/');
-    auto const off = p - v_->s_;
-    n_ = off_ - off;
-    off_ = off;
+    // the first segment of a relative-uri
+    // has no slash
+    off_ = p - v_->s_;
+    parse();
     return *this;
 }
 
@@ -1297,9 +2037,7 @@ segments_type::
 iterator::
 parse() noexcept
 {
-    BOOST_ASSERT(off_ !=
-        v_->pt_.offset[
-            detail::id_frag]);
+    // at the end this yields n_ == 0
     auto const end =
         v_->s_ + v_->pt_.offset[
             detail::id_query];
@@ -1308,13 +2046,20 @@ parse() noexcept
     auto p = p0;
     if(*p == '/')
         ++p;
+    auto const p1 = p;
+    // the path is valid, so each
+    // escape is three characters
+    std::size_t escapes = 0;
     while(p < end)
     {
         if(*p == '/')
             break;
+        if(*p == '%')
+            ++escapes;
         ++p;
     }
     n_ = p - p0;
+    dn_ = (p - p1) - 2 * escapes;
 }
 
 //----------------------------------------------------------
@@ -1366,14 +2111,29 @@ erase( iterator first, iterator last ) noexcept ->
     if( d == 0 )
         return first;
     BOOST_ASSERT(d > 0);
-    int c = 0;
-    for( auto i = v.s_ + first.off_, e = v.s_ + last.off_; i != e; ++i )
-        c += (*i == '/'); // Count the number of segments in the range
+    std::size_t c = 0;
+    std::size_t i0 = 0;
+    if( idx_ )
+    {
+        // The index knows the positions
+        auto const p = v.pt_.offset[detail::id_path];
+        i0 = idx_->find(first.off_ - p);
+        c = idx_->find(last.off_ - p) - i0;
+    }
+    else
+    {
+        for( auto i = v.s_ + first.off_, e = v.s_ + last.off_; i != e; ++i )
+            c += (*i == '/'); // Count the number of segments in the range
+    }
     BOOST_ASSERT(c > 0);
     BOOST_ASSERT(v.pt_.nseg >= c);
-    v.pt_.nseg -= c;
+    v.pt_.nseg -= static_cast<detail::parts::size_type>(c);
     std::memmove(v.s_ + first.off_, v.s_ + last.off_, v.pt_.offset[detail::id_end] - last.off_ + 1);
+    BOOST_URL_COUNT(detail::counters().bytes_moved +=
+        v.pt_.offset[detail::id_end] - last.off_ + 1);
     v.pt_.resize(detail::id_path, v.pt_.length(detail::id_path, detail::id_query) - d);
+    if( idx_ )
+        idx_->on_erase(i0, i0 + c, d);
     BOOST_ASSERT(v.size() + d == v.a_.size());
     auto const s = v.a_.resize(v.size());
     BOOST_ASSERT(v.s_ == s);
@@ -1395,15 +2155,24 @@ insert_encoded_impl( iterator pos, string_view s ) ->
     BOOST_ASSERT(pos.v_ == &v);
     BOOST_ASSERT(pos.off_ >= v.pt_.offset[detail::id_path]);
     BOOST_ASSERT(pos.off_ <= v.pt_.offset[detail::id_query]);
+    std::size_t i = 0;
+    if( idx_ )
+    {
+        i = idx_->find(pos.off_ - v.pt_.offset[detail::id_path]);
+        idx_->reserve_one();
+    }
     auto const n0 = v.pt_.offset[detail::id_end];
     auto const n = s.size() + 1;
     v.s_ = v.a_.resize(v.size() + n);
     v.pt_.resize(detail::id_path, v.pt_.length(detail::id_path, detail::id_query) + n);
     std::memmove(v.s_ + v.pt_.offset[detail::id_end] + pos.off_ - n0, v.s_ + pos.off_, n0 - pos.off_ + 1);
+    BOOST_URL_COUNT(detail::counters().bytes_moved += n0 - pos.off_ + 1);
     BOOST_ASSERT(v.s_[v.pt_.offset[detail::id_end]] == '\0');
     v.s_[pos.off_] = '/';
     std::memcpy(v.s_ + pos.off_ + 1, s.data(), s.size());
     ++v.pt_.nseg;
+    if( idx_ )
+        idx_->on_insert(i, n);
     pos.off_ += n;
     pos.parse();
     return pos;
@@ -1423,15 +2192,24 @@ insert_impl( iterator pos, string_view s, std::size_t const ns ) ->
     BOOST_ASSERT(pos.off_ <= v.pt_.offset[detail::id_query]);
     auto const pct = detail::pchar_pct_set();
     BOOST_ASSERT(pct.encoded_size(s) == ns);
+    std::size_t i = 0;
+    if( idx_ )
+    {
+        i = idx_->find(pos.off_ - v.pt_.offset[detail::id_path]);
+        idx_->reserve_one();
+    }
     auto const n0 = v.pt_.offset[detail::id_end];
     auto const n = ns + 1;
     v.s_ = v.a_.resize(v.size() + n);
     v.pt_.resize(detail::id_path, v.pt_.length(detail::id_path, detail::id_query) + n);
     std::memmove(v.s_ + v.pt_.offset[detail::id_end] + pos.off_ - n0, v.s_ + pos.off_, n0 - pos.off_ + 1);
+    BOOST_URL_COUNT(detail::counters().bytes_moved += n0 - pos.off_ + 1);
     BOOST_ASSERT(v.s_[v.pt_.offset[detail::id_end]] == '\0');
     v.s_[pos.off_] = '/';
     pct.encode(v.s_ + pos.off_ + 1, s);
     ++v.pt_.nseg;
+    if( idx_ )
+        idx_->on_insert(i, n);
     pos.off_ += n;
     pos.parse();
     return pos;
@@ -1470,6 +2248,8 @@ replace_encoded( iterator pos, string_view s ) ->
     auto const n = ns + 1;
     if( n0 < n )
         v.s_ = v.a_.reserve(v.a_.size() + n - n0);
+    if( idx_ )
+        idx_->reserve_one();
     auto const cap = v.a_.capacity();
     auto r = insert_encoded_impl(erase(pos), s);
     BOOST_ASSERT(v.a_.capacity() == cap); // Strong guarantee violation
@@ -1491,6 +2271,8 @@ replace( iterator pos, string_view s ) ->
     auto const n = ns + 1;
     if( n0 < n )
         v.s_ = v.a_.reserve(v.a_.size() + n - n0);
+    if( idx_ )
+        idx_->reserve_one();
     auto const cap = v.a_.capacity();
     auto r = insert_impl(erase(pos), s, ns);
     BOOST_ASSERT(v.a_.capacity() == cap); // Strong guarantee violation
@@ -1512,6 +2294,8 @@ iterator() noexcept
     , off_(0)
     , nk_(0)
     , nv_(0)
+    , dk_(0)
+    , dv_(0)
 {
 }
 
@@ -1528,6 +2312,8 @@ iterator(
         off_ = 0;
         nk_ = 0;
         nv_ = 0;
+        dk_ = 0;
+        dv_ = 0;
     }
     else if( end ||
             v_->pt_.nparam == 0)
@@ -1536,6 +2322,8 @@ iterator(
             detail::id_frag];
         nk_ = 0;
         nv_ = 0;
+        dk_ = 0;
+        dv_ = 0;
     }
     else
     {
@@ -1564,13 +2352,13 @@ operator*() const noexcept ->
         v_->s_ + off_ + 1,
         nk_ - 1 };
     if(nv_ == 0)
-        return { k, { } };
+        return { k, { }, dk_, 0 };
     BOOST_ASSERT(
         v_->s_[off_ + nk_] == '=');
     string_view const v = {
         v_->s_ + off_ + nk_ + 1,
         nv_ - 1};
-    return { k, v };
+    return { k, v, dk_, dv_ };
 }
 
 auto
@@ -1592,6 +2380,8 @@ operator++() noexcept ->
         // end
         nv_ = 0;
         nk_ = 0;
+        dk_ = 0;
+        dv_ = 0;
     }
     else
     {
@@ -1619,14 +2409,11 @@ operator--() noexcept ->
     while(--p > begin)
     {
         if(*p == '&')
-        {
-            off_ = p - v_->s_;
-            parse();
-            return *this;
-        }
+            break;
     }
-    BOOST_ASSERT(*p == '?');
+    BOOST_ASSERT(*p == '&' || *p == '?');
     off_ = p - v_->s_;
+    parse();
     return *this;
 }
 
@@ -1640,7 +2427,7 @@ parse() noexcept
     BOOST_ASSERT(v_->pt_.nparam > 0);
     auto const end =
         v_->s_ + v_->pt_.offset[
-            detail::id_end];
+            detail::id_frag];
     char const* p = v_->s_ + off_;
     BOOST_ASSERT(
         ( off_ == v_->pt_.offset[
@@ -1653,21 +2440,26 @@ parse() noexcept
     auto const ek =
         detail::qkey_pct_set();
     error_code ec;
-    p = ek.parse(p, end, ec);
+    std::size_t escapes = 0;
+    p = ek.parse(p, end, escapes, ec);
     BOOST_ASSERT(! ec);
     nk_ = p - p0;
+    dk_ = nk_ - 1 - 2 * escapes;
     if(p == end)
     {
         nv_ = 0;
+        dv_ = 0;
         return;
     }
     auto const ev =
         detail::qval_pct_set();
     BOOST_ASSERT(*p == '=');
     p0 = p++;
-    p = ev.parse(p, end, ec);
+    escapes = 0;
+    p = ev.parse(p, end, escapes, ec);
     BOOST_ASSERT(! ec);
     nv_ = p - p0;
+    dv_ = nv_ - 1 - 2 * escapes;
 }
 
 //----------------------------------------------------------
@@ -1744,6 +2536,265 @@ operator[](string_view key) const
     return it->value();
 }
 
+std::size_t
+url_base::
+params_type::
+erase(string_view key) noexcept
+{
+    return erase_if(
+        [key](value_type const& e)
+        {
+            return detail::key_equal(
+                e.encoded_key(), key);
+        });
+}
+
+std::size_t
+url_base::
+params_type::
+retain(std::initializer_list<
+    string_view> keys) noexcept
+{
+    return retain<std::initializer_list<
+        string_view>>(keys);
+}
+
+void
+url_base::
+params_type::
+append(std::initializer_list<std::pair<
+    string_view, string_view>> init)
+{
+    append(init.begin(), init.end());
+}
+
+void
+url_base::
+params_type::
+set(
+    string_view key,
+    string_view value)
+{
+    auto const ev =
+        detail::qval_pct_set();
+    std::size_t off = 0;
+    std::size_t nk = 0;
+    std::size_t nv = 0;
+    bool found = false;
+    {
+        compactor c(v_);
+        while(! c.done())
+        {
+            if(! detail::key_equal(
+                c.get().encoded_key(), key))
+            {
+                c.keep();
+            }
+            else if(! found)
+            {
+                found = true;
+                nk = c.it_.nk_;
+                nv = c.it_.nv_;
+                off = c.keep();
+            }
+            else
+            {
+                c.drop();
+            }
+        }
+    }
+    if(! found)
+    {
+        std::pair<string_view,
+            string_view> const p(key, value);
+        append(&p, &p + 1);
+        return;
+    }
+
+    // replace the value, including the '='
+    auto& u = *v_;
+    auto const n = 1 + ev.encoded_size(value);
+    auto const pos = off + nk + nv;
+    auto const tail =
+        u.pt_.offset[detail::id_frag] - pos;
+    auto const len =
+        u.pt_.length(detail::id_query);
+    if(n > nv)
+    {
+        u.resize(detail::id_query,
+            len + n - nv);
+        std::memmove(
+            u.s_ + pos + n - nv,
+            u.s_ + pos, tail);
+        BOOST_URL_COUNT(detail::counters().bytes_moved += tail);
+    }
+    else if(n < nv)
+    {
+        std::memmove(
+            u.s_ + pos - (nv - n),
+            u.s_ + pos, tail);
+        BOOST_URL_COUNT(detail::counters().bytes_moved += tail);
+        u.resize(detail::id_query,
+            len - (nv - n));
+    }
+    auto const dest = u.s_ + off + nk;
+    dest[0] = '=';
+    ev.encode(dest + 1, value);
+}
+
+std::size_t
+url_base::
+params_type::
+encoded_size(
+    string_view key,
+    string_view value) noexcept
+{
+    auto const ek =
+        detail::param_key_pct_set();
+    auto const ev =
+        detail::qval_pct_set();
+    return 2 +
+        ek.encoded_size(key) +
+        ev.encoded_size(value);
+}
+
+char*
+url_base::
+params_type::
+encode(
+    char* dest,
+    char sep,
+    string_view key,
+    string_view value) noexcept
+{
+    auto const ek =
+        detail::param_key_pct_set();
+    auto const ev =
+        detail::qval_pct_set();
+    *dest++ = sep;
+    dest += ek.encode(dest, key);
+    *dest++ = '=';
+    dest += ev.encode(dest, value);
+    return dest;
+}
+
+// Make room for n characters at the
+// end of the query, for count params.
+// A key without '=' takes in the '&'
+// after it, so the last param is given
+// an empty value, and the empty param
+// of a bare "?" is replaced.
+char*
+url_base::
+params_type::
+grow(
+    std::size_t n,
+    std::size_t count)
+{
+    auto& u = *v_;
+    auto len =
+        u.pt_.length(detail::id_query);
+    auto nparam = u.pt_.nparam;
+    std::size_t eq = 0;
+    if(len == 1)
+    {
+        BOOST_ASSERT(nparam == 1);
+        len = 0;
+        nparam = 0;
+    }
+    else if(len > 1)
+    {
+        auto const q = u.s_ +
+            u.pt_.offset[detail::id_query];
+        eq = 1;
+        for(auto p = q + len; --p != q;)
+        {
+            if(*p == '=')
+            {
+                eq = 0;
+                break;
+            }
+            if(*p == '&')
+                break;
+        }
+    }
+    auto const dest = u.resize(
+        detail::id_query, len + eq + n) + len;
+    if(eq)
+        *dest = '=';
+    u.pt_.nparam = static_cast<
+        detail::parts::size_type>(
+            nparam + count);
+    return dest + eq;
+}
+
+//----------------------------------------------------------
+
+url_base::
+params_type::
+compactor::
+compactor(url_base* u) noexcept
+    : u_(u)
+    , it_(u, false)
+    , end_(u, true)
+    , w_(u ? u->pt_.offset[
+        detail::id_query] : 0)
+{
+}
+
+url_base::
+params_type::
+compactor::
+~compactor()
+{
+    if(! u_ || ndrop_ == 0)
+        return;
+    auto& u = *u_;
+    auto const q0 =
+        u.pt_.offset[detail::id_query];
+    auto const q1 =
+        u.pt_.offset[detail::id_frag];
+    // keep the params which were not
+    // visited, if the predicate threw
+    auto const r = it_.off_;
+    if(r < q1)
+    {
+        std::memmove(
+            u.s_ + w_, u.s_ + r, q1 - r);
+        BOOST_URL_COUNT(detail::counters().bytes_moved += q1 - r);
+        if(w_ == q0)
+            u.s_[w_] = '?';
+    }
+    u.resize(detail::id_query,
+        (w_ - q0) + (q1 - r));
+    u.pt_.nparam = static_cast<
+        detail::parts::size_type>(
+            u.pt_.nparam - ndrop_);
+}
+
+std::size_t
+url_base::
+params_type::
+compactor::
+keep() noexcept
+{
+    auto const s = u_->s_;
+    auto const n = it_.nk_ + it_.nv_;
+    auto const off = w_;
+    if(off != it_.off_)
+    {
+        std::memmove(
+            s + off, s + it_.off_, n);
+        BOOST_URL_COUNT(detail::counters().bytes_moved += n);
+        s[off] = off == u_->pt_.offset[
+            detail::id_query] ? '?' : '&';
+    }
+    w_ += n;
+    ++it_;
+    ++nkeep_;
+    return off;
+}
+
 //----------------------------------------------------------
 
 char*
@@ -1767,15 +2818,18 @@ resize(
             s_ + pos,
             pt_.offset[
                 detail::id_end] - pos + 1);
+        BOOST_URL_COUNT(detail::counters().bytes_moved +=
+            pt_.offset[detail::id_end] - pos + 1);
         for(auto i = id + 1;
             i <= detail::id_end; ++i)
-            pt_.offset[i] -= n;
+            pt_.offset[i] -= static_cast<
+                detail::parts::size_type>(n);
         return s_ + pt_.offset[id];
     }
 
     // grow
-    if(new_size - len > (
-        (std::size_t)-1)- size())
+    if(new_size - len >
+        BOOST_URL_MAX_STRING_SIZE - size())
         too_large::raise();
     s_ = a_.resize(
         size() - len + new_size);
@@ -1788,9 +2842,12 @@ resize(
         s_ + pos,
         pt_.offset[detail::id_end] -
             pos + 1);
+    BOOST_URL_COUNT(detail::counters().bytes_moved +=
+        pt_.offset[detail::id_end] - pos + 1);
     for(auto i = id + 1;
         i <= detail::id_end; ++i)
-        pt_.offset[i] += n;
+        pt_.offset[i] += static_cast<
+            detail::parts::size_type>(n);
     return s_ + pt_.offset[id];
 }
 
@@ -1817,19 +2874,23 @@ resize(
             s_ + pos,
             pt_.offset[
                 detail::id_end] - pos + 1);
+        BOOST_URL_COUNT(detail::counters().bytes_moved +=
+            pt_.offset[detail::id_end] - pos + 1);
         for(auto i = first + 1;
             i < last; ++i)
-            pt_.offset[i] =
-                pt_.offset[last] - n;
+            pt_.offset[i] = static_cast<
+                detail::parts::size_type>(
+                    pt_.offset[last] - n);
         for(auto i = last;
             i <= detail::id_end; ++i)
-            pt_.offset[i] -= n;
+            pt_.offset[i] -= static_cast<
+                detail::parts::size_type>(n);
         return s_ + pt_.offset[first];
     }
 
     // grow
-    if(new_size - len > (
-        (std::size_t)-1)- size())
+    if(new_size - len >
+        BOOST_URL_MAX_STRING_SIZE - size())
         too_large::raise();
     s_ = a_.resize(
         size() - len + new_size);
@@ -1842,13 +2903,17 @@ resize(
         s_ + pos,
         pt_.offset[detail::id_end] -
             pos + 1);
+    BOOST_URL_COUNT(detail::counters().bytes_moved +=
+        pt_.offset[detail::id_end] - pos + 1);
     for(auto i = first + 1;
         i < last; ++i)
-        pt_.offset[i] =
-            pt_.offset[last] + n;
+        pt_.offset[i] = static_cast<
+            detail::parts::size_type>(
+                pt_.offset[last] + n);
     for(auto i = last;
         i <= detail::id_end; ++i)
-        pt_.offset[i] += n;
+        pt_.offset[i] += static_cast<
+            detail::parts::size_type>(n);
     return s_ + pt_.offset[first];
 }
 
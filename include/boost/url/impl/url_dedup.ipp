@@ -0,0 +1,223 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_URL_DEDUP_IPP
+#define BOOST_URL_IMPL_URL_DEDUP_IPP
+
+#include <boost/url/url_dedup.hpp>
+#include <boost/url/basic_url.hpp>
+#include <boost/url/hash.hpp>
+#include <boost/url/static_pool.hpp>
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace boost {
+namespace urls {
+
+// The URL is normalized in its own storage,
+// which stays in the arena for as long as the
+// thread runs, so each URL is copied once.
+struct url_dedup::worker
+{
+    using allocator_type =
+        basic_static_pool::allocator_type<char>;
+
+    static_pool<4096> pool;
+    basic_url<allocator_type> u;
+
+    worker()
+        : pool(4096)
+        , u(pool.allocator())
+    {
+    }
+};
+
+url_dedup::
+url_dedup(
+    char* buffer,
+    std::size_t size,
+    std::size_t shards)
+    : buf_(buffer)
+    , cap_(size)
+    , used_(0)
+    , size_(0)
+{
+    if(shards == 0)
+        shards = 4 * (std::max)(1U,
+            std::thread::hardware_concurrency());
+    nshard_ = 1;
+    while(nshard_ < shards)
+        nshard_ *= 2;
+    shards_.reset(new shard[nshard_]);
+}
+
+// Take n bytes from the end of the buffer,
+// or return null if there is not enough room
+char*
+url_dedup::
+reserve(std::size_t n) noexcept
+{
+    auto used = used_.load(
+        std::memory_order_relaxed);
+    do
+    {
+        if(n > cap_ - used)
+            return nullptr;
+    }
+    while(! used_.compare_exchange_weak(
+        used, used + n,
+        std::memory_order_relaxed));
+    return buf_ + used;
+}
+
+string_view
+url_dedup::
+emplace(
+    string_view s,
+    std::size_t hash,
+    bool& inserted,
+    error_code& ec)
+{
+    inserted = false;
+    auto& sh = shards_[hash & (nshard_ - 1)];
+    auto const h = hash / nshard_;
+    std::lock_guard<std::mutex> lock(sh.m);
+    // at most half full
+    if(2 * (sh.size + 1) > sh.v.size())
+    {
+        std::vector<slot> v(
+            (std::max)(std::size_t(64),
+                2 * sh.v.size()),
+            slot{ 0, nullptr, 0 });
+        auto const mask = v.size() - 1;
+        for(auto const& e : sh.v)
+        {
+            if(! e.p)
+                continue;
+            auto i = (e.hash / nshard_) & mask;
+            while(v[i].p)
+                i = (i + 1) & mask;
+            v[i] = e;
+        }
+        sh.v.swap(v);
+    }
+    auto const mask = sh.v.size() - 1;
+    auto i = h & mask;
+    for(;; i = (i + 1) & mask)
+    {
+        auto const& e = sh.v[i];
+        if(! e.p)
+            break;
+        // normal forms are equal strings
+        if( e.hash == hash &&
+            e.n == s.size() &&
+            std::memcmp(e.p,
+                s.data(), s.size()) == 0)
+            return string_view(e.p, e.n);
+    }
+    // an empty URL uses no room,
+    // but a slot needs a pointer
+    char const* p = "";
+    if(! s.empty())
+    {
+        auto const d = reserve(s.size());
+        if(! d)
+        {
+            ec = error::buffer_full;
+            return {};
+        }
+        std::memcpy(d, s.data(), s.size());
+        p = d;
+    }
+    sh.v[i] = slot{ hash, p, s.size() };
+    ++sh.size;
+    size_.fetch_add(1,
+        std::memory_order_relaxed);
+    inserted = true;
+    return string_view(p, s.size());
+}
+
+string_view
+url_dedup::
+insert(
+    worker& w,
+    string_view s,
+    bool& inserted,
+    error_code& ec)
+{
+    ec = {};
+    inserted = false;
+    if(s.size() > BOOST_URL_MAX_STRING_SIZE)
+    {
+        ec = error::invalid;
+        return {};
+    }
+    // parse, normalize, and hash while
+    // the characters are in cache
+    w.u.set_encoded_url(s, ec);
+    if(ec)
+        return {};
+    w.u.normalize();
+    auto const h = hash_url(w.u);
+    return emplace(w.u.encoded_url(),
+        h, inserted, ec);
+}
+
+string_view
+url_dedup::
+insert(
+    string_view s,
+    error_code& ec)
+{
+    static thread_local worker w;
+    bool inserted;
+    return insert(w, s, inserted, ec);
+}
+
+std::size_t
+url_dedup::
+insert(
+    string_view const* first,
+    string_view const* last,
+    string_view* out,
+    error_code* ec)
+{
+    worker w;
+    std::size_t n = 0;
+    for(; first != last; ++first, ++out)
+    {
+        bool inserted;
+        error_code e;
+        *out = insert(w, *first, inserted, e);
+        if(ec)
+            *ec++ = e;
+        if(inserted)
+            ++n;
+    }
+    return n;
+}
+
+std::vector<string_view>
+url_dedup::
+values() const
+{
+    std::vector<string_view> v;
+    v.reserve(size());
+    for(std::size_t i = 0; i < nshard_; ++i)
+        for(auto const& e : shards_[i].v)
+            if(e.p)
+                v.emplace_back(e.p, e.n);
+    return v;
+}
+
+} // urls
+} // boost
+
+#endif
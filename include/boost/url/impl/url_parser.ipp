@@ -0,0 +1,607 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_URL_PARSER_IPP
+#define BOOST_URL_IMPL_URL_PARSER_IPP
+
+#include <boost/url/url_parser.hpp>
+#include <boost/url/detail/char_type.hpp>
+#include <boost/url/detail/parse.hpp>
+
+namespace boost {
+namespace urls {
+
+/*  Each state below corresponds to a place in
+    the table driven parser, which shares its
+    character classes. A byte which ends a part
+    switches to the state of the next part and
+    is examined again, so a state only needs to
+    handle the bytes of its own part. The
+    authority is scanned as userinfo until an
+    '@' or the end of the authority decides
+    what the bytes were, as in the table parser.
+*/
+
+void
+url_parser::
+mark(int id) noexcept
+{
+    pt_.offset[id + 1] = static_cast<
+        detail::parts::size_type>(pos_);
+}
+
+void
+url_parser::
+end_path() noexcept
+{
+    mark(detail::id_path);
+    pt_.nseg = static_cast<
+        detail::parts::size_type>(n_);
+}
+
+void
+url_parser::
+end_query() noexcept
+{
+    mark(detail::id_query);
+    pt_.nparam = static_cast<
+        detail::parts::size_type>(n_);
+}
+
+void
+url_parser::
+end_host() noexcept
+{
+    if(v4_.done(pt_.ip))
+        pt_.host = host_type::ipv4;
+    else if(pos_ != auth_)
+        pt_.host = host_type::name;
+    mark(detail::id_host);
+}
+
+// the authority ended without an '@'
+void
+url_parser::
+end_authority(
+    error_code& ec) noexcept
+{
+    using detail::parts;
+    pt_.offset[detail::id_user + 1] =
+        static_cast<parts::size_type>(auth_);
+    pt_.offset[detail::id_password + 1] =
+        static_cast<parts::size_type>(auth_);
+    auto colon = colon_;
+    if(colon == 0)
+        colon = pos_;
+    else if(! port_ok_)
+    {
+        ec = error::syntax;
+        return;
+    }
+    if(v4_.done(pt_.ip))
+        pt_.host = host_type::ipv4;
+    else if(colon != auth_)
+        pt_.host = host_type::name;
+    pt_.offset[detail::id_host + 1] =
+        static_cast<parts::size_type>(colon);
+    mark(detail::id_port);
+    pt_.port_number = pn_.value();
+}
+
+// Returns false if c does not belong to the URL
+bool
+url_parser::
+step(
+    char c,
+    error_code& ec) noexcept
+{
+    using namespace detail;
+    auto const cc = char_class_of(c);
+    auto const in = [cc](std::uint16_t mask)
+    {
+        return ((mask >> cc) & 1) != 0;
+    };
+    auto const escape = [this]
+    {
+        ret_ = st_;
+        st_ = state::pct1;
+    };
+    // path-abempty follows the authority,
+    // returns false if c cannot begin it
+    auto const abempty = [this, cc]
+    {
+        n_ = 0;
+        st_ = state::path;
+        return
+            cc == cc_slash ||
+            cc == cc_quest ||
+            cc == cc_hash;
+    };
+    for(;;)
+    {
+        switch(st_)
+        {
+        case state::start:
+            if(cc == cc_alpha)
+            {
+                st_ = state::scheme;
+                continue;
+            }
+            if(cc == cc_slash)
+            {
+                st_ = state::slash;
+                return true;
+            }
+            if(in(cm_pchar_nc))
+            {
+                n_ = 1;
+                st_ = state::seg_nc;
+                continue;
+            }
+            if( cc == cc_quest ||
+                cc == cc_hash)
+            {
+                st_ = state::path;
+                continue;
+            }
+            return false;
+
+        case state::scheme:
+            if(in(cm_scheme))
+            {
+                if(len_ < sizeof(buf_))
+                    buf_[len_++] = c;
+                return true;
+            }
+            if(cc == cc_colon)
+            {
+                pt_.offset[id_scheme + 1] =
+                    static_cast<parts::size_type>(
+                        pos_ + 1);
+                if(len_ < sizeof(buf_))
+                    pt_.scheme_id = string_to_scheme(
+                        string_view(buf_, len_));
+                st_ = state::after_scheme;
+                return true;
+            }
+            // the scheme characters
+            // begin a path-noscheme
+            n_ = 1;
+            st_ = state::seg_nc;
+            continue;
+
+        case state::seg_nc:
+            if(in(cm_pchar_nc))
+            {
+                if(cc == cc_pct)
+                    escape();
+                return true;
+            }
+            if(cc == cc_colon)
+                return false;
+            st_ = state::path;
+            continue;
+
+        case state::after_scheme:
+            if(cc == cc_slash)
+            {
+                st_ = state::slash;
+                return true;
+            }
+            // path-rootless
+            n_ = in(cm_pchar) ? 1 : 0;
+            st_ = state::path;
+            continue;
+
+        case state::slash:
+            if(cc == cc_slash)
+            {
+                // "//" authority
+                auth_ = pos_ + 1;
+                st_ = state::auth;
+                return true;
+            }
+            // path-absolute
+            n_ = 1;
+            st_ = state::path;
+            continue;
+
+        case state::auth:
+            if(in(cm_userinfo))
+            {
+                if(cc == cc_colon)
+                {
+                    if(colon_)
+                        port_ok_ = false;
+                    else
+                        colon_ = pos_;
+                }
+                else if(colon_)
+                {
+                    if(cc != cc_digit)
+                        port_ok_ = false;
+                    else
+                        pn_.digit(c - '0');
+                }
+                else if(cc == cc_digit)
+                {
+                    v4_.digit(c - '0');
+                }
+                else if(c == '.')
+                {
+                    v4_.dot();
+                }
+                else
+                {
+                    v4_.ok = false;
+                }
+                if(cc == cc_pct)
+                    escape();
+                return true;
+            }
+            if(cc == cc_at)
+            {
+                // userinfo "@"
+                pt_.offset[id_user + 1] =
+                    static_cast<parts::size_type>(
+                        colon_ ? colon_ : pos_);
+                pt_.offset[id_password + 1] =
+                    static_cast<parts::size_type>(
+                        pos_ + 1);
+                auth_ = pos_ + 1;
+                v4_ = ipv4_state();
+                pn_ = port_state();
+                st_ = state::host;
+                return true;
+            }
+            if( cc == cc_lbracket &&
+                pos_ == auth_)
+            {
+                mark(id_user);
+                mark(id_password);
+                len_ = 0;
+                st_ = state::ip_lit;
+                return true;
+            }
+            end_authority(ec);
+            if(ec)
+                return false;
+            if(! abempty())
+                return false;
+            continue;
+
+        case state::host:
+            if( cc == cc_lbracket &&
+                pos_ == auth_)
+            {
+                len_ = 0;
+                st_ = state::ip_lit;
+                return true;
+            }
+            if(in(cm_reg_name))
+            {
+                if(cc == cc_digit)
+                    v4_.digit(c - '0');
+                else if(c == '.')
+                    v4_.dot();
+                else
+                    v4_.ok = false;
+                if(cc == cc_pct)
+                    escape();
+                return true;
+            }
+            end_host();
+            if(cc == cc_colon)
+            {
+                st_ = state::port;
+                return true;
+            }
+            mark(id_port);
+            if(! abempty())
+                return false;
+            continue;
+
+        case state::ip_lit:
+            if(c == ']')
+            {
+                parser pr(buf_, buf_ + len_);
+                pr.parse_ip_v6(pt_.ip, ec);
+                if(! ec && ! pr.done())
+                    ec = error::syntax;
+                if(ec)
+                    return false;
+                pt_.host = host_type::ipv6;
+                pt_.offset[id_host + 1] =
+                    static_cast<parts::size_type>(
+                        pos_ + 1);
+                st_ = state::ip_end;
+                return true;
+            }
+            if(! in(cm_userinfo))
+                return false;
+            if(len_ == sizeof(buf_))
+            {
+                // too long for an IPv6address
+                ec = error::syntax;
+                return false;
+            }
+            buf_[len_++] = c;
+            return true;
+
+        case state::ip_end:
+            if(cc == cc_colon)
+            {
+                st_ = state::port;
+                return true;
+            }
+            mark(id_port);
+            if(! abempty())
+                return false;
+            continue;
+
+        case state::port:
+            if(cc == cc_digit)
+            {
+                pn_.digit(c - '0');
+                return true;
+            }
+            mark(id_port);
+            pt_.port_number = pn_.value();
+            if(! abempty())
+                return false;
+            continue;
+
+        case state::path:
+            if(in(cm_pchar))
+            {
+                if(cc == cc_pct)
+                    escape();
+                return true;
+            }
+            if(cc == cc_slash)
+            {
+                ++n_;
+                return true;
+            }
+            if(cc == cc_quest)
+            {
+                end_path();
+                n_ = 1;
+                st_ = state::qkey;
+                return true;
+            }
+            if(cc == cc_hash)
+            {
+                end_path();
+                mark(id_query);
+                st_ = state::frag;
+                return true;
+            }
+            return false;
+
+        case state::qkey:
+            if(in(cm_qkey))
+            {
+                if(cc == cc_pct)
+                    escape();
+                return true;
+            }
+            if(cc == cc_eq)
+            {
+                st_ = state::qval;
+                return true;
+            }
+            if(cc == cc_hash)
+            {
+                end_query();
+                st_ = state::frag;
+                return true;
+            }
+            return false;
+
+        case state::qval:
+            if(in(cm_qval))
+            {
+                if(cc == cc_pct)
+                    escape();
+                return true;
+            }
+            if(cc == cc_amp)
+            {
+                ++n_;
+                st_ = state::qkey;
+                return true;
+            }
+            if(cc == cc_hash)
+            {
+                end_query();
+                st_ = state::frag;
+                return true;
+            }
+            return false;
+
+        case state::frag:
+            if(in(cm_frag))
+            {
+                if(cc == cc_pct)
+                    escape();
+                return true;
+            }
+            return false;
+
+        case state::pct1:
+        case state::pct2:
+            if(static_cast<unsigned char>(
+                hex_digit(c)) > 15)
+            {
+                ec = error::bad_pct_encoding_digit;
+                return false;
+            }
+            st_ = st_ == state::pct1 ?
+                state::pct2 : ret_;
+            return true;
+
+        case state::done:
+            break;
+        }
+        return false;
+    }
+}
+
+// the URL ends at pos_
+void
+url_parser::
+close(error_code& ec) noexcept
+{
+    using namespace detail;
+    if(pos_ > BOOST_URL_MAX_STRING_SIZE)
+    {
+        ec = error::invalid;
+        return;
+    }
+    switch(st_)
+    {
+    case state::start:
+    case state::after_scheme:
+    case state::done:
+        break;
+
+    case state::scheme:
+    case state::slash:
+        n_ = 1;
+        end_path();
+        break;
+
+    case state::seg_nc:
+    case state::path:
+        end_path();
+        break;
+
+    case state::auth:
+        end_authority(ec);
+        break;
+
+    case state::host:
+        end_host();
+        mark(id_port);
+        break;
+
+    case state::ip_lit:
+        ec = error::syntax;
+        break;
+
+    case state::ip_end:
+        mark(id_port);
+        break;
+
+    case state::port:
+        mark(id_port);
+        pt_.port_number = pn_.value();
+        break;
+
+    case state::qkey:
+    case state::qval:
+        end_query();
+        break;
+
+    case state::frag:
+        mark(id_frag);
+        break;
+
+    case state::pct1:
+    case state::pct2:
+        ec = error::incomplete_pct_encoding;
+        break;
+    }
+    if(ec)
+        return;
+    // parts which are absent are
+    // empty, at the end of the previous
+    for(int i = id_user; i <= id_end; ++i)
+        if(pt_.offset[i] < pt_.offset[i - 1])
+            pt_.offset[i] = pt_.offset[i - 1];
+    st_ = state::done;
+}
+
+std::size_t
+url_parser::
+write(
+    string_view s,
+    error_code& ec) noexcept
+{
+    ec = {};
+    if(st_ == state::done)
+        return 0;
+    auto const p0 = s.data();
+    auto const end = p0 + s.size();
+    auto p = p0;
+    while(p < end)
+    {
+        switch(st_)
+        {
+        case state::seg_nc:
+        case state::path:
+        case state::qkey:
+        case state::qval:
+        case state::frag:
+        {
+            // runs of unreserved are common
+            auto const q =
+                detail::skip_unreserved(p, end);
+            pos_ += q - p;
+            p = q;
+            if(p == end)
+                continue;
+            break;
+        }
+        default:
+            break;
+        }
+        if(! step(*p, ec))
+        {
+            if(! ec)
+                close(ec);
+            return p - p0;
+        }
+        ++p;
+        ++pos_;
+    }
+    if(pos_ > BOOST_URL_MAX_STRING_SIZE)
+    {
+        ec = error::invalid;
+        return s.size();
+    }
+    ec = error::need_more;
+    return s.size();
+}
+
+void
+url_parser::
+finish(error_code& ec) noexcept
+{
+    ec = {};
+    close(ec);
+}
+
+url_view
+url_parser::
+result(string_view s) const noexcept
+{
+    BOOST_ASSERT(is_done());
+    BOOST_ASSERT(s.size() == pos_);
+    url_view v;
+    v.s_ = s.data();
+    v.pt_ = pt_;
+    return v;
+}
+
+} // urls
+} // boost
+
+#endif
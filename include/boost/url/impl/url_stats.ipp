@@ -0,0 +1,135 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_IMPL_URL_STATS_IPP
+#define BOOST_URL_IMPL_URL_STATS_IPP
+
+#include <boost/url/url_stats.hpp>
+#include <boost/url/parse.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace boost {
+namespace urls {
+
+void
+url_stats::
+count(
+    table_type& t,
+    string_view s)
+{
+    if(s.empty())
+        return;
+    tmp_.assign(s.data(), s.size());
+    auto it = t.find(tmp_);
+    if(it != t.end())
+    {
+        ++it->second;
+        return;
+    }
+    t.emplace(tmp_, 1);
+}
+
+void
+url_stats::
+insert(url_view const& u)
+{
+    ++urls_;
+    count(hosts_, u.encoded_host());
+    auto const segs = u.segments();
+    if(! segs.empty())
+        count(segs_, segs.begin()->
+            encoded_string());
+    for(auto p : u.params())
+        count(keys_, p.encoded_key());
+}
+
+bool
+url_stats::
+insert(string_view s)
+{
+    error_code ec;
+    auto const u = parse_uri(s, ec);
+    if(ec)
+    {
+        ++errors_;
+        return false;
+    }
+    insert(u);
+    return true;
+}
+
+void
+url_stats::
+insert_lines(string_view s)
+{
+    auto p = s.data();
+    auto const end = p + s.size();
+    while(p < end)
+    {
+        auto q = static_cast<char const*>(
+            std::memchr(p, '\n', end - p));
+        if(! q)
+            q = end;
+        auto n = static_cast<
+            std::size_t>(q - p);
+        if(n > 0 && p[n - 1] == '\r')
+            --n;
+        if(n > 0)
+            insert(string_view(p, n));
+        p = q + 1;
+    }
+}
+
+void
+url_stats::
+merge(url_stats const& other)
+{
+    urls_ += other.urls_;
+    errors_ += other.errors_;
+    auto const add = [](
+        table_type& t,
+        table_type const& from)
+    {
+        for(auto const& e : from)
+            t[e.first] += e.second;
+    };
+    add(hosts_, other.hosts_);
+    add(segs_, other.segs_);
+    add(keys_, other.keys_);
+}
+
+auto
+url_stats::
+top(
+    table_type const& t,
+    std::size_t n) ->
+        list_type
+{
+    list_type v(t.begin(), t.end());
+    auto const mid = v.begin() +
+        static_cast<std::ptrdiff_t>(
+            (std::min)(n, v.size()));
+    std::partial_sort(
+        v.begin(), mid, v.end(),
+        [](list_type::value_type const& a,
+            list_type::value_type const& b)
+        {
+            if(a.second != b.second)
+                return a.second > b.second;
+            return a.first < b.first;
+        });
+    v.erase(mid, v.end());
+    return v;
+}
+
+} // urls
+} // boost
+
+#endif
@@ -12,6 +12,7 @@
 
 #include <boost/url/url_view.hpp>
 #include <boost/url/error.hpp>
+#include <boost/url/detail/instrument.hpp>
 #include <boost/url/detail/parse.hpp>
 
 namespace boost {
@@ -24,6 +25,7 @@ url_view(string_view s)
     detail::parser pr(s);
     error_code ec;
     detail::parse_url(pt_, s, ec);
+    BOOST_URL_COUNT(detail::count_parse(ec));
     if(ec)
         invalid_part::raise();
 }
@@ -358,6 +360,7 @@ iterator() noexcept
     , pt_(nullptr)
     , off_(0)
     , n_(0)
+    , dn_(0)
 {
 }
 
@@ -374,6 +377,7 @@ iterator(
     {
         off_ = 0;
         n_ = 0;
+        dn_ = 0;
     }
     else if( end ||
         pt_->nseg == 0)
@@ -381,6 +385,7 @@ iterator(
         off_ = pt_->offset[
             detail::id_query];
         n_ = 0;
+        dn_ = 0;
     }
     else
     {
@@ -401,8 +406,8 @@ operator*() const noexcept ->
         s_ + off_, n_ };
     if(! s.empty() &&
         s.front() == '/')
-        s = s.substr(1);    
-    return value_type(s);
+        s = s.substr(1);
+    return value_type(s, dn_);
 }
 
 auto
@@ -414,13 +419,14 @@ operator++() noexcept ->
 {
     BOOST_ASSERT(
         off_ != pt_->offset[
-            detail::id_frag]);
+            detail::id_query]);
     off_ = off_ + n_;
     if(off_ == pt_->offset[
-        detail::id_frag])
+        detail::id_query])
     {
         // end
         n_ = 0;
+        dn_ = 0;
     }
     else
     {
@@ -446,17 +452,12 @@ operator--() noexcept ->
     while(--p > begin)
     {
         if(*p == '/')
-        {
-            off_ = p - s_;
-            parse();
-            return *this;
-        }
+            break;
     }
-    // fails for relative-uri
-    //BOOST_ASSERT(*p == '/');
-    auto const off = p - s_;
-    n_ = off_ - off;
-    off_ = off;
+    // the first segment of a relative-uri
+    // has no slash
+    off_ = p - s_;
+    parse();
     return *this;
 }
 
@@ -468,21 +469,28 @@ parse() noexcept
 {
     BOOST_ASSERT(off_ !=
         pt_->offset[
-            detail::id_frag]);
+            detail::id_query]);
     auto const end =
         s_ + pt_->offset[
-            detail::id_frag];
+            detail::id_query];
     auto const p0 = s_ + off_;
     auto p = p0;
     if(*p == '/')
         ++p;
+    auto const p1 = p;
+    // the path is valid, so each
+    // escape is three characters
+    std::size_t escapes = 0;
     while(p < end)
     {
         if(*p == '/')
             break;
+        if(*p == '%')
+            ++escapes;
         ++p;
     }
     n_ = p - p0;
+    dn_ = (p - p1) - 2 * escapes;
 }
 
 //----------------------------------------------------------
@@ -520,6 +528,8 @@ iterator() noexcept
     , off_(0)
     , nk_(0)
     , nv_(0)
+    , dk_(0)
+    , dv_(0)
 {
 }
 
@@ -537,6 +547,8 @@ iterator(
         off_ = 0;
         nk_ = 0;
         nv_ = 0;
+        dk_ = 0;
+        dv_ = 0;
     }
     else if( end ||
             pt_->nparam == 0)
@@ -545,6 +557,8 @@ iterator(
             detail::id_frag];
         nk_ = 0;
         nv_ = 0;
+        dk_ = 0;
+        dv_ = 0;
     }
     else
     {
@@ -554,6 +568,25 @@ iterator(
     }
 }
 
+url_view::
+params_type::
+iterator::
+iterator(
+    params_type const* v,
+    std::size_t off) noexcept
+    : s_(v->s_)
+    , pt_(v->pt_)
+    , off_(off)
+{
+    BOOST_ASSERT(pt_);
+    BOOST_ASSERT(
+        off_ >= pt_->offset[
+            detail::id_query] &&
+        off_ < pt_->offset[
+            detail::id_frag]);
+    parse();
+}
+
 auto
 url_view::
 params_type::
@@ -573,13 +606,13 @@ operator*() const noexcept ->
         s_ + off_ + 1,
         nk_ - 1 };
     if(nv_ == 0)
-        return { k, { } };
+        return { k, { }, dk_, 0 };
     BOOST_ASSERT(
         s_[off_ + nk_] == '=');
     string_view const v = {
         s_ + off_ + nk_ + 1,
         nv_ - 1};
-    return { k, v };
+    return { k, v, dk_, dv_ };
 }
 
 auto
@@ -601,6 +634,8 @@ operator++() noexcept ->
         // end
         nv_ = 0;
         nk_ = 0;
+        dk_ = 0;
+        dv_ = 0;
     }
     else
     {
@@ -628,14 +663,11 @@ operator--() noexcept ->
     while(--p > begin)
     {
         if(*p == '&')
-        {
-            off_ = p - s_;
-            parse();
-            return *this;
-        }
+            break;
     }
-    BOOST_ASSERT(*p == '?');
+    BOOST_ASSERT(*p == '&' || *p == '?');
     off_ = p - s_;
+    parse();
     return *this;
 }
 
@@ -649,7 +681,7 @@ parse() noexcept
     BOOST_ASSERT(pt_->nparam > 0);
     auto const end =
         s_ + pt_->offset[
-            detail::id_end];
+            detail::id_frag];
     auto p = s_ + off_;
     BOOST_ASSERT(
         ( off_ == pt_->offset[
@@ -662,21 +694,26 @@ parse() noexcept
     auto const ek =
         detail::qkey_pct_set();
     error_code ec;
-    p = ek.parse(p, end, ec);
+    std::size_t escapes = 0;
+    p = ek.parse(p, end, escapes, ec);
     BOOST_ASSERT(! ec);
     nk_ = p - p0;
+    dk_ = nk_ - 1 - 2 * escapes;
     if(p == end)
     {
         nv_ = 0;
+        dv_ = 0;
         return;
     }
     auto const ev =
         detail::qval_pct_set();
     BOOST_ASSERT(*p == '=');
     p0 = p++;
-    p = ev.parse(p, end, ec);
+    escapes = 0;
+    p = ev.parse(p, end, escapes, ec);
     BOOST_ASSERT(! ec);
     nv_ = p - p0;
+    dv_ = nv_ - 1 - 2 * escapes;
 }
 
 //----------------------------------------------------------
@@ -0,0 +1,110 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_INSTRUMENT_HPP
+#define BOOST_URL_INSTRUMENT_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/error.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+
+/** Counters of the work done by the library in one thread.
+
+    The counters are kept only when the macro
+    `BOOST_URL_INSTRUMENT` is defined, for the
+    library and for every translation unit which
+    includes it. Otherwise they are compiled out,
+    and every counter stays zero.
+
+    Each thread has its own counters, so they are
+    updated without synchronization, and a
+    snapshot shows only the work of the thread
+    which takes it.
+
+    @par Example
+    @code
+    instrument_reset();
+    url u( "http://example.com" );
+    u.set_encoded_path( "/a/much/longer/path/than/before" );
+    auto const c = instrument_snapshot();
+    std::cout << c.reallocations << " " << c.bytes_moved;
+    @endcode
+
+    @see instrument_snapshot, instrument_reset
+*/
+struct instrument_counters
+{
+    /// The number of codes which failures are counted by
+    static constexpr std::size_t error_count =
+        static_cast<std::size_t>(
+            error::need_more) + 1;
+
+    /// The number of URLs parsed, including failures
+    std::size_t parses = 0;
+
+    /// The number of URLs which failed to parse
+    std::size_t parse_failures = 0;
+
+    /** The parse failures for each code.
+
+        The failures for @ref error `e` are at index
+        `static_cast<std::size_t>(e)`. Failures whose
+        code is not an @ref error are at index zero.
+    */
+    std::size_t failures[error_count] = {};
+
+    /// The number of buffers allocated for the storage of a URL
+    std::size_t reallocations = 0;
+
+    /// The number of characters moved within the storage of a URL
+    std::size_t bytes_moved = 0;
+
+    /// The number of strings returned by the functions which decode
+    std::size_t decode_allocations = 0;
+
+    /// Return the number of parse failures with a code
+    std::size_t
+    failures_of(error e) const noexcept
+    {
+        return failures[
+            static_cast<std::size_t>(e)];
+    }
+};
+
+/** Return the counters of the calling thread.
+
+    @par Exception Safety
+
+    No-throw guarantee.
+*/
+BOOST_URL_DECL
+instrument_counters
+instrument_snapshot() noexcept;
+
+/** Set every counter of the calling thread to zero.
+
+    @par Exception Safety
+
+    No-throw guarantee.
+*/
+BOOST_URL_DECL
+void
+instrument_reset() noexcept;
+
+} // urls
+} // boost
+
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/instrument.ipp>
+#endif
+
+#endif
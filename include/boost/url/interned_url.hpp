@@ -0,0 +1,511 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_INTERNED_URL_HPP
+#define BOOST_URL_INTERNED_URL_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/origin_pool.hpp>
+#include <boost/url/url_view.hpp>
+#include <memory>
+#include <string>
+
+namespace boost {
+namespace urls {
+
+/** A URL whose origin is shared through an @ref origin_pool.
+
+    Objects of this type own the path, query, and
+    fragment of a URL, and refer to an origin stored
+    once in a pool for all of the URLs which have it.
+    The read-only accessors of @ref url_view are all
+    provided. The characters of the URL are not
+    contiguous, so @ref encoded_url returns a new
+    string; the views returned by @ref origin and
+    @ref tail are contiguous.
+
+    Objects of this type may be used concurrently
+    from multiple threads, as long as none of them
+    is modified.
+
+    @par Example
+    @code
+    origin_pool pool;
+    std::vector<interned_url> v;
+    for( auto s : lines )
+        v.emplace_back( parse_uri( s ).value(), pool );
+    @endcode
+*/
+class interned_url
+{
+    std::shared_ptr<
+        origin_pool::entry const> o_;
+    std::string t_;
+    url_view tv_;
+
+    inline
+    void
+    set_tail(
+        url_view const& u);
+
+public:
+    /** Constructor
+
+        Default constructed URLs are empty, and
+        do not refer to a pool.
+    */
+    interned_url() = default;
+
+    /** Constructor
+
+        The origin of `u` is found in, or added to,
+        the pool, and the rest of `u` is copied.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param u The URL to copy.
+
+        @param pool The pool to look up the origin in.
+    */
+    BOOST_URL_DECL
+    interned_url(
+        url_view const& u,
+        origin_pool& pool);
+
+    /** Constructor
+    */
+    BOOST_URL_DECL
+    interned_url(interned_url const& other);
+
+    /** Constructor
+    */
+    BOOST_URL_DECL
+    interned_url(interned_url&& other) noexcept;
+
+    /** Assignment
+    */
+    BOOST_URL_DECL
+    interned_url&
+    operator=(interned_url const& other);
+
+    /** Assignment
+    */
+    BOOST_URL_DECL
+    interned_url&
+    operator=(interned_url&& other) noexcept;
+
+    /** Return the number of characters in the URL.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return origin().size() + tv_.size();
+    }
+
+    /** Return `true` if both URLs refer to the same stored origin.
+    */
+    bool
+    shares_origin(
+        interned_url const& other) const noexcept
+    {
+        return o_ == other.o_;
+    }
+
+    /** Return a view of the origin.
+
+        The view refers to the characters stored
+        in the pool. It has no path, query, or
+        fragment.
+    */
+    url_view
+    origin() const noexcept
+    {
+        if(o_)
+            return o_->v;
+        return url_view();
+    }
+
+    /** Return a view of the path, query, and fragment.
+
+        The view refers to the characters owned by
+        this object. It has no scheme or authority.
+    */
+    url_view const&
+    tail() const noexcept
+    {
+        return tv_;
+    }
+
+    //------------------------------------------------------
+
+    /** Return the complete serialized URL.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    BOOST_URL_DECL
+    std::string
+    encoded_url() const;
+
+    /** Return the origin.
+    */
+    string_view
+    encoded_origin() const noexcept
+    {
+        return origin().encoded_origin();
+    }
+
+    //------------------------------------------------------
+    //
+    // scheme
+    //
+    //------------------------------------------------------
+
+    /** Return the scheme.
+    */
+    string_view
+    scheme() const noexcept
+    {
+        return origin().scheme();
+    }
+
+    /** Return the known scheme.
+    */
+    urls::scheme
+    scheme_id() const noexcept
+    {
+        return origin().scheme_id();
+    }
+
+    //------------------------------------------------------
+    //
+    // authority
+    //
+    //------------------------------------------------------
+
+    /** Return true if an authority is present.
+    */
+    bool
+    has_authority() const noexcept
+    {
+        return origin().has_authority();
+    }
+
+    /** Return the encoded authority.
+    */
+    string_view
+    encoded_authority() const noexcept
+    {
+        return origin().encoded_authority();
+    }
+
+    //------------------------------------------------------
+    //
+    // userinfo
+    //
+    //------------------------------------------------------
+
+    /** Return `true` if a userinfo is present.
+    */
+    bool
+    has_userinfo() const noexcept
+    {
+        return origin().has_userinfo();
+    }
+
+    /** Return the userinfo.
+    */
+    string_view
+    encoded_userinfo() const noexcept
+    {
+        return origin().encoded_userinfo();
+    }
+
+    /** Return the userinfo, with its trailing at sign ('@').
+    */
+    string_view
+    userinfo_part() const noexcept
+    {
+        return origin().userinfo_part();
+    }
+
+    /** Return the user, as a decoded string.
+    */
+    template<
+        class Allocator =
+            std::allocator<char>>
+    string_type<Allocator>
+    user(
+        Allocator const& a = {}) const
+    {
+        return origin().user(a);
+    }
+
+    /** Return the user, as a view of the decoded characters.
+    */
+    decoded_view
+    decoded_user() const noexcept
+    {
+        return origin().decoded_user();
+    }
+
+    /** Return the user.
+    */
+    string_view
+    encoded_user() const noexcept
+    {
+        return origin().encoded_user();
+    }
+
+    /** Return the password, as a decoded string.
+    */
+    template<
+        class Allocator =
+            std::allocator<char>>
+    string_type<Allocator>
+    password(
+        Allocator const& a = {}) const
+    {
+        return origin().password(a);
+    }
+
+    /** Return the password, as a view of the decoded characters.
+    */
+    decoded_view
+    decoded_password() const noexcept
+    {
+        return origin().decoded_password();
+    }
+
+    /** Return the password.
+    */
+    string_view
+    encoded_password() const noexcept
+    {
+        return origin().encoded_password();
+    }
+
+    //------------------------------------------------------
+    //
+    // host
+    //
+    //------------------------------------------------------
+
+    /** Return the type of host present, if any.
+    */
+    urls::host_type
+    host_type() const noexcept
+    {
+        return origin().host_type();
+    }
+
+    /** Return the IPv4 address of the host.
+    */
+    std::array<unsigned char, 4>
+    ipv4_address() const noexcept
+    {
+        return origin().ipv4_address();
+    }
+
+    /** Return the IPv6 address of the host.
+    */
+    std::array<unsigned char, 16>
+    ipv6_address() const noexcept
+    {
+        return origin().ipv6_address();
+    }
+
+    /** Return the host and port.
+    */
+    string_view
+    encoded_host_and_port() const noexcept
+    {
+        return origin().encoded_host_and_port();
+    }
+
+    /** Return the host, as a decoded string.
+    */
+    template<
+        class Allocator =
+            std::allocator<char>>
+    string_type<Allocator>
+    host(
+        Allocator const& a = {}) const
+    {
+        return origin().host(a);
+    }
+
+    /** Return the host, as a view of the decoded characters.
+    */
+    decoded_view
+    decoded_host() const noexcept
+    {
+        return origin().decoded_host();
+    }
+
+    /** Return the host.
+    */
+    string_view
+    encoded_host() const noexcept
+    {
+        return origin().encoded_host();
+    }
+
+    /** Return the port.
+    */
+    string_view
+    port() const noexcept
+    {
+        return origin().port();
+    }
+
+    /** Return the port as a number.
+    */
+    std::uint16_t
+    port_number() const noexcept
+    {
+        return origin().port_number();
+    }
+
+    /** Return the port, with its leading colon (':').
+    */
+    string_view
+    port_part() const noexcept
+    {
+        return origin().port_part();
+    }
+
+    //------------------------------------------------------
+    //
+    // path
+    //
+    //------------------------------------------------------
+
+    /** Return the encoded path.
+    */
+    string_view
+    encoded_path() const noexcept
+    {
+        return tv_.encoded_path();
+    }
+
+    /** Return the path segments as a read-only container.
+    */
+    url_view::segments_type
+    segments() const noexcept
+    {
+        return tv_.segments();
+    }
+
+    //------------------------------------------------------
+    //
+    // query
+    //
+    //------------------------------------------------------
+
+    /** Return the query, as a decoded string.
+    */
+    template<
+        class Allocator =
+            std::allocator<char>>
+    string_type<Allocator>
+    query(
+        Allocator const& a = {}) const
+    {
+        return tv_.query(a);
+    }
+
+    /** Return the query, as a view of the decoded characters.
+    */
+    decoded_view
+    decoded_query() const noexcept
+    {
+        return tv_.decoded_query();
+    }
+
+    /** Return the query.
+    */
+    string_view
+    encoded_query() const noexcept
+    {
+        return tv_.encoded_query();
+    }
+
+    /** Return the query, with its leading question mark ('?').
+    */
+    string_view
+    query_part() const noexcept
+    {
+        return tv_.query_part();
+    }
+
+    /** Return the query parameters as a read-only container.
+    */
+    url_view::params_type
+    params() const noexcept
+    {
+        return tv_.params();
+    }
+
+    //------------------------------------------------------
+    //
+    // fragment
+    //
+    //------------------------------------------------------
+
+    /** Return the fragment, as a decoded string.
+    */
+    template<
+        class Allocator =
+            std::allocator<char>>
+    string_type<Allocator>
+    fragment(
+        Allocator const& a = {}) const
+    {
+        return tv_.fragment(a);
+    }
+
+    /** Return the fragment, as a view of the decoded characters.
+    */
+    decoded_view
+    decoded_fragment() const noexcept
+    {
+        return tv_.decoded_fragment();
+    }
+
+    /** Return the fragment.
+    */
+    string_view
+    encoded_fragment() const noexcept
+    {
+        return tv_.encoded_fragment();
+    }
+
+    /** Return the fragment, with its leading hash ('#').
+    */
+    string_view
+    fragment_part() const noexcept
+    {
+        return tv_.fragment_part();
+    }
+};
+
+} // urls
+} // boost
+
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/interned_url.ipp>
+#endif
+
+#endif
@@ -0,0 +1,383 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_LAZY_URL_VIEW_HPP
+#define BOOST_URL_LAZY_URL_VIEW_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/url/detail/parts.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+
+/** A reference to a URL string, parsed on demand.
+
+    Construction finds only the boundaries of the
+    scheme, authority, path, query, and fragment,
+    using a fast search for the `'?'` and `'#'`
+    which begin the query and fragment. Each of the
+    other parts is parsed and checked the first time
+    one of its accessors is called, and the results
+    are kept, so a filter which looks only at the
+    scheme and host does not pay for the path and
+    query.
+
+    An accessor whose part is not a valid part of a
+    URL throws; the strings accepted in full are the
+    same as for @ref url_view, whose constructor
+    remains the strict mode which checks the whole
+    URL at once. The strict check is also available
+    here by calling @ref validate.
+
+    Because accessors may update the parts kept by
+    the view, a view must not be used concurrently
+    from more than one thread unless @ref validate
+    was called first.
+
+    @par Example
+    @code
+    lazy_url_view u( "https://example.com/path?q=%zz" );
+    assert( u.encoded_host() == "example.com" );
+    error_code ec;
+    u.validate( ec );
+    assert( ec == error::bad_pct_encoding_digit );
+    @endcode
+*/
+class lazy_url_view
+{
+    enum : unsigned char
+    {
+        ok_authority    = 1,
+        ok_path         = 2,
+        ok_query        = 4,
+        ok_fragment     = 8,
+        ok_all          = 15
+    };
+
+    mutable url_view v_;
+    mutable unsigned char ok_ = ok_all;
+
+    BOOST_URL_DECL
+    void
+    check(
+        int id,
+        error_code& ec) const noexcept;
+
+    BOOST_URL_DECL
+    url_view const&
+    get(int id) const;
+
+public:
+    /** Constructor
+
+        Default constructed views are empty.
+    */
+    lazy_url_view() = default;
+
+    /** Constructor
+
+        Only the boundaries of the parts of the URL,
+        and its scheme, are found.
+
+        @par Exception Safety
+
+        Throws @ref invalid_part if `s` is too large.
+
+        @param s The string to construct from. The
+        view refers to this string.
+    */
+    BOOST_URL_DECL
+    explicit
+    lazy_url_view(string_view s);
+
+    /** Check every part which was not checked yet.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+
+        @return A view of the URL, which is valid
+        only if no error occurred.
+
+        @param ec Set to the error, if the string
+        is not a valid URL.
+    */
+    BOOST_URL_DECL
+    url_view
+    validate(error_code& ec) const noexcept;
+
+    /** Check every part which was not checked yet.
+
+        @par Exception Safety
+
+        Throws @ref invalid_part if the string
+        is not a valid URL.
+
+        @return A view of the URL.
+    */
+    BOOST_URL_DECL
+    url_view
+    validate() const;
+
+    /** Return the number of characters in the URL.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return v_.size();
+    }
+
+    /** Return a pointer to the characters in the URL.
+    */
+    char const*
+    data() const noexcept
+    {
+        return v_.data();
+    }
+
+    /** Return the complete serialized URL, without checking it.
+    */
+    string_view
+    encoded_url() const
+    {
+        return v_.encoded_url();
+    }
+
+    /** Return the origin.
+    */
+    string_view
+    encoded_origin() const
+    {
+        return get(detail::id_host).encoded_origin();
+    }
+
+    //------------------------------------------------------
+    //
+    // scheme
+    //
+    //------------------------------------------------------
+
+    /** Return the scheme.
+    */
+    string_view
+    scheme() const noexcept
+    {
+        return v_.scheme();
+    }
+
+    /** Return the known scheme.
+    */
+    urls::scheme
+    scheme_id() const noexcept
+    {
+        return v_.scheme_id();
+    }
+
+    //------------------------------------------------------
+    //
+    // authority
+    //
+    //------------------------------------------------------
+
+    /** Return `true` if an authority is present.
+
+        This does not check the authority.
+    */
+    bool
+    has_authority() const noexcept
+    {
+        return v_.has_authority();
+    }
+
+    /** Return the authority.
+    */
+    string_view
+    encoded_authority() const
+    {
+        return get(detail::id_host).encoded_authority();
+    }
+
+    /** Return `true` if a userinfo is present.
+    */
+    bool
+    has_userinfo() const
+    {
+        return get(detail::id_host).has_userinfo();
+    }
+
+    /** Return the userinfo.
+    */
+    string_view
+    encoded_userinfo() const
+    {
+        return get(detail::id_host).encoded_userinfo();
+    }
+
+    /** Return the userinfo part, including the trailing '@'.
+    */
+    string_view
+    userinfo_part() const
+    {
+        return get(detail::id_host).userinfo_part();
+    }
+
+    /** Return the user.
+    */
+    string_view
+    encoded_user() const
+    {
+        return get(detail::id_host).encoded_user();
+    }
+
+    /** Return the password.
+    */
+    string_view
+    encoded_password() const
+    {
+        return get(detail::id_host).encoded_password();
+    }
+
+    /** Return the type of host present, if any.
+    */
+    urls::host_type
+    host_type() const
+    {
+        return get(detail::id_host).host_type();
+    }
+
+    /** Return the host and port.
+    */
+    string_view
+    encoded_host_and_port() const
+    {
+        return get(detail::id_host).encoded_host_and_port();
+    }
+
+    /** Return the host.
+    */
+    string_view
+    encoded_host() const
+    {
+        return get(detail::id_host).encoded_host();
+    }
+
+    /** Return the port.
+    */
+    string_view
+    port() const
+    {
+        return get(detail::id_host).port();
+    }
+
+    /** Return the port as an integer, or 0 if there is none.
+    */
+    std::uint16_t
+    port_number() const
+    {
+        return get(detail::id_host).port_number();
+    }
+
+    /** Return the port part, including the leading ':'.
+    */
+    string_view
+    port_part() const
+    {
+        return get(detail::id_host).port_part();
+    }
+
+    //------------------------------------------------------
+    //
+    // path
+    //
+    //------------------------------------------------------
+
+    /** Return the path.
+    */
+    string_view
+    encoded_path() const
+    {
+        return get(detail::id_path).encoded_path();
+    }
+
+    /** Return the path segments.
+
+        The returned view refers to this object.
+    */
+    url_view::segments_type
+    segments() const
+    {
+        return get(detail::id_path).segments();
+    }
+
+    //------------------------------------------------------
+    //
+    // query
+    //
+    //------------------------------------------------------
+
+    /** Return the query.
+    */
+    string_view
+    encoded_query() const
+    {
+        return get(detail::id_query).encoded_query();
+    }
+
+    /** Return the query part, including the leading '?'.
+    */
+    string_view
+    query_part() const
+    {
+        return get(detail::id_query).query_part();
+    }
+
+    /** Return the query parameters.
+
+        The returned view refers to this object.
+    */
+    url_view::params_type
+    params() const
+    {
+        return get(detail::id_query).params();
+    }
+
+    //------------------------------------------------------
+    //
+    // fragment
+    //
+    //------------------------------------------------------
+
+    /** Return the fragment.
+    */
+    string_view
+    encoded_fragment() const
+    {
+        return get(detail::id_frag).encoded_fragment();
+    }
+
+    /** Return the fragment part, including the leading '#'.
+    */
+    string_view
+    fragment_part() const
+    {
+        return get(detail::id_frag).fragment_part();
+    }
+};
+
+} // urls
+} // boost
+
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/lazy_url_view.ipp>
+#endif
+
+#endif
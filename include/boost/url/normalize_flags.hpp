@@ -0,0 +1,84 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_NORMALIZE_FLAGS_HPP
+#define BOOST_URL_NORMALIZE_FLAGS_HPP
+
+#include <boost/url/config.hpp>
+
+namespace boost {
+namespace urls {
+
+/** The steps performed by @ref url_base::normalize.
+
+    The values may be combined with `operator|`.
+    Each step is one of the syntax-based
+    normalizations described in rfc3986 section 6.2.2,
+    or the scheme-based port normalization of
+    section 6.2.3.
+
+    @see url_base::normalize
+*/
+enum class normalize_flags : unsigned
+{
+    /// Perform no normalization
+    none = 0,
+
+    /// Convert the scheme to lower case
+    scheme = 1,
+
+    /// Convert a registered name or IPv6 host to lower case
+    host = 2,
+
+    /// Convert the hex digits of every escape to upper case
+    pct_hex = 4,
+
+    /// Decode the escapes of unreserved characters
+    unreserved = 8,
+
+    /// Remove an empty port, or the default port of a known scheme
+    port = 16,
+
+    /// Apply remove_dot_segments to the path
+    path = 32,
+
+    /// Perform every normalization
+    all = 63
+};
+
+/// Return the union of two sets of flags
+inline
+constexpr
+normalize_flags
+operator|(
+    normalize_flags f0,
+    normalize_flags f1) noexcept
+{
+    return static_cast<normalize_flags>(
+        static_cast<unsigned>(f0) |
+        static_cast<unsigned>(f1));
+}
+
+/// Return the intersection of two sets of flags
+inline
+constexpr
+normalize_flags
+operator&(
+    normalize_flags f0,
+    normalize_flags f1) noexcept
+{
+    return static_cast<normalize_flags>(
+        static_cast<unsigned>(f0) &
+        static_cast<unsigned>(f1));
+}
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,123 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_ORIGIN_POOL_HPP
+#define BOOST_URL_ORIGIN_POOL_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/url/detail/hash.hpp>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace boost {
+namespace urls {
+
+class interned_url;
+
+/** A thread-safe table of shared URL origins.
+
+    The origin of a URL is everything before the
+    path: the scheme, and the authority if present,
+    as returned by @ref url_view::encoded_origin.
+    Each distinct origin is stored in the pool once,
+    already parsed, and every @ref interned_url
+    created from the pool refers to its stored copy.
+    When many URLs share a few origins, this stores
+    only the path, query, and fragment of each URL.
+
+    Origins remain valid for as long as some URL
+    refers to them, even after the pool is destroyed.
+    Those which are no longer referred to are removed
+    by calling @ref collect.
+
+    Member functions may be called concurrently
+    from multiple threads.
+
+    @par Example
+    @code
+    origin_pool pool;
+    interned_url u0( url_view( "https://example.com/a" ), pool );
+    interned_url u1( url_view( "https://example.com/b" ), pool );
+    assert( pool.size() == 1 );
+    assert( u0.encoded_origin().data() == u1.encoded_origin().data() );
+    @endcode
+*/
+class origin_pool
+{
+    struct entry
+    {
+        std::string s;
+        url_view v;
+    };
+
+    struct hasher
+    {
+        std::size_t
+        operator()(
+            string_view s) const noexcept
+        {
+            return detail::hash_key(s);
+        }
+    };
+
+    using map_type = std::unordered_map<
+        string_view,
+        std::shared_ptr<entry const>,
+        hasher>;
+
+    mutable std::mutex m_;
+    map_type map_;
+
+    friend class interned_url;
+
+    inline
+    std::shared_ptr<entry const>
+    intern(url_view const& u);
+
+public:
+    /** Constructor
+
+        Default constructed pools are empty.
+    */
+    origin_pool() = default;
+
+    origin_pool(origin_pool const&) = delete;
+    origin_pool& operator=(origin_pool const&) = delete;
+
+    /** Return the number of origins in the pool.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    size() const;
+
+    /** Remove the origins which no URL refers to.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+
+        @return The number of origins removed.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    collect() noexcept;
+};
+
+} // urls
+} // boost
+
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/origin_pool.ipp>
+#endif
+
+#endif
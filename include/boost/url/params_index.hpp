@@ -0,0 +1,159 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_PARAMS_INDEX_HPP
+#define BOOST_URL_PARAMS_INDEX_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/url_view.hpp>
+#include <cstdint>
+
+namespace boost {
+namespace urls {
+
+/** A hash index over the query parameters of a view.
+
+    This container allows constant-time lookup of
+    query parameters by decoded key. It is an open
+    addressing hash table of decoded-key hashes and
+    parameter offsets, stored in a buffer owned by
+    the caller, so building the index does not
+    allocate.
+
+    The index references the view it was built
+    from. The view, and the characters it references,
+    must remain valid and unchanged for as long as
+    the index is used.
+
+    @par Example
+    @code
+    url_view const u( "/path?a=1&b=2&a=3" );
+    params_index::slot buf[ params_index::slots_needed( 3 ) ];
+    params_index const idx( u.params(), buf, sizeof(buf) / sizeof(buf[0]) );
+    assert( idx.count( "a" ) == 2 );
+    assert( idx.find( "b" )->value() == "2" );
+    @endcode
+*/
+class params_index
+{
+public:
+    /// The type of each entry in the table
+    struct slot
+    {
+        std::uint32_t hash;
+        std::uint32_t off; // 0 for empty
+    };
+
+    /// The iterator type returned by find
+    using iterator =
+        url_view::params_type::iterator;
+
+private:
+    url_view::params_type p_;
+    slot* tab_;
+    std::size_t mask_;
+
+    static
+    constexpr
+    std::size_t
+    next_pow2(
+        std::size_t n,
+        std::size_t v) noexcept
+    {
+        return v >= n ? v :
+            next_pow2(n, v * 2);
+    }
+
+public:
+
+    /** Return the number of slots needed to index a query.
+
+        @param nparam The number of parameters, as
+        returned by `url_view::params_type::size`.
+    */
+    static
+    constexpr
+    std::size_t
+    slots_needed(std::size_t nparam) noexcept
+    {
+        // power of two, at most half full
+        return nparam == 0 ? 1 :
+            next_pow2(2 * nparam, 1);
+    }
+
+    /** Constructor.
+
+        @par Complexity
+
+        Linear in the size of the query.
+
+        @param p The parameters to index.
+
+        @param buf A pointer to storage for the table.
+
+        @param n The number of slots at `buf`.
+
+        @throw too_large `n` is less than
+        `slots_needed(p.size())`.
+    */
+    BOOST_URL_DECL
+    params_index(
+        url_view::params_type const& p,
+        slot* buf,
+        std::size_t n);
+
+    /// Return the parameters which are indexed
+    url_view::params_type const&
+    params() const noexcept
+    {
+        return p_;
+    }
+
+    /** Return true if a matching key exists.
+
+        @par Complexity
+
+        Constant on average.
+    */
+    BOOST_URL_DECL
+    bool
+    contains(string_view key) const noexcept;
+
+    /** Return the number of matching keys.
+
+        @par Complexity
+
+        Constant on average.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    count(string_view key) const noexcept;
+
+    /** Return the first parameter with a matching key.
+
+        If no parameter matches, `params().end()` is
+        returned.
+
+        @par Complexity
+
+        Constant on average.
+    */
+    BOOST_URL_DECL
+    iterator
+    find(string_view key) const noexcept;
+};
+
+} // urls
+} // boost
+
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/params_index.ipp>
+#endif
+
+#endif
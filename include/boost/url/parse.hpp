@@ -0,0 +1,246 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_PARSE_HPP
+#define BOOST_URL_PARSE_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/parser_kind.hpp>
+#include <boost/url/result.hpp>
+#include <boost/url/url_view.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+
+/** Parse a string as a URL.
+
+    The string is parsed as a URI-reference. On
+    success the returned view references the
+    characters of `s`, which must remain valid for
+    as long as the view is used. On failure `ec`
+    is set and a default constructed view is
+    returned. Malformed input costs no more than
+    valid input, as no exception is thrown.
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @param s The string to parse.
+
+    @param ec Set to the error, if any occurred.
+*/
+BOOST_URL_DECL
+url_view
+parse_uri(
+    string_view s,
+    error_code& ec) noexcept;
+
+/** Parse a string as a URL.
+
+    The string is parsed as a URI-reference. On
+    success the result holds a view which references
+    the characters of `s`, which must remain valid
+    for as long as the view is used. Otherwise the
+    result holds the error.
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @param s The string to parse.
+*/
+BOOST_URL_DECL
+result<url_view>
+parse_uri(
+    string_view s) noexcept;
+
+/** Parse a string as a URL.
+
+    The string is parsed as a URI-reference, using
+    the parser selected by `k`. On success the
+    returned view references the characters of
+    `s`, which must remain valid for as long as
+    the view is used. On failure `ec` is set and
+    a default constructed view is returned.
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @param s The string to parse.
+
+    @param k The parser to use.
+
+    @param ec Set to the error, if any occurred.
+*/
+BOOST_URL_DECL
+url_view
+parse_uri(
+    string_view s,
+    parser_kind k,
+    error_code& ec) noexcept;
+
+/** Check a string as a URL, without parsing it.
+
+    The string is checked as a URI-reference. It
+    is accepted exactly when @ref parse_uri would
+    accept it, and the same error is reported,
+    but nothing is stored: the characters after
+    the authority are checked in bulk, sixteen
+    at a time where SSE2 is available. This is
+    faster than parsing when only the validity
+    of a URL is needed.
+
+    @par Example
+    @code
+    error_code ec;
+    std::size_t n = validate_url( "http://example.com/a b", ec );
+    assert( ec == error::syntax );
+    assert( n == 20 );
+    @endcode
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @return The offset of the character at which
+    the error was found, or `s.size()` if the
+    string is a valid URL. For a string which is
+    too long, this is zero.
+
+    @param s The string to check.
+
+    @param ec Set to the error, if any occurred.
+*/
+BOOST_URL_DECL
+std::size_t
+validate_url(
+    string_view s,
+    error_code& ec) noexcept;
+
+/** Return true if a string is a valid URL.
+
+    This is the same as calling @ref validate_url
+    and checking the error.
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @param s The string to check.
+*/
+BOOST_URL_DECL
+bool
+is_valid_uri(
+    string_view s) noexcept;
+
+/** Parse a string as an HTTP request-target.
+
+    The string is parsed as the origin-form or the
+    absolute-form of a request-target, as defined
+    in rfc7230 section 5.3. The first is a path
+    beginning with '/' and an optional query, the
+    second an absolute URI without a fragment.
+    The authority-form and asterisk-form are not
+    accepted.
+
+    This is the same as @ref parse_uri for these
+    strings, except that a path beginning with
+    "//" in the origin-form is a path and not an
+    authority. An `http` or `https` URL with a
+    reg-name or IPv4 host is parsed in a single
+    specialized step; other URLs are parsed by
+    the general parser.
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @param s The string to parse.
+
+    @param ec Set to the error, if any occurred.
+*/
+BOOST_URL_DECL
+url_view
+parse_request_target(
+    string_view s,
+    error_code& ec) noexcept;
+
+/** Parse a string as an HTTP request-target.
+
+    The string is parsed as the origin-form or the
+    absolute-form of a request-target, as defined
+    in rfc7230 section 5.3. On success the result
+    holds a view which references the characters
+    of `s`. Otherwise the result holds the error.
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @param s The string to parse.
+*/
+BOOST_URL_DECL
+result<url_view>
+parse_request_target(
+    string_view s) noexcept;
+
+/** Parse a range of strings as URLs.
+
+    Each string in the range `[first, last)` is
+    parsed as a URI-reference, and the resulting
+    view is stored in the element of `out` with
+    the same index. No exceptions are thrown and
+    no memory is allocated; a string which fails
+    to parse produces a default constructed view.
+
+    The views reference the characters of the
+    input strings, which must remain valid for
+    as long as the views are used. Because each
+    element is parsed independently, disjoint
+    subranges of one batch may be parsed
+    concurrently by different threads.
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @return The number of strings which were
+    parsed successfully.
+
+    @param first A pointer to the first string.
+
+    @param last A pointer to one past the last string.
+
+    @param out A pointer to an array of at least
+    `last - first` views to receive the results.
+
+    @param ec A pointer to an array of at least
+    `last - first` error codes to receive the
+    result of each parse, or `nullptr`.
+*/
+BOOST_URL_DECL
+std::size_t
+parse_urls(
+    string_view const* first,
+    string_view const* last,
+    url_view* out,
+    error_code* ec) noexcept;
+
+} // urls
+} // boost
+
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/parse.ipp>
+#endif
+
+#endif
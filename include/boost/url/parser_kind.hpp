@@ -0,0 +1,41 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_PARSER_KIND_HPP
+#define BOOST_URL_PARSER_KIND_HPP
+
+#include <boost/url/config.hpp>
+
+namespace boost {
+namespace urls {
+
+/** The algorithm used to parse a URL.
+
+    Both parsers accept the same strings and
+    produce the same views. The recursive descent
+    parser follows the grammar of rfc3986 closely.
+    The table driven parser classifies each byte
+    once through a table built at compile time,
+    and never backtracks.
+
+    @see parse_uri
+*/
+enum class parser_kind
+{
+    /// The recursive descent parser, used by default
+    recursive,
+
+    /// The single-pass, table driven parser
+    table
+};
+
+} // urls
+} // boost
+
+#endif
@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_RESOLVE_HPP
+#define BOOST_URL_RESOLVE_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/url_base.hpp>
+#include <boost/url/url_view.hpp>
+
+namespace boost {
+namespace urls {
+
+/** Resolve a URL reference against a base URL.
+
+    This computes the target URL of `ref` as
+    described in rfc3986 section 5.2, using the
+    strict algorithm: a reference with a scheme
+    is never treated as relative. The path of the
+    target is merged and has its dot segments
+    removed while it is written to the storage
+    of `dest`, which is resized once. The parts
+    of the target are known from the parts of the
+    base and the reference, so the result is not
+    parsed again.
+
+    The characters of each part are copied as
+    they are; the target is not normalized. The
+    storage must be able to hold the target with
+    the merged path before its dot segments are
+    removed.
+
+    @par Example
+    @code
+    url u;
+    resolve(
+        url_view( "http://a/b/c/d;p?q" ),
+        url_view( "../g?y#s" ),
+        u );
+    assert( u.encoded_url() == "http://a/b/g?y#s" );
+    @endcode
+
+    @par Preconditions
+    Neither `base` nor `ref` refers to the
+    storage of `dest`.
+
+    @par Exception Safety
+
+    Strong guarantee.
+    Calls to allocate may throw.
+
+    @param base The base URL, which must have
+    a scheme.
+
+    @param ref The reference to resolve.
+
+    @param dest The URL to set to the target.
+
+    @param ec Set to @ref error::missing_scheme
+    if the base has no scheme, in which case
+    `dest` is unchanged.
+
+    @throw too_large The target is too large.
+
+    @see @li <a href="https://tools.ietf.org/html/rfc3986#section-5.2">5.2. Relative Resolution (rfc3986)</a>
+*/
+BOOST_URL_DECL
+void
+resolve(
+    url_view const& base,
+    url_view const& ref,
+    url_base& dest,
+    error_code& ec);
+
+/** Resolve a URL reference against a base URL.
+
+    This function behaves as the overload with
+    the error code, except that an exception is
+    thrown instead of setting the error.
+
+    @par Exception Safety
+
+    Strong guarantee.
+    Calls to allocate may throw.
+
+    @param base The base URL, which must have
+    a scheme.
+
+    @param ref The reference to resolve.
+
+    @param dest The URL to set to the target.
+
+    @throw invalid_part The base has no scheme.
+
+    @throw too_large The target is too large.
+*/
+BOOST_URL_DECL
+void
+resolve(
+    url_view const& base,
+    url_view const& ref,
+    url_base& dest);
+
+} // urls
+} // boost
+
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/resolve.ipp>
+#endif
+
+#endif
@@ -0,0 +1,184 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_RESULT_HPP
+#define BOOST_URL_RESULT_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/error.hpp>
+#include <type_traits>
+
+namespace boost {
+namespace urls {
+
+/** A value or an error.
+
+    Objects of this type hold either a value of
+    type `T`, or an error code describing why the
+    value could not be produced. It is returned by
+    the functions which report failure without
+    throwing an exception.
+
+    @tparam T The value type, which must be
+    default constructible and copyable.
+*/
+template<class T>
+class result
+{
+    T v_;
+    error_code ec_;
+
+public:
+    /// The type of value held
+    using value_type = T;
+
+    /** Constructor.
+
+        The result holds the value.
+    */
+    result(T const& v) noexcept(
+        std::is_nothrow_copy_constructible<T>::value)
+        : v_(v)
+    {
+    }
+
+    /** Constructor.
+
+        The result holds the error.
+
+        @par Preconditions
+        @code
+        ec.failed()
+        @endcode
+    */
+    result(error_code const& ec) noexcept
+        : ec_(ec)
+    {
+        BOOST_ASSERT(ec_);
+    }
+
+    /// Return true if the result holds a value
+    bool
+    has_value() const noexcept
+    {
+        return ! ec_;
+    }
+
+    /// Return true if the result holds an error
+    bool
+    has_error() const noexcept
+    {
+        return !! ec_;
+    }
+
+    /// Return true if the result holds a value
+    explicit
+    operator bool() const noexcept
+    {
+        return ! ec_;
+    }
+
+    /** Return the error.
+
+        If the result holds a value, a default
+        constructed error code is returned.
+    */
+    error_code
+    error() const noexcept
+    {
+        return ec_;
+    }
+
+    /** Return the value.
+
+        @throw system_error The result holds an error.
+    */
+    T&
+    value()
+    {
+        if(ec_)
+            BOOST_THROW_EXCEPTION(
+                system_error(ec_));
+        return v_;
+    }
+
+    /** Return the value.
+
+        @throw system_error The result holds an error.
+    */
+    T const&
+    value() const
+    {
+        if(ec_)
+            BOOST_THROW_EXCEPTION(
+                system_error(ec_));
+        return v_;
+    }
+
+    /** Return the value.
+
+        @par Preconditions
+        @code
+        this->has_value()
+        @endcode
+    */
+    T&
+    operator*() noexcept
+    {
+        BOOST_ASSERT(! ec_);
+        return v_;
+    }
+
+    /** Return the value.
+
+        @par Preconditions
+        @code
+        this->has_value()
+        @endcode
+    */
+    T const&
+    operator*() const noexcept
+    {
+        BOOST_ASSERT(! ec_);
+        return v_;
+    }
+
+    /** Return a pointer to the value.
+
+        @par Preconditions
+        @code
+        this->has_value()
+        @endcode
+    */
+    T*
+    operator->() noexcept
+    {
+        BOOST_ASSERT(! ec_);
+        return &v_;
+    }
+
+    /** Return a pointer to the value.
+
+        @par Preconditions
+        @code
+        this->has_value()
+        @endcode
+    */
+    T const*
+    operator->() const noexcept
+    {
+        BOOST_ASSERT(! ec_);
+        return &v_;
+    }
+};
+
+} // urls
+} // boost
+
+#endif
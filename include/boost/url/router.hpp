@@ -0,0 +1,299 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_ROUTER_HPP
+#define BOOST_URL_ROUTER_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/url_base.hpp>
+#include <boost/url/url_view.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+/** A table of path patterns, matched against the segments of a URL.
+
+    Each pattern is a path whose segments are
+    literals, parameters written as `{name}`, which
+    match any one segment, or a final `*`, which
+    matches one or more remaining segments. Literals
+    may contain escapes, and are compared with the
+    decoded segments of the path.
+
+    All the patterns are compiled into one trie,
+    stored as a compact array of nodes. Matching
+    follows the segments of the path down the trie,
+    preferring a literal to a parameter and a
+    parameter to a `*` at each segment, so its cost
+    depends on the depth of the path rather than on
+    the number of patterns. Matching never allocates.
+
+    Patterns are split into segments the same way
+    as the path of a URL: `"/"` is one empty segment,
+    and `"/a/"` is the segment `"a"` followed by an
+    empty segment.
+
+    @par Example
+    @code
+    router r;
+    r.insert( "/users/{id}/posts/{post}" );
+    router::match_results m;
+    assert( r.match( url_view( "/users/42/posts/7?q=1" ), m ) );
+    assert( m.route() == 0 );
+    assert( m["id"] == "42" );
+    assert( m[1] == "7" );
+    @endcode
+*/
+class router
+{
+    static constexpr std::uint32_t npos =
+        static_cast<std::uint32_t>(-1);
+
+    struct node
+    {
+        std::uint32_t edge = 0;     // first edge
+        std::uint32_t nedge = 0;    // number of edges
+        std::uint32_t param = npos; // child for {name}
+        std::uint32_t star = npos;  // route ending in *
+        std::uint32_t route = npos; // route ending here
+    };
+
+    // an edge to the child for a literal
+    struct edge
+    {
+        std::uint32_t key;          // offset in keys_
+        std::uint32_t len;
+        std::uint32_t child;
+    };
+
+    struct route_info
+    {
+        std::uint32_t name;         // first in names_
+        std::uint32_t nname;
+    };
+
+    std::vector<node> nodes_;
+    std::vector<edge> edges_;
+    std::vector<route_info> routes_;
+
+    // each name as (offset, size) in keys_
+    std::vector<std::pair<
+        std::uint32_t, std::uint32_t>> names_;
+
+    // literals and parameter names
+    std::string keys_;
+
+public:
+    class match_results;
+
+    /// The largest number of captures in a pattern
+    static constexpr std::size_t max_captures = 16;
+
+    /** Constructor
+
+        Default constructed routers have no routes.
+    */
+    BOOST_URL_DECL
+    router();
+
+    /// Return the number of routes
+    std::size_t
+    size() const noexcept
+    {
+        return routes_.size();
+    }
+
+    /** Add a route.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @return The number of the route, which is
+        the number of routes added before it.
+
+        @param pattern The path pattern to match.
+
+        @throw invalid_part The pattern is malformed,
+        or matches exactly the same paths as a route
+        which was already added.
+
+        @throw too_large The pattern has more than
+        @ref max_captures captures.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    insert(string_view pattern);
+
+    /** Match the segments of a path against the routes.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+
+        @return `true` if a route was matched.
+
+        @param segs The segments to match.
+
+        @param m Set to the route which matched and
+        its captures, if a route matched.
+    */
+    BOOST_URL_DECL
+    bool
+    match(
+        url_view::segments_type const& segs,
+        match_results& m) const noexcept;
+
+    /** Match the segments of a path against the routes.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+
+        @return `true` if a route was matched.
+
+        @param segs The segments to match.
+
+        @param m Set to the route which matched and
+        its captures, if a route matched.
+    */
+    BOOST_URL_DECL
+    bool
+    match(
+        url_base::segments_type const& segs,
+        match_results& m) const noexcept;
+
+    /** Match the path of a URL against the routes.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+
+        @return `true` if a route was matched.
+
+        @param u The URL whose path is matched.
+
+        @param m Set to the route which matched and
+        its captures, if a route matched.
+    */
+    inline
+    bool
+    match(
+        url_view const& u,
+        match_results& m) const noexcept;
+
+private:
+    BOOST_URL_DECL
+    string_view
+    key_of(edge const& e) const noexcept;
+
+    BOOST_URL_DECL
+    std::uint32_t
+    lower_bound(
+        node const& nd,
+        string_view key) const noexcept;
+
+    BOOST_URL_DECL
+    std::uint32_t
+    literal(
+        std::uint32_t k,
+        string_view key);
+
+    BOOST_URL_DECL
+    std::uint32_t
+    find(
+        node const& nd,
+        decoded_view s) const noexcept;
+
+    template<class Iterator>
+    bool
+    match(
+        std::uint32_t k,
+        Iterator it,
+        Iterator end,
+        match_results& m) const noexcept;
+};
+
+//----------------------------------------------------------
+
+/** The route matched by a router, and its captures.
+
+    Each capture is the encoded string of the
+    segment matched by a parameter or, for a final
+    `*`, of the segments it matched and the slashes
+    between them. Captures refer to the URL which
+    was matched.
+*/
+class router::match_results
+{
+    friend class router;
+
+    router const* r_ = nullptr;
+    std::size_t route_ = 0;
+    std::size_t n_ = 0;
+    string_view v_[max_captures];
+
+public:
+    /// Constructor
+    match_results() = default;
+
+    /// Return the number of the route which matched
+    std::size_t
+    route() const noexcept
+    {
+        return route_;
+    }
+
+    /// Return the number of captures
+    std::size_t
+    size() const noexcept
+    {
+        return n_;
+    }
+
+    /** Return the capture at the specified position.
+
+        @par Preconditions
+        @code
+        i < this->size()
+        @endcode
+    */
+    string_view
+    operator[](std::size_t i) const noexcept
+    {
+        return v_[i];
+    }
+
+    /** Return the capture for a parameter.
+
+        The capture for a final `*` is named `"*"`.
+
+        @return The capture, or an empty string if
+        the route has no parameter with this name.
+    */
+    BOOST_URL_DECL
+    string_view
+    operator[](string_view name) const noexcept;
+};
+
+} // urls
+} // boost
+
+#include <boost/url/impl/router.hpp>
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/router.ipp>
+#endif
+
+#endif
@@ -11,11 +11,15 @@
 #define BOOST_URL_SCHEME_HPP
 
 #include <boost/url/config.hpp>
+#include <cstdint>
 
 namespace boost {
 namespace urls {
 
 /** Identifies a special URL scheme.
+
+    Values after @ref scheme::wss identify the
+    schemes added by @ref register_scheme.
 */
 enum class scheme : unsigned char
 {
@@ -30,6 +34,19 @@ enum class scheme : unsigned char
 };
 
 /** Return the scheme for a non-normalized string, if known
+
+    The string is compared without regard to case
+    with the special schemes and the schemes added
+    by @ref register_scheme. The comparison is a
+    lookup in a perfect hash table, keyed by the
+    case-folded characters of the string read as
+    one 8-byte word, so it costs the same for every
+    string and makes one comparison.
+
+    @return The scheme, or @ref scheme::unknown if
+    the string is not a known scheme.
+
+    @param s The scheme, without the trailing colon.
 */
 BOOST_URL_DECL
 scheme
@@ -41,6 +58,84 @@ BOOST_URL_DECL
 string_view
 to_string(scheme s) noexcept;
 
+/** Return the default port of a known scheme.
+
+    The scheme of a parsed URL is kept with it, so
+    @ref url_view::scheme_id followed by this
+    function reads two values.
+
+    @return The port, or 0 if the scheme has no
+    default port or is not known.
+
+    @param s The scheme.
+*/
+BOOST_URL_DECL
+std::uint16_t
+default_port(scheme s) noexcept;
+
+/** Add a scheme to the known schemes.
+
+    After this call, the scheme is recognized by
+    @ref string_to_scheme, including by the parsers,
+    which store it in the URLs they parse. The
+    limits of the lookup table are one to eight
+    characters for each name, and 32 added schemes.
+
+    The known schemes are shared by every thread,
+    and this function is not synchronized with the
+    lookups: schemes should be added at startup,
+    before URLs are parsed on other threads. URLs
+    parsed at compile time by @ref parse_literal
+    know only the special schemes.
+
+    @par Example
+    @code
+    auto const grpc = register_scheme( "grpc", 50051 );
+    url_view u( "GRPC://example.com/svc" );
+    assert( u.scheme_id() == grpc );
+    assert( default_port( u.scheme_id() ) == 50051 );
+    @endcode
+
+    @par Exception Safety
+
+    Strong guarantee.
+
+    @return The new scheme. If the name was
+    already added with the same port, the scheme
+    added then is returned.
+
+    @param name The scheme, without the trailing
+    colon.
+
+    @param port The default port, or 0 for none.
+
+    @throw invalid_part The name is not a valid
+    scheme, is longer than eight characters, is a
+    special scheme, or was added with another port.
+
+    @throw too_large There is no room for the scheme.
+*/
+BOOST_URL_DECL
+scheme
+register_scheme(
+    string_view name,
+    std::uint16_t port);
+
+/** Return `true` if the scheme is a special scheme.
+
+    The list of special schemes is as follows:
+    ftp, file, http, https, ws, wss.
+
+    @param s The scheme to check
+*/
+inline
+bool
+is_special(scheme s) noexcept
+{
+    return static_cast<unsigned>(s) - 1 <
+        static_cast<unsigned>(scheme::wss);
+}
+
 /** Return `true` if the scheme string is a special scheme.
 
     The list of special schemes is as follows:
@@ -54,7 +149,7 @@ inline
 bool
 is_special(string_view s) noexcept
 {
-    return string_to_scheme(s) != scheme::unknown;
+    return is_special(string_to_scheme(s));
 }
 
 } // urls
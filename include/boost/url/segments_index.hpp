@@ -0,0 +1,344 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_SEGMENTS_INDEX_HPP
+#define BOOST_URL_SEGMENTS_INDEX_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/url_base.hpp>
+#include <boost/url/detail/segment_offsets.hpp>
+#include <cstdint>
+#include <iterator>
+
+namespace boost {
+namespace urls {
+
+/** An index of the path segments of a URL.
+
+    This container records the offset of every
+    path segment of a URL, providing constant-time
+    access to the segment at any position and
+    random-access iteration.
+
+    The index references the URL it was built
+    from. Modifications made through the view
+    returned by @ref segments keep the index up
+    to date. Any other change to the path, such as
+    calling `set_encoded_path` on the URL, requires
+    a call to @ref rebuild before the index is used
+    again. Changes to the other parts of the URL do
+    not invalidate the index.
+
+    @par Example
+    @code
+    url u( "/path/to/file.txt" );
+    segments_index idx( u );
+    assert( idx[1].encoded_string() == "to" );
+    idx.segments().erase( idx.begin().base() );
+    assert( idx[0].encoded_string() == "to" );
+    @endcode
+*/
+class segments_index
+{
+    url_base* v_;
+
+    // offsets of each segment relative to
+    // the path, followed by the path size
+    detail::segment_offsets off_;
+
+    std::size_t
+    path_offset() const noexcept
+    {
+        return v_->pt_.offset[
+            detail::id_path];
+    }
+
+public:
+    class iterator;
+
+    /// The type of each segment
+    using value_type =
+        url_base::segments_type::value_type;
+
+    /** Constructor.
+
+        @par Complexity
+
+        Linear in the size of the path.
+
+        @par Exception Safety
+
+        Calls to allocate may throw.
+
+        @param u The URL to index.
+    */
+    BOOST_URL_DECL
+    explicit
+    segments_index(url_base& u);
+
+    /** Rebuild the index from the URL.
+
+        @par Exception Safety
+
+        Calls to allocate may throw.
+    */
+    BOOST_URL_DECL
+    void
+    rebuild();
+
+    /// Return true if there are no segments
+    bool
+    empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    /// Return the number of segments
+    std::size_t
+    size() const noexcept
+    {
+        return off_.size();
+    }
+
+    /** Return the segment at the specified position.
+
+        @par Preconditions
+        @code
+        i < this->size()
+        @endcode
+
+        @par Complexity
+
+        Constant.
+    */
+    BOOST_URL_DECL
+    value_type
+    operator[](std::size_t i) const noexcept;
+
+    /// Return an iterator to the first segment
+    inline
+    iterator
+    begin() const noexcept;
+
+    /// Return an iterator to one past the last segment
+    inline
+    iterator
+    end() const noexcept;
+
+    /** Return a modifiable view of the segments.
+
+        Inserting, erasing or replacing segments
+        through the returned view keeps this
+        index up to date, and erasing a range no
+        longer requires scanning it to count the
+        segments removed.
+    */
+    url_base::segments_type
+    segments() noexcept
+    {
+        return url_base::segments_type(
+            *v_, off_);
+    }
+};
+
+//----------------------------------------------------------
+
+/** A random-access iterator over an index.
+*/
+class segments_index::iterator
+{
+    friend class segments_index;
+
+    segments_index const* idx_ = nullptr;
+    std::size_t i_ = 0;
+
+    iterator(
+        segments_index const* idx,
+        std::size_t i) noexcept
+        : idx_(idx)
+        , i_(i)
+    {
+    }
+
+public:
+    using iterator_category =
+        std::random_access_iterator_tag;
+
+    using value_type =
+        segments_index::value_type;
+
+    /// A pointer to an element
+    using pointer = value_type const*;
+
+    /// A reference to an element
+    using reference = value_type;
+
+    /// The difference_type for this iterator
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+
+    /** Return the segments iterator at this position.
+
+        The returned iterator may be passed to
+        the modifying functions of
+        `url_base::segments_type`.
+    */
+    BOOST_URL_DECL
+    url_base::segments_type::iterator
+    base() const noexcept;
+
+    value_type
+    operator*() const noexcept
+    {
+        return (*idx_)[i_];
+    }
+
+    value_type
+    operator->() const noexcept
+    {
+        return (*idx_)[i_];
+    }
+
+    value_type
+    operator[](difference_type n) const noexcept
+    {
+        return (*idx_)[i_ + n];
+    }
+
+    iterator&
+    operator++() noexcept
+    {
+        ++i_;
+        return *this;
+    }
+
+    iterator
+    operator++(int) noexcept
+    {
+        auto tmp = *this;
+        ++i_;
+        return tmp;
+    }
+
+    iterator&
+    operator--() noexcept
+    {
+        --i_;
+        return *this;
+    }
+
+    iterator
+    operator--(int) noexcept
+    {
+        auto tmp = *this;
+        --i_;
+        return tmp;
+    }
+
+    iterator&
+    operator+=(difference_type n) noexcept
+    {
+        i_ += n;
+        return *this;
+    }
+
+    iterator&
+    operator-=(difference_type n) noexcept
+    {
+        i_ -= n;
+        return *this;
+    }
+
+    friend
+    iterator
+    operator+(
+        iterator it,
+        difference_type n) noexcept
+    {
+        return it += n;
+    }
+
+    friend
+    iterator
+    operator+(
+        difference_type n,
+        iterator it) noexcept
+    {
+        return it += n;
+    }
+
+    friend
+    iterator
+    operator-(
+        iterator it,
+        difference_type n) noexcept
+    {
+        return it -= n;
+    }
+
+    friend
+    difference_type
+    operator-(
+        iterator a,
+        iterator b) noexcept
+    {
+        BOOST_ASSERT(a.idx_ == b.idx_);
+        return static_cast<difference_type>(
+            a.i_) - static_cast<
+                difference_type>(b.i_);
+    }
+
+    bool
+    operator==(iterator other) const noexcept
+    {
+        BOOST_ASSERT(idx_ == other.idx_);
+        return i_ == other.i_;
+    }
+
+    bool
+    operator!=(iterator other) const noexcept
+    {
+        return i_ != other.i_;
+    }
+
+    bool
+    operator<(iterator other) const noexcept
+    {
+        return i_ < other.i_;
+    }
+
+    bool
+    operator>(iterator other) const noexcept
+    {
+        return i_ > other.i_;
+    }
+
+    bool
+    operator<=(iterator other) const noexcept
+    {
+        return i_ <= other.i_;
+    }
+
+    bool
+    operator>=(iterator other) const noexcept
+    {
+        return i_ >= other.i_;
+    }
+};
+
+} // urls
+} // boost
+
+#include <boost/url/impl/segments_index.hpp>
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/segments_index.ipp>
+#endif
+
+#endif
@@ -0,0 +1,254 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_SERIALIZE_HPP
+#define BOOST_URL_SERIALIZE_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/url_view.hpp>
+#include <cstddef>
+#include <string>
+
+namespace boost {
+namespace urls {
+
+/** The version of the format written by @ref serialize_url
+
+    The version is written once, by
+    @ref serialize_header, at the beginning of
+    a buffer holding any number of records.
+*/
+constexpr unsigned serialized_url_version = 1;
+
+/** Append the header of a buffer of serialized URLs.
+
+    The header is the four bytes `"\x89URL"`
+    followed by one byte holding
+    @ref serialized_url_version.
+
+    @par Exception Safety
+
+    Strong guarantee.
+    Calls to allocate may throw.
+
+    @param dest The string to append to.
+*/
+BOOST_URL_DECL
+void
+serialize_header(std::string& dest);
+
+/** Check and remove the header of a buffer of serialized URLs.
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @param buf The buffer. On success, the header
+    is removed from the front.
+
+    @param ec Set to @ref error::need_more if the
+    buffer is shorter than a header, to
+    @ref error::bad_serialized_url if it does not
+    begin with a header, or to
+    @ref error::unsupported_version if the header
+    is for another version of the format.
+*/
+BOOST_URL_DECL
+void
+deserialize_header(
+    string_view& buf,
+    error_code& ec) noexcept;
+
+/** Return the size of the record @ref serialize_url writes for a URL.
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @param u The URL.
+*/
+BOOST_URL_DECL
+std::size_t
+serialized_size(
+    url_view const& u) noexcept;
+
+/** Write the record for a URL.
+
+    The record holds the encoded URL together with
+    the result of parsing it: the lengths of its
+    parts, its host type and address, its port
+    number, and its numbers of segments and params,
+    as little-endian base-128 varints. It ends with
+    a 32-bit check value of its bytes. A record may
+    be read back by @ref deserialize_url without
+    parsing the URL again.
+
+    @par Preconditions
+    `dest` points to at least
+    `serialized_size( u )` characters.
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @return A pointer to one past the last
+    character written.
+
+    @param u The URL to write.
+
+    @param dest The characters to write to.
+*/
+BOOST_URL_DECL
+char*
+serialize_url(
+    url_view const& u,
+    char* dest) noexcept;
+
+/** Append the record for a URL.
+
+    @par Exception Safety
+
+    Strong guarantee.
+    Calls to allocate may throw.
+
+    @param u The URL to write.
+
+    @param dest The string to append to.
+*/
+BOOST_URL_DECL
+void
+serialize_url(
+    url_view const& u,
+    std::string& dest);
+
+/** Read the record for a URL.
+
+    The record at the front of `buf` is checked
+    and removed, and a view of its URL is
+    returned. The view refers to the characters
+    of the buffer, which is typically a mapped
+    file, so nothing is copied and the URL is not
+    parsed again. Instead the check value of the
+    record is compared, and the lengths of the
+    parts are checked against the buffer and the
+    delimiters which begin or end each part.
+
+    The check value finds accidental damage, not
+    tampering, and the escapes inside the parts are
+    not checked again. A record which was not
+    written by @ref serialize_url but has a correct
+    check value can produce a view whose decoding
+    functions read past the end of a part. Records
+    should come from trusted storage; others can
+    be read with the overload which checks the
+    escapes.
+
+    @par Example
+    @code
+    std::string s;
+    serialize_header( s );
+    serialize_url( url_view( "http://example.com/a?b" ), s );
+
+    string_view buf = s;
+    error_code ec;
+    deserialize_header( buf, ec );
+    url_view u = deserialize_url( buf, ec );
+    assert( u.encoded_path() == "/a" );
+    assert( buf.empty() );
+    @endcode
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @return A view of the URL, which refers to
+    the characters of `buf` and is valid only
+    if no error occurred.
+
+    @param buf The buffer. On success, the
+    record is removed from the front.
+
+    @param ec Set to @ref error::need_more if the
+    buffer ends before the record, or to
+    @ref error::bad_serialized_url if the record
+    is corrupt. In both cases `buf` is unchanged.
+*/
+BOOST_URL_DECL
+url_view
+deserialize_url(
+    string_view& buf,
+    error_code& ec) noexcept;
+
+/** Read the record for a URL, checking its escapes.
+
+    This function behaves as the overload without
+    `check_escapes`, except that when it is `true`
+    every part which can be decoded is scanned, and
+    @ref error::bad_serialized_url is reported if a
+    `'%'` does not begin an escape of two hex digits
+    within the part. This makes the view safe to
+    decode when the record comes from storage which
+    is not trusted, at the cost of one pass over
+    the characters.
+
+    @par Exception Safety
+
+    No-throw guarantee.
+
+    @return A view of the URL, which refers to
+    the characters of `buf` and is valid only
+    if no error occurred.
+
+    @param buf The buffer. On success, the
+    record is removed from the front.
+
+    @param ec Set to the error, if any occurred.
+    On failure `buf` is unchanged.
+
+    @param check_escapes `true` to check the
+    escapes in the parts.
+*/
+BOOST_URL_DECL
+url_view
+deserialize_url(
+    string_view& buf,
+    error_code& ec,
+    bool check_escapes) noexcept;
+
+/** Read the record for a URL.
+
+    This function behaves as the overload with
+    the error code, except that an exception is
+    thrown on failure.
+
+    @par Exception Safety
+
+    Throws @ref invalid_part if the buffer does
+    not begin with a whole, valid record.
+
+    @return A view of the URL, which refers to
+    the characters of `buf`.
+
+    @param buf The buffer. The record is removed
+    from the front.
+*/
+BOOST_URL_DECL
+url_view
+deserialize_url(
+    string_view& buf);
+
+} // urls
+} // boost
+
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/serialize.ipp>
+#endif
+
+#endif
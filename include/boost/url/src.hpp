@@ -24,8 +24,24 @@ in a translation unit of the program.
 #endif
 
 #include <boost/url/impl/url_base.ipp>
+#include <boost/url/impl/decoded_view.ipp>
 #include <boost/url/impl/error.ipp>
+#include <boost/url/impl/hash.ipp>
+#include <boost/url/impl/idna.ipp>
+#include <boost/url/impl/instrument.ipp>
+#include <boost/url/impl/interned_url.ipp>
+#include <boost/url/impl/lazy_url_view.ipp>
+#include <boost/url/impl/origin_pool.ipp>
+#include <boost/url/impl/parse.ipp>
+#include <boost/url/impl/params_index.ipp>
+#include <boost/url/impl/resolve.ipp>
+#include <boost/url/impl/router.ipp>
 #include <boost/url/impl/scheme.ipp>
+#include <boost/url/impl/segments_index.ipp>
+#include <boost/url/impl/serialize.ipp>
+#include <boost/url/impl/url_dedup.ipp>
+#include <boost/url/impl/url_parser.ipp>
+#include <boost/url/impl/url_stats.ipp>
 #include <boost/url/impl/url_view.ipp>
 
 #endif
@@ -11,36 +11,101 @@
 #define BOOST_URL_STATIC_POOL_HPP
 
 #include <boost/url/config.hpp>
+#include <cstdint>
 #include <cstdlib>
+#include <new>
+#include <type_traits>
 
 namespace boost {
 namespace urls {
 
+/** A monotonic arena which allocates from a buffer.
+
+    Memory is handed out from a caller-provided buffer
+    by moving a pointer forward. Deallocating the most
+    recent allocation moves the pointer back, and an
+    allocation at the top of the arena may be extended
+    in place. Other deallocations do nothing until
+    @ref reset is called.
+
+    When a nonzero upstream block size is given, a full
+    buffer is followed by blocks obtained from the global
+    `operator new`, which are freed by @ref reset or by
+    the destructor. Otherwise an allocation which does
+    not fit throws `std::bad_alloc`.
+
+    Objects of this type are not thread-safe; the
+    intended use is one arena per thread, reset at the
+    end of each request cycle.
+*/
 class basic_static_pool
 {
+    // header of an upstream block
+    struct block
+    {
+        block* next;
+    };
+
     char* const base_;
     std::size_t const capacity_;
+    std::size_t const block_size_;
+    block* blocks_ = nullptr;
     char* top_;
+    char* end_;
 
     template<class T>
     friend class allocator_type;
 
-    void*
-    allocate(
+    static
+    char*
+    align_up(
+        char* p,
+        std::size_t align) noexcept
+    {
+        auto const u0 = std::uintptr_t(p);
+        return reinterpret_cast<char*>(
+            align * ((u0 + align - 1) / align));
+    }
+
+    void
+    grow(
         std::size_t bytes,
         std::size_t align)
     {
-        auto const u0 = std::uintptr_t(top_);
-        auto const u = align * (
-            (u0 + align - 1) / align);
-        auto const p =
-            reinterpret_cast<char*>(u);
-        if( u < u0 || bytes >
-            capacity_ - (p - base_))
+        auto const min =
+            sizeof(block) + align + bytes;
+        if( block_size_ == 0 ||
+            bytes > static_cast<std::size_t>(
+                -1) - sizeof(block) - align)
             BOOST_THROW_EXCEPTION(
                 std::bad_alloc());
+        auto const n =
+            block_size_ < min ?
+                min : block_size_;
+        auto const b = reinterpret_cast<
+            block*>(::operator new(n));
+        b->next = blocks_;
+        blocks_ = b;
         top_ = reinterpret_cast<
-            char*>(p + bytes);
+            char*>(b + 1);
+        end_ = reinterpret_cast<
+            char*>(b) + n;
+    }
+
+    void*
+    allocate(
+        std::size_t bytes,
+        std::size_t align)
+    {
+        auto p = align_up(top_, align);
+        if( p < top_ || p > end_ ||
+            bytes > static_cast<
+                std::size_t>(end_ - p))
+        {
+            grow(bytes, align);
+            p = align_up(top_, align);
+        }
+        top_ = p + bytes;
         return p;
     }
 
@@ -50,9 +115,29 @@ class basic_static_pool
         std::size_t bytes,
         std::size_t align) noexcept
     {
-        (void)p;
-        (void)bytes;
         (void)align;
+        // LIFO rollback
+        if(static_cast<char*>(p) +
+                bytes == top_)
+            top_ = static_cast<char*>(p);
+    }
+
+    bool
+    extend(
+        void* p,
+        std::size_t bytes,
+        std::size_t new_bytes) noexcept
+    {
+        auto const c =
+            static_cast<char*>(p);
+        if( c + bytes != top_ ||
+            new_bytes < bytes ||
+            new_bytes - bytes >
+                static_cast<std::size_t>(
+                    end_ - top_))
+            return false;
+        top_ = c + new_bytes;
+        return true;
     }
 
 public:
@@ -64,6 +149,17 @@ public:
         template<class U>
         friend class allocator_type;
 
+        bool
+        extend(
+            T* p,
+            std::size_t n,
+            std::size_t new_n) noexcept
+        {
+            return pool_->extend(p,
+                n * sizeof(T),
+                new_n * sizeof(T));
+        }
+
     public:
         using is_always_equal = std::false_type;
         using value_type = T;
@@ -119,6 +215,24 @@ public:
                 alignof(T));
         }
 
+        /** Extend the allocation at p in place.
+
+            Returns `true` if the `n` objects at `p`
+            were the most recent allocation and there
+            was room for `new_n` objects, in which
+            case `p` now refers to `new_n` objects.
+        */
+        friend
+        bool
+        try_extend(
+            allocator_type& a,
+            pointer p,
+            size_type n,
+            size_type new_n) noexcept
+        {
+            return a.extend(p, n, new_n);
+        }
+
         template<class U>
         bool
         operator==(allocator_type<U> const& other) const noexcept
@@ -134,13 +248,66 @@ public:
         }
     };
 
+    basic_static_pool(
+        basic_static_pool const&) = delete;
+
+    basic_static_pool& operator=(
+        basic_static_pool const&) = delete;
+
+    /** Constructor.
+
+        @param buffer The storage to allocate from.
+
+        @param size The size of the buffer in bytes.
+
+        @param upstream_block_size The size of each
+        block obtained from `operator new` once the
+        buffer is full. Zero, the default, means no
+        blocks are obtained.
+    */
     basic_static_pool(
         char* buffer,
-        std::size_t size)
+        std::size_t size,
+        std::size_t upstream_block_size = 0) noexcept
         : base_(buffer)
         , capacity_(size)
+        , block_size_(upstream_block_size)
         , top_(buffer)
+        , end_(buffer + size)
+    {
+    }
+
+    ~basic_static_pool()
     {
+        release();
+    }
+
+    /** Release all allocated memory.
+
+        All memory obtained from the arena becomes
+        available again. Upstream blocks are freed.
+        No allocated memory may be in use.
+
+        @par Complexity
+
+        Constant, plus the number of upstream blocks.
+    */
+    void
+    reset() noexcept
+    {
+        release();
+        top_ = base_;
+        end_ = base_ + capacity_;
+    }
+
+    /// Return the number of bytes in use in the current block
+    std::size_t
+    used() const noexcept
+    {
+        if(blocks_)
+            return top_ - reinterpret_cast<
+                char const*>(blocks_ + 1);
+        return top_ - base_;
     }
 
     allocator_type<char>
@@ -148,6 +315,18 @@ public:
     {
         return allocator_type<char>(*this);
     }
+private:
+    void
+    release() noexcept
+    {
+        while(blocks_)
+        {
+            auto const next =
+                blocks_->next;
+            ::operator delete(blocks_);
+            blocks_ = next;
+        }
+    }
 };
 
 template<std::size_t N>
@@ -156,8 +335,11 @@ class static_pool : public basic_static_pool
     char buf_[N];
 
 public:
-    static_pool()
-        : basic_static_pool(buf_, N)
+    explicit
+    static_pool(
+        std::size_t upstream_block_size = 0) noexcept
+        : basic_static_pool(buf_, N,
+            upstream_block_size)
     {
     }
 };
@@ -12,43 +12,118 @@
 
 #include <boost/url/config.hpp>
 #include <boost/url/url_base.hpp>
+#include <boost/url/detail/storage.hpp>
 #include <cstdlib>
-#include <utility>
+#include <cstring>
 
 namespace boost {
 namespace urls {
 
+/** A URL stored in an inline buffer.
+
+    Objects of this type hold a URL of at most `N`
+    characters inside the object itself. No memory
+    is ever allocated. Any operation which would
+    make the URL longer than `N` characters throws
+    @ref too_large, leaving the URL unchanged.
+
+    @par Example
+    @code
+    static_url< 1024 > u( "https://www.example.com/index.htm" );
+    u.set_encoded_query( "id=42" );
+    @endcode
+
+    @tparam N The maximum number of characters,
+    not including the null terminator.
+*/
 template<std::size_t N>
 class static_url
-    : public url_base
+    : private detail::static_storage_member<N>
+    , public url_base
 {
-    char buf_[N + 1];
-
 public:
-    template<class... Args>
+    /// The maximum number of characters
+    static constexpr std::size_t static_capacity = N;
+
+    /** Return the maximum number of characters.
+
+        This is the same value returned by
+        @ref capacity, available at compile time.
+    */
+    static
+    constexpr
+    std::size_t
+    max_size() noexcept
+    {
+        return N;
+    }
+
+    /** Constructor.
+
+        Default constructed URLs are empty.
+    */
+    static_url() noexcept
+        : url_base(this->st_)
+    {
+    }
+
+    /** Construct a parsed URL.
+
+        @throw std::exception parse error.
+
+        @throw too_large `s.size() > N`
+
+        @param s The URL to parse.
+    */
     explicit
-    static_url(Args&&... args)
-        : url_base(
-            std::forward<Args>(args)...)
+    static_url(
+        string_view s)
+        : url_base(this->st_, s)
     {
-        // VFALCO TODO
     }
 
+    /** Constructor.
+
+        The buffer and the offsets of the parts
+        are copied; nothing is parsed.
+    */
     static_url(
-        static_url const&) noexcept
+        static_url const& u) noexcept
+        : detail::static_storage_member<N>()
+        , url_base(this->st_)
     {
-        // VFALCO TODO
+        copy(u);
     }
 
+    /** Assignment.
+
+        The buffer and the offsets of the parts
+        are copied; nothing is parsed.
+    */
     static_url&
     operator=(
-        static_url const&) noexcept
+        static_url const& u) noexcept
     {
-        // VFALCO TODO
+        if(this != &u)
+            copy(u);
         return *this;
     }
+
+private:
+    void
+    copy(static_url const& u) noexcept
+    {
+        // cannot throw, u.size() <= N
+        s_ = this->st_.resize(u.size());
+        std::memcpy(s_,
+            u.data(), u.size());
+        pt_ = u.pt_;
+    }
 };
 
+template<std::size_t N>
+constexpr std::size_t static_url<N>::static_capacity;
+
 } // urls
 } // boost
 
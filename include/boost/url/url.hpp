@@ -19,6 +19,31 @@ namespace urls {
 
 using url = basic_url<std::allocator<char>>;
 
+/** A URL whose buffer is never larger than needed.
+
+    Each change which makes the URL longer
+    reallocates to exactly the new size. This
+    suits URLs which are built once and then
+    kept, such as the entries of a cache.
+
+    @see exact_growth
+*/
+using exact_url = basic_url<
+    std::allocator<char>, exact_growth>;
+
+#ifdef BOOST_URL_HAS_PMR
+/** A URL which allocates from a memory resource.
+
+    @par Example
+    @code
+    std::pmr::monotonic_buffer_resource mr;
+    pmr_url u( "http://example.com/index.htm", &mr );
+    @endcode
+*/
+using pmr_url = basic_url<
+    std::pmr::polymorphic_allocator<char>>;
+#endif
+
 } // urls
 } // boost
 
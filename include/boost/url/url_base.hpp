@@ -11,10 +11,18 @@
 #define BOOST_URL_URL_BASE_HPP
 
 #include <boost/url/config.hpp>
+#include <boost/url/components.hpp>
+#include <boost/url/decoded_view.hpp>
+#include <boost/url/normalize_flags.hpp>
 #include <boost/url/url_view.hpp>
 #include <boost/url/detail/char_type.hpp>
 #include <boost/url/detail/parts.hpp>
+#include <boost/url/detail/segment_offsets.hpp>
 #include <boost/url/detail/storage.hpp>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
 #include <memory>
 #include <string>
 #include <utility>
@@ -22,6 +30,8 @@
 namespace boost {
 namespace urls {
 
+class segments_index;
+
 /** A modifiable container for a URL.
 
     Objects of this type hold URLs which may be
@@ -47,18 +57,27 @@ class url_base
 {
     friend class url_view::segments_type;
     friend class url_view::params_type;
+    friend class segments_index;
 
     detail::storage& a_;
     detail::parts pt_;
     char* s_ = nullptr;
 
 private:
-    template<class Allocator>
+    template<class, class>
     friend class basic_url;
 
     template<std::size_t>
     friend class static_url;
 
+    friend
+    void
+    resolve(
+        url_view const& base,
+        url_view const& ref,
+        url_base& dest,
+        error_code& ec);
+
     /** Construct an empty URL with the specified storage.
     */
     BOOST_URL_DECL
@@ -128,6 +147,57 @@ public:
         return a_.capacity();
     }
 
+    /** Increase the capacity to at least the specified number of characters.
+
+        After this call, changes which leave the URL
+        no longer than `n` characters do not cause a
+        reallocation. The characters of the URL are
+        unchanged.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param n The number of characters to reserve.
+
+        @throw too_large `n` is larger than the
+        largest URL, or than the capacity of a URL
+        whose storage cannot grow.
+    */
+    BOOST_URL_DECL
+    void
+    reserve(std::size_t n);
+
+    /** Reduce the capacity to the size of the URL.
+
+        Storage which cannot be reallocated, such as
+        that of a @ref static_url, is left as it is.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    BOOST_URL_DECL
+    void
+    shrink_to_fit();
+
+    /** Return a read-only view of the URL.
+
+        The view refers to the characters of this
+        object, and remains valid until the URL is
+        modified or destroyed. This allows a URL to
+        be passed to any function which accepts a
+        @ref url_view.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    BOOST_URL_DECL
+    operator url_view() const noexcept;
+
     //------------------------------------------------------
 
     /** Return the URL.
@@ -177,6 +247,74 @@ public:
     set_encoded_url(
         string_view s);
 
+    /** Set the URL, reporting errors through `ec`.
+
+        This function behaves as the overload without
+        the error code, except that when the string
+        is invalid, `ec` is set and the URL is
+        unchanged instead of throwing an exception.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_encoded_url(
+        string_view s,
+        error_code& ec);
+
+    /** Set the URL from its parts.
+
+        All of the parts are validated first. The
+        size of the result is then calculated, the
+        storage is resized once, and each part is
+        written in order. This is faster than calling
+        the individual setters one after another.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param c The parts to set.
+
+        @throw std::exception a part is invalid.
+
+        @see components
+    */
+    BOOST_URL_DECL
+    url_base&
+    assign(
+        components const& c);
+
+    /** Set the URL from its parts, reporting errors through `ec`.
+
+        This function behaves as the overload without
+        the error code, except that when a part is
+        invalid, `ec` is set and the URL is unchanged
+        instead of throwing an exception.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param c The parts to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    assign(
+        components const& c,
+        error_code& ec);
+
     /** Set the origin to the specified value.
 
         The origin consists of the everything from the
@@ -197,6 +335,28 @@ public:
     set_encoded_origin(
         string_view s);
 
+    /** Set the origin, reporting errors through `ec`.
+
+        This function behaves as the overload without
+        the error code, except that when the string
+        is invalid, `ec` is set and the URL is
+        unchanged instead of throwing an exception.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_encoded_origin(
+        string_view s,
+        error_code& ec);
+
     //------------------------------------------------------
     //
     // scheme
@@ -217,6 +377,28 @@ public:
     string_view
     scheme() const noexcept;
 
+    /** Return the known scheme, if any.
+
+        This returns the scheme as an enumeration,
+        computed when the scheme was parsed or set.
+        Schemes which are not known, and URLs without
+        a scheme, return @ref scheme::unknown.
+
+        @par Example
+        @code
+        assert( url( "HTTPS://example.com" ).scheme_id() == scheme::https );
+        @endcode
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    urls::scheme
+    scheme_id() const noexcept
+    {
+        return pt_.scheme_id;
+    }
+
     /** Set the scheme.
 
         This function sets the scheme to the specified
@@ -250,6 +432,28 @@ public:
     url_base&
     set_scheme(string_view s);
 
+    /** Set the scheme, reporting errors through `ec`.
+
+        This function behaves as the overload without
+        the error code, except that when the string
+        is invalid, `ec` is set and the URL is
+        unchanged instead of throwing an exception.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_scheme(
+        string_view s,
+        error_code& ec);
+
     //------------------------------------------------------
     //
     // authority
@@ -303,6 +507,28 @@ public:
     set_encoded_authority(
         string_view s);
 
+    /** Set the authority, reporting errors through `ec`.
+
+        This function behaves as the overload without
+        the error code, except that when the string
+        is invalid, `ec` is set and the URL is
+        unchanged instead of throwing an exception.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_encoded_authority(
+        string_view s,
+        error_code& ec);
+
     //------------------------------------------------------
     //
     // userinfo
@@ -389,6 +615,28 @@ public:
     set_encoded_userinfo(
         string_view s);
 
+    /** Set the userinfo, reporting errors through `ec`.
+
+        This function behaves as the overload without
+        the error code, except that when the string
+        is invalid, `ec` is set and the URL is
+        unchanged instead of throwing an exception.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_encoded_userinfo(
+        string_view s,
+        error_code& ec);
+
     /** Set the userinfo.
 
         Sets the userinfo of the URL to the given
@@ -428,6 +676,28 @@ public:
     set_userinfo_part(
         string_view s);
 
+    /** Set the userinfo part, reporting errors through `ec`.
+
+        This function behaves as the overload without
+        the error code, except that when the string
+        is invalid, `ec` is set and the URL is
+        unchanged instead of throwing an exception.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_userinfo_part(
+        string_view s,
+        error_code& ec);
+
     /** Return the user.
 
         This function returns the user portion of
@@ -461,6 +731,39 @@ public:
             encoded_user(), a);
     }
 
+#ifdef BOOST_URL_HAS_PMR
+    /** Return the user, using a memory resource.
+
+        The returned string allocates from `mr`.
+    */
+    template<class MemoryResource, class =
+        detail::enable_if_memory_resource<
+            MemoryResource>>
+    std::pmr::string
+    user(
+        MemoryResource* mr) const
+    {
+        return user(std::pmr::
+            polymorphic_allocator<char>(mr));
+    }
+#endif
+
+    /** Return the user as a view of decoded characters.
+
+        The returned view refers to the underlying
+        string, and never allocates.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    decoded_view
+    decoded_user() const noexcept
+    {
+        return decoded_view(
+            encoded_user());
+    }
+
     /** Return the user.
 
         This function returns the user portion of
@@ -540,6 +843,28 @@ public:
     set_encoded_user(
         string_view s);
 
+    /** Set the user, reporting errors through `ec`.
+
+        This function behaves as the overload without
+        the error code, except that when the string
+        is invalid, `ec` is set and the URL is
+        unchanged instead of throwing an exception.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_encoded_user(
+        string_view s,
+        error_code& ec);
+
     /** Return the password.
 
         @par Exception Safety
@@ -566,6 +891,39 @@ public:
             encoded_password(), a);
     }
 
+#ifdef BOOST_URL_HAS_PMR
+    /** Return the password, using a memory resource.
+
+        The returned string allocates from `mr`.
+    */
+    template<class MemoryResource, class =
+        detail::enable_if_memory_resource<
+            MemoryResource>>
+    std::pmr::string
+    password(
+        MemoryResource* mr) const
+    {
+        return password(std::pmr::
+            polymorphic_allocator<char>(mr));
+    }
+#endif
+
+    /** Return the password as a view of decoded characters.
+
+        The returned view refers to the underlying
+        string, and never allocates.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    decoded_view
+    decoded_password() const noexcept
+    {
+        return decoded_view(
+            encoded_password());
+    }
+
     /** Return the password.
 
         This function returns the password portion of
@@ -664,6 +1022,28 @@ public:
     set_encoded_password(
         string_view s);
 
+    /** Set the password, reporting errors through `ec`.
+
+        This function behaves as the overload without
+        the error code, except that when the string
+        is invalid, `ec` is set and the URL is
+        unchanged instead of throwing an exception.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_encoded_password(
+        string_view s,
+        error_code& ec);
+
     /** Set the password.
 
         The password part is set to the encoded string
@@ -700,6 +1080,28 @@ public:
     set_password_part(
         string_view s);
 
+    /** Set the password part, reporting errors through `ec`.
+
+        This function behaves as the overload without
+        the error code, except that when the string
+        is invalid, `ec` is set and the URL is
+        unchanged instead of throwing an exception.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_password_part(
+        string_view s,
+        error_code& ec);
+
     //------------------------------------------------------
     //
     // host
@@ -718,6 +1120,52 @@ public:
         return pt_.host;
     }
 
+    /** Return the IPv4 address of the host.
+
+        If @ref host_type returns @ref host_type::ipv4,
+        this returns the four bytes of the address in
+        network byte order, decoded when the host was
+        parsed. Otherwise all of the bytes are zero.
+
+        @par Example
+        @code
+        url u( "http://192.168.0.1/" );
+        assert( u.ipv4_address()[0] == 192 );
+        @endcode
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    std::array<unsigned char, 4>
+    ipv4_address() const noexcept
+    {
+        std::array<unsigned char, 4> a{};
+        if(pt_.host == urls::host_type::ipv4)
+            std::memcpy(a.data(), pt_.ip, 4);
+        return a;
+    }
+
+    /** Return the IPv6 address of the host.
+
+        If @ref host_type returns @ref host_type::ipv6,
+        this returns the sixteen bytes of the address
+        in network byte order, decoded when the host
+        was parsed. Otherwise all of the bytes are zero.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    std::array<unsigned char, 16>
+    ipv6_address() const noexcept
+    {
+        std::array<unsigned char, 16> a{};
+        if(pt_.host == urls::host_type::ipv6)
+            std::memcpy(a.data(), pt_.ip, 16);
+        return a;
+    }
+
     /** Return the host and port.
 
         This function returns the encoded host and port,
@@ -771,6 +1219,39 @@ public:
             encoded_host(), a);
     }
 
+#ifdef BOOST_URL_HAS_PMR
+    /** Return the host, using a memory resource.
+
+        The returned string allocates from `mr`.
+    */
+    template<class MemoryResource, class =
+        detail::enable_if_memory_resource<
+            MemoryResource>>
+    std::pmr::string
+    host(
+        MemoryResource* mr) const
+    {
+        return host(std::pmr::
+            polymorphic_allocator<char>(mr));
+    }
+#endif
+
+    /** Return the host as a view of decoded characters.
+
+        The returned view refers to the underlying
+        string, and never allocates.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    decoded_view
+    decoded_host() const noexcept
+    {
+        return decoded_view(
+            encoded_host());
+    }
+
     /** Return the host.
 
         This function returns the host portion of
@@ -810,10 +1291,19 @@ public:
         @ref host_type will return
         @ref host_type::ipvfuture, else
 
+        @li If the string contains characters beyond
+        ASCII and is a host name which
+        @ref idna_to_ascii can convert, the host is
+        set to its ASCII form, such as
+        `"xn--bcher-kva.example"`, else
+
         @li The host is set to the new string.
         Any special or reserved characters in the
         string are automatically percent-encoded.
 
+        A string which is entirely ASCII is not
+        looked at again for the conversion.
+
         In all cases where the string is valid and not empty,
         if the URL previously did not contain an
         authority (@ref has_authority returns `false`),
@@ -906,6 +1396,28 @@ public:
     set_encoded_host(
         string_view s);
 
+    /** Set the host, reporting errors through `ec`.
+
+        This function behaves as the overload without
+        the error code, except that when the string
+        is invalid, `ec` is set and the URL is
+        unchanged instead of throwing an exception.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_encoded_host(
+        string_view s,
+        error_code& ec);
+
     /** Return the port.
 
         If the URL contains a port, this function
@@ -921,6 +1433,23 @@ public:
     string_view
     port() const noexcept;
 
+    /** Return the port as a number.
+
+        This returns the value of the port, computed
+        when the port was parsed or set. If there is
+        no port, the port is empty, or its value is
+        greater than 65535, zero is returned.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    std::uint16_t
+    port_number() const noexcept
+    {
+        return pt_.port_number;
+    }
+
     /** Return the port.
 
         If the URL contains a port, this function
@@ -994,6 +1523,28 @@ public:
     url_base&
     set_port(string_view s);
 
+    /** Set the port, reporting errors through `ec`.
+
+        This function behaves as the overload without
+        the error code, except that when the string
+        is invalid, `ec` is set and the URL is
+        unchanged instead of throwing an exception.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_port(
+        string_view s,
+        error_code& ec);
+
     /** Set the port.
 
         The port of the URL is set to the specified string.
@@ -1031,6 +1582,28 @@ public:
     url_base&
     set_port_part(string_view s);
 
+    /** Set the port part, reporting errors through `ec`.
+
+        This function behaves as the overload without
+        the error code, except that when the string
+        is invalid, `ec` is set and the URL is
+        unchanged instead of throwing an exception.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_port_part(
+        string_view s,
+        error_code& ec);
+
     //------------------------------------------------------
     //
     // path
@@ -1106,6 +1679,28 @@ public:
     set_encoded_path(
         string_view s);
 
+    /** Set the path, reporting errors through `ec`.
+
+        This function behaves as the overload without
+        the error code, except that when the string
+        is invalid, `ec` is set and the URL is
+        unchanged instead of throwing an exception.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_encoded_path(
+        string_view s,
+        error_code& ec);
+
     /** Return the path.
 
         This function returns the path segments
@@ -1185,8 +1780,41 @@ public:
     query(
         Allocator const& a = {}) const
     {
-        return detail::decode(
-            encoded_query(), a);
+        return detail::decode(
+            encoded_query(), a);
+    }
+
+#ifdef BOOST_URL_HAS_PMR
+    /** Return the query, using a memory resource.
+
+        The returned string allocates from `mr`.
+    */
+    template<class MemoryResource, class =
+        detail::enable_if_memory_resource<
+            MemoryResource>>
+    std::pmr::string
+    query(
+        MemoryResource* mr) const
+    {
+        return query(std::pmr::
+            polymorphic_allocator<char>(mr));
+    }
+#endif
+
+    /** Return the query as a view of decoded characters.
+
+        The returned view refers to the underlying
+        string, and never allocates.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    decoded_view
+    decoded_query() const noexcept
+    {
+        return decoded_view(
+            encoded_query());
     }
 
     /** Return the query.
@@ -1312,6 +1940,28 @@ public:
     set_encoded_query(
         string_view s);
 
+    /** Set the query, reporting errors through `ec`.
+
+        This function behaves as the overload without
+        the error code, except that when the string
+        is invalid, `ec` is set and the URL is
+        unchanged instead of throwing an exception.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_encoded_query(
+        string_view s,
+        error_code& ec);
+
     /** Set the query.
 
         Sets the query of the URL to the specified
@@ -1346,6 +1996,28 @@ public:
     set_query_part(
         string_view s);
 
+    /** Set the query part, reporting errors through `ec`.
+
+        This function behaves as the overload without
+        the error code, except that when the string
+        is invalid, `ec` is set and the URL is
+        unchanged instead of throwing an exception.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_query_part(
+        string_view s,
+        error_code& ec);
+
     /** Return the query.
 
         This function returns the query parameters
@@ -1429,6 +2101,39 @@ public:
             encoded_fragment(), a);
     }
 
+#ifdef BOOST_URL_HAS_PMR
+    /** Return the fragment, using a memory resource.
+
+        The returned string allocates from `mr`.
+    */
+    template<class MemoryResource, class =
+        detail::enable_if_memory_resource<
+            MemoryResource>>
+    std::pmr::string
+    fragment(
+        MemoryResource* mr) const
+    {
+        return fragment(std::pmr::
+            polymorphic_allocator<char>(mr));
+    }
+#endif
+
+    /** Return the fragment as a view of decoded characters.
+
+        The returned view refers to the underlying
+        string, and never allocates.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    decoded_view
+    decoded_fragment() const noexcept
+    {
+        return decoded_view(
+            encoded_fragment());
+    }
+
     /** Return the fragment.
 
         This function returns the fragment of the URL:
@@ -1556,6 +2261,28 @@ public:
     set_encoded_fragment(
         string_view s);
 
+    /** Set the fragment, reporting errors through `ec`.
+
+        This function behaves as the overload without
+        the error code, except that when the string
+        is invalid, `ec` is set and the URL is
+        unchanged instead of throwing an exception.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_encoded_fragment(
+        string_view s,
+        error_code& ec);
+
     /** Set the fragment.
 
         Sets the fragment of the URL to the specified
@@ -1592,18 +2319,75 @@ public:
     set_fragment_part(
         string_view s);
 
+    /** Set the fragment part, reporting errors through `ec`.
+
+        This function behaves as the overload without
+        the error code, except that when the string
+        is invalid, `ec` is set and the URL is
+        unchanged instead of throwing an exception.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param s The string to set.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    url_base&
+    set_fragment_part(
+        string_view s,
+        error_code& ec);
+
     //------------------------------------------------------
     //
     // normalization
     //
     //------------------------------------------------------
 
-    /** Normalize everything.
+    /** Normalize the URL in place.
+
+        This function applies the selected steps of
+        syntax-based and scheme-based normalization
+        from rfc3986 section 6. URLs which are
+        equivalent under these steps become equal
+        strings. The URL is rewritten within its
+        existing storage, and never grows, so no
+        allocation takes place.
+
+        The path has its dot segments removed when
+        the URL has a scheme or the path is absolute,
+        because removing them from a relative path
+        would change the result of resolving it.
+
+        @par Example
+        @code
+        url u( "HTTP://www.Example.COM:80/a/./b/../c/%7e%3a" );
+        u.normalize();
+        assert( u.encoded_url() == "http://www.example.com/a/c/~%3A" );
+        @endcode
+
+        @par Exception Safety
+
+        No-throw guarantee.
+
+        @param f The steps to perform. If this
+        parameter is omitted, every step is performed.
     */
     BOOST_URL_DECL
     url_base&
-    normalize();
+    normalize(
+        normalize_flags f =
+            normalize_flags::all) noexcept;
 
+    /** Convert the scheme to lower case, in place.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
     BOOST_URL_DECL
     url_base&
     normalize_scheme() noexcept;
@@ -1620,6 +2404,17 @@ private:
 class url_base::segments_type
 {
     url_base* v_ = nullptr;
+    detail::segment_offsets* idx_ = nullptr;
+
+    friend class segments_index;
+
+    segments_type(
+        url_base& v,
+        detail::segment_offsets& idx) noexcept
+        : v_(&v)
+        , idx_(&idx)
+    {
+    }
 
 public:
 
@@ -1762,13 +2557,26 @@ public:
 class url_base::segments_type::value_type
 {
     string_view s_;
+    // the decoded size, or npos
+    // when it is not known
+    std::size_t dn_;
 
     friend class segments_type;
+    friend class segments_index;
 
     explicit
     value_type(
         string_view s) noexcept
         : s_(s)
+        , dn_(string_view::npos)
+    {
+    }
+
+    value_type(
+        string_view s,
+        std::size_t dn) noexcept
+        : s_(s)
+        , dn_(dn)
     {
     }
 
@@ -1788,6 +2596,11 @@ public:
 
     /** Return the segment string.
 
+        When the segment was reached by an iterator,
+        its decoded size is already known, so exactly
+        one allocation is made. A segment without
+        escapes is copied as it is.
+
         @par Exception Safety
 
         Strong guarantee.
@@ -1807,8 +2620,44 @@ public:
     string_type<Allocator>
     string(Allocator const& a = {}) const
     {
+        if(dn_ == string_view::npos)
+            return detail::decode(
+                encoded_string(), a);
         return detail::decode(
-            encoded_string(), a);
+            encoded_string(), dn_, a);
+    }
+
+#ifdef BOOST_URL_HAS_PMR
+    /** Return the segment, using a memory resource.
+
+        The returned string allocates from `mr`.
+    */
+    template<class MemoryResource, class =
+        detail::enable_if_memory_resource<
+            MemoryResource>>
+    std::pmr::string
+    string(
+        MemoryResource* mr) const
+    {
+        return string(std::pmr::
+            polymorphic_allocator<char>(mr));
+    }
+#endif
+
+    /** Return the segment as a view of decoded characters.
+
+        The returned view refers to the underlying
+        string, and never allocates.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    decoded_view
+    decoded() const noexcept
+    {
+        return decoded_view(
+            encoded_string());
     }
 
     value_type const*
@@ -1823,16 +2672,31 @@ public:
 class url_base::segments_type::iterator
 {
     friend segments_type;
+    friend class segments_index;
 
     url_base* v_;
     std::size_t off_;
     std::size_t n_;
+    // decoded size of the segment,
+    // or npos when it is not known
+    std::size_t dn_;
 
     BOOST_URL_DECL
     iterator(
         url_base* v,
         bool end) noexcept;
 
+    iterator(
+        url_base* v,
+        std::size_t off,
+        std::size_t n) noexcept
+        : v_(v)
+        , off_(off)
+        , n_(n)
+        , dn_(string_view::npos)
+    {
+    }
+
 public:
     using iterator_category =
         std::bidirectional_iterator_tag;
@@ -1912,6 +2776,30 @@ class url_base::params_type
 {
     url_base* v_ = nullptr;
 
+    class compactor;
+
+    BOOST_URL_DECL
+    static
+    std::size_t
+    encoded_size(
+        string_view key,
+        string_view value) noexcept;
+
+    BOOST_URL_DECL
+    static
+    char*
+    encode(
+        char* dest,
+        char sep,
+        string_view key,
+        string_view value) noexcept;
+
+    BOOST_URL_DECL
+    char*
+    grow(
+        std::size_t n,
+        std::size_t count);
+
 public:
     class value_type;
     class iterator;
@@ -1986,6 +2874,141 @@ public:
     string_type<Allocator>
     at( string_view key,
         Allocator const& a = {}) const;
+
+    //--------------------------------------------
+
+    /** Remove each param for which a predicate is true.
+
+        The params which are kept are moved down
+        in one forward pass over the query, and the
+        storage is resized once. If every param is
+        removed, the query is removed.
+
+        @par Exception Safety
+
+        Basic guarantee.
+        If the predicate throws, the params for
+        which it did not return `true` are kept.
+
+        @return The number of params removed.
+
+        @param pred A function called with each
+        @ref value_type, in order.
+    */
+    template<class Predicate>
+    std::size_t
+    erase_if(Predicate pred);
+
+    /** Remove each param matching the given key.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+
+        @return The number of params removed.
+
+        @param key The decoded key to match.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    erase(string_view key) noexcept;
+
+    /** Remove each param whose key is not in a list.
+
+        @par Exception Safety
+
+        Basic guarantee.
+
+        @return The number of params removed.
+
+        @param keys A range of decoded keys to keep,
+        whose elements are convertible to
+        `string_view`.
+    */
+    template<class Range>
+    std::size_t
+    retain(Range const& keys);
+
+    /** Remove each param whose key is not in a list.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+
+        @return The number of params removed.
+
+        @param keys The decoded keys to keep.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    retain(std::initializer_list<
+        string_view> keys) noexcept;
+
+    /** Append params to the query.
+
+        Each element is written as a key and a value
+        separated by `'='`, escaping the characters
+        which are not allowed. The storage is resized
+        once for the whole range. A param without a
+        value at the end of the query is given an
+        empty one, since its key would otherwise take
+        in the separator, and a query which is only
+        `"?"` is replaced.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param first An iterator to the first
+        element, whose members `first` and `second`
+        are the decoded key and value, convertible
+        to `string_view`.
+
+        @param last An iterator one past the last
+        element.
+    */
+    template<class FwdIt>
+    void
+    append(
+        FwdIt first,
+        FwdIt last);
+
+    /** Append params to the query.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @param init The decoded keys and values.
+    */
+    BOOST_URL_DECL
+    void
+    append(std::initializer_list<std::pair<
+        string_view, string_view>> init);
+
+    /** Set the value of a key.
+
+        The first param matching the key gets the
+        value, and the others matching it are
+        removed. If no param matches, one is
+        appended.
+
+        @par Exception Safety
+
+        Basic guarantee.
+        Calls to allocate may throw.
+
+        @param key The decoded key.
+
+        @param value The decoded value.
+    */
+    BOOST_URL_DECL
+    void
+    set(
+        string_view key,
+        string_view value);
 };
 
 //----------------------------------------------------------
@@ -1994,14 +3017,21 @@ class url_base::params_type::value_type
 {
     string_view k_;
     string_view v_;
+    std::size_t dk_;
+    std::size_t dv_;
 
     friend class params_type;
 
+    // dk and dv are the decoded sizes
     value_type(
         string_view k,
-        string_view v) noexcept
+        string_view v,
+        std::size_t dk,
+        std::size_t dv) noexcept
         : k_(k)
         , v_(v)
+        , dk_(dk)
+        , dv_(dv)
     {
     }
 
@@ -2027,6 +3057,11 @@ public:
 
     /** Return the key.
 
+        The size of the result was found when the
+        iterator reached the parameter, so exactly
+        one allocation is made. A key without escapes
+        is copied as it is.
+
         @par Exception Safety
 
         Strong guarantee.
@@ -2047,11 +3082,47 @@ public:
     key(Allocator const& a = {}) const
     {
         return detail::decode(
-            encoded_key(), a);
+            encoded_key(), dk_, a);
+    }
+
+#ifdef BOOST_URL_HAS_PMR
+    /** Return the key, using a memory resource.
+
+        The returned string allocates from `mr`.
+    */
+    template<class MemoryResource, class =
+        detail::enable_if_memory_resource<
+            MemoryResource>>
+    std::pmr::string
+    key(
+        MemoryResource* mr) const
+    {
+        return key(std::pmr::
+            polymorphic_allocator<char>(mr));
+    }
+#endif
+
+    /** Return the key as a view of decoded characters.
+
+        The returned view refers to the underlying
+        string, and never allocates.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    decoded_view
+    decoded_key() const noexcept
+    {
+        return decoded_view(
+            encoded_key());
     }
 
     /** Return the value.
 
+        As with @ref key, exactly one allocation
+        is made.
+
         @par Exception Safety
 
         Strong guarantee.
@@ -2072,7 +3143,40 @@ public:
     value(Allocator const& a = {}) const
     {
         return detail::decode(
-            encoded_value(), a);
+            encoded_value(), dv_, a);
+    }
+
+#ifdef BOOST_URL_HAS_PMR
+    /** Return the value, using a memory resource.
+
+        The returned string allocates from `mr`.
+    */
+    template<class MemoryResource, class =
+        detail::enable_if_memory_resource<
+            MemoryResource>>
+    std::pmr::string
+    value(
+        MemoryResource* mr) const
+    {
+        return value(std::pmr::
+            polymorphic_allocator<char>(mr));
+    }
+#endif
+
+    /** Return the value as a view of decoded characters.
+
+        The returned view refers to the underlying
+        string, and never allocates.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    decoded_view
+    decoded_value() const noexcept
+    {
+        return decoded_view(
+            encoded_value());
     }
 
     value_type const*
@@ -2100,6 +3204,9 @@ class url_base::params_type::iterator
     std::size_t off_;
     std::size_t nk_;
     std::size_t nv_;
+    // decoded sizes of the key and value
+    std::size_t dk_;
+    std::size_t dv_;
 
     BOOST_URL_DECL
     iterator(
@@ -2165,6 +3272,54 @@ private:
     parse() noexcept;
 };
 
+//----------------------------------------------------------
+
+// Removes params during one forward pass over
+// the query. The params which are kept are moved
+// down as they are visited, and the destructor
+// closes up the query and updates the parts.
+class url_base::params_type::compactor
+{
+public:
+    url_base* u_;
+    iterator it_;
+    iterator end_;
+    std::size_t w_;         // end of the kept params
+    std::size_t nkeep_ = 0;
+    std::size_t ndrop_ = 0;
+
+    BOOST_URL_DECL
+    explicit
+    compactor(url_base* u) noexcept;
+
+    BOOST_URL_DECL
+    ~compactor();
+
+    bool
+    done() const noexcept
+    {
+        return it_ == end_;
+    }
+
+    value_type
+    get() const noexcept
+    {
+        return *it_;
+    }
+
+    // Returns the new offset of the param
+    BOOST_URL_DECL
+    std::size_t
+    keep() noexcept;
+
+    void
+    drop() noexcept
+    {
+        ++it_;
+        ++ndrop_;
+    }
+};
+
 } // urls
 } // boost
 
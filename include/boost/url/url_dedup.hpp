@@ -0,0 +1,249 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_URL_DEDUP_HPP
+#define BOOST_URL_URL_DEDUP_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/error.hpp>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+/** A thread-safe set of URLs in normal form.
+
+    Each string inserted is parsed, put in normal
+    form by @ref url_base::normalize with
+    @ref normalize_flags::all, and hashed with
+    @ref hash_url, in one step while its characters
+    are in cache. The first time a normal form is
+    seen, its characters are copied to the end of
+    a buffer owned by the caller. Every insertion
+    of an equivalent URL returns a view of those
+    same characters, so duplicates can be found
+    by comparing pointers.
+
+    The set is divided into shards, chosen by the
+    hash, each with its own lock, so that threads
+    inserting at the same time rarely wait for
+    each other. Each thread normalizes into its
+    own @ref static_pool arena, and nothing is
+    allocated for a URL except when the table of
+    a shard grows.
+
+    Member functions may be called concurrently
+    from multiple threads, and the set starts no
+    threads of its own. The views returned remain
+    valid for as long as the buffer does.
+
+    @par Example
+    @code
+    std::vector< char > buf( 1 << 20 );
+    url_dedup set( buf.data(), buf.size() );
+    std::vector< string_view > out( lines.size() );
+    auto const n = set.insert(
+        lines.data(), lines.data() + lines.size(),
+        out.data(), nullptr );
+    assert( n == set.size() );
+    @endcode
+
+    @see hash_url, url_base::normalize
+*/
+class url_dedup
+{
+    struct slot
+    {
+        std::size_t hash;
+        char const* p;
+        std::size_t n;
+    };
+
+    struct shard
+    {
+        std::mutex m;
+        std::vector<slot> v;
+        std::size_t size = 0;
+    };
+
+    char* const buf_;
+    std::size_t const cap_;
+    std::atomic<std::size_t> used_;
+    std::atomic<std::size_t> size_;
+    std::unique_ptr<shard[]> shards_;
+    std::size_t nshard_;
+
+    // the arena of one thread
+    struct worker;
+
+    inline
+    char*
+    reserve(std::size_t n) noexcept;
+
+    inline
+    string_view
+    emplace(
+        string_view s,
+        std::size_t hash,
+        bool& inserted,
+        error_code& ec);
+
+    inline
+    string_view
+    insert(
+        worker& w,
+        string_view s,
+        bool& inserted,
+        error_code& ec);
+
+public:
+    /** Constructor
+
+        @param buffer The storage which receives the
+        characters of each URL in normal form.
+
+        @param size The size of the buffer, in bytes.
+
+        @param shards The number of shards, which is
+        rounded up to a power of two. Zero, the default,
+        chooses a number for the hardware.
+    */
+    BOOST_URL_DECL
+    url_dedup(
+        char* buffer,
+        std::size_t size,
+        std::size_t shards = 0);
+
+    url_dedup(url_dedup const&) = delete;
+    url_dedup& operator=(url_dedup const&) = delete;
+
+    /** Return the number of distinct URLs.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return size_.load(
+            std::memory_order_relaxed);
+    }
+
+    /** Return the number of bytes of the buffer in use.
+    */
+    std::size_t
+    used() const noexcept
+    {
+        return used_.load(
+            std::memory_order_relaxed);
+    }
+
+    /** Return the size of the buffer.
+    */
+    std::size_t
+    capacity() const noexcept
+    {
+        return cap_;
+    }
+
+    /** Insert a URL.
+
+        The string is parsed as a URI-reference and
+        put in normal form. If the set holds no URL
+        with the same normal form, it is copied into
+        the buffer and added.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+
+        @return A view of the URL in normal form,
+        which is in the buffer unless an error
+        occurred, in which case it is empty.
+
+        @param s The string to insert.
+
+        @param ec Set to the error, if any occurred.
+        This is @ref error::buffer_full when the
+        characters of a new URL do not fit.
+    */
+    BOOST_URL_DECL
+    string_view
+    insert(
+        string_view s,
+        error_code& ec);
+
+    /** Insert a range of URLs.
+
+        Each string in the range `[first, last)`
+        is inserted as if by calling @ref insert,
+        and the view returned is stored in the
+        element of `out` with the same index. One
+        arena is used for all of the strings.
+
+        No threads are started. To insert from
+        several threads, give each its own part
+        of the range. Which one of several
+        equivalent strings is then reported as new
+        depends on the order in which the threads
+        reach them, but the views stored for them
+        are always equal.
+
+        @par Exception Safety
+
+        Basic guarantee.
+        Calls to allocate may throw.
+
+        @return The number of strings which added
+        a URL to the set.
+
+        @param first A pointer to the first string.
+
+        @param last A pointer to one past the last string.
+
+        @param out A pointer to an array of at least
+        `last - first` views to receive the results.
+
+        @param ec A pointer to an array of at least
+        `last - first` error codes to receive the
+        result of each insertion, or `nullptr`.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    insert(
+        string_view const* first,
+        string_view const* last,
+        string_view* out,
+        error_code* ec);
+
+    /** Return the distinct URLs, in no particular order.
+
+        This function must not be called while
+        other threads are inserting.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    BOOST_URL_DECL
+    std::vector<string_view>
+    values() const;
+};
+
+} // urls
+} // boost
+
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/url_dedup.ipp>
+#endif
+
+#endif
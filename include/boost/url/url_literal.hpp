@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_URL_LITERAL_HPP
+#define BOOST_URL_URL_LITERAL_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/url/detail/literal_parse.hpp>
+#include <cstddef>
+
+#ifdef BOOST_URL_HAS_CONSTEXPR14
+
+namespace boost {
+namespace urls {
+
+/** Parse a URL which is known when the program is compiled.
+
+    This function parses a URL (a.k.a. URI-reference)
+    as @ref parse_uri does, and may be evaluated in a
+    constant expression. A view of a string literal
+    produced this way is computed by the compiler, so
+    a table of such views costs nothing at startup,
+    and a malformed URL in the table is reported as
+    an error when the program is compiled rather
+    than when it runs.
+
+    This function requires C++14. When it is
+    available, the macro `BOOST_URL_HAS_CONSTEXPR14`
+    is defined.
+
+    @par Example
+    @code
+    constexpr url_view u = parse_literal( "http://example.com:8080/" );
+    static_assert( u.port_number() == 8080, "" );
+    @endcode
+
+    @par Exception Safety
+
+    Throws @ref invalid_part if `s` is not a valid URL.
+    In a constant expression this is a compile error.
+
+    @param s The string to parse. The view refers to
+    this string, which must outlive it; string
+    literals always do.
+*/
+BOOST_URL_CONSTEXPR14
+url_view
+parse_literal(string_view s)
+{
+    detail::parts pt;
+    if(detail::literal_parser(
+        s.data(), s.size()).parse(pt) !=
+            error())
+        invalid_part::raise();
+    return url_view(s.data(), pt);
+}
+
+/** Parse a URL which is known when the program is compiled.
+
+    This overload takes the length of a string
+    literal from its type, so that it may be used
+    in a constant expression even where the length
+    of a null-terminated string cannot be computed
+    by the compiler.
+
+    @see parse_literal
+*/
+template<std::size_t N>
+BOOST_URL_CONSTEXPR14
+url_view
+parse_literal(char const(&s)[N])
+{
+    return parse_literal(
+        string_view(s, N - 1));
+}
+
+namespace literals {
+
+/** Return a view of a URL literal.
+
+    @par Example
+    @code
+    using namespace boost::urls::literals;
+
+    constexpr url_view u = "/path/to/file.txt"_url;
+    @endcode
+
+    @see parse_literal
+*/
+constexpr
+url_view
+operator ""_url(
+    char const* s,
+    std::size_t n)
+{
+    return parse_literal(
+        string_view(s, n));
+}
+
+} // literals
+
+} // urls
+} // boost
+
+#endif
+
+#endif
@@ -0,0 +1,205 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_URL_PARSER_HPP
+#define BOOST_URL_URL_PARSER_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/error.hpp>
+#include <boost/url/url_view.hpp>
+#include <boost/url/detail/parts.hpp>
+#include <boost/url/detail/table_parse.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace urls {
+
+/** An incremental parser for a URL arriving in pieces.
+
+    This parser accepts the bytes of a URL (a.k.a.
+    URI-reference) in successive calls to @ref write,
+    as they arrive. Between calls it keeps only its
+    position in the grammar and the parts found so far,
+    never the bytes themselves, so the caller may parse
+    in place out of its own buffers.
+
+    The URL ends at the first byte which cannot belong
+    to it, such as the space after the request-target
+    in an HTTP request line, or when @ref finish is
+    called at the end of the input. Once the parser is
+    done, @ref result returns a view of the URL given
+    its characters as one contiguous string.
+
+    Strings accepted in full are parsed into the same
+    parts as @ref parse_uri. After an error, the parser
+    must be reset before it is used again.
+
+    @par Example
+    @code
+    url_parser pr;
+    error_code ec;
+    pr.write( "/path/to?q", ec );
+    assert( ec == error::need_more );
+    auto n = pr.write( "uery=1 HTTP/1.1", ec );
+    assert( ! ec && n == 6 && pr.is_done() );
+    url_view u = pr.result( "/path/to?query=1" );
+    @endcode
+*/
+class url_parser
+{
+    enum class state : unsigned char
+    {
+        start,
+        scheme,         // scheme, or a path-noscheme
+        seg_nc,         // first segment of path-noscheme
+        after_scheme,
+        slash,          // one '/' of the hier-part
+        auth,           // userinfo, or host and port
+        host,           // host after '@'
+        ip_lit,
+        ip_end,
+        port,
+        path,
+        qkey,
+        qval,
+        frag,
+        pct1,           // first hex digit
+        pct2,           // second hex digit
+        done
+    };
+
+    detail::parts pt_;
+    std::size_t pos_ = 0;   // bytes consumed
+    std::size_t auth_ = 0;  // start of userinfo or host
+    std::size_t colon_ = 0; // first ':' in the authority
+    std::size_t n_ = 0;     // segments, then params
+    detail::ipv4_state v4_;
+    detail::port_state pn_;
+    bool port_ok_ = true;
+    state st_ = state::start;
+    state ret_ = state::start;
+    unsigned char len_ = 0;
+
+    // the scheme, or the text of an IP-literal
+    char buf_[48];
+
+    inline void mark(int id) noexcept;
+    inline void end_path() noexcept;
+    inline void end_query() noexcept;
+    inline void end_host() noexcept;
+    inline void end_authority(error_code& ec) noexcept;
+    inline bool step(char c, error_code& ec) noexcept;
+    inline void close(error_code& ec) noexcept;
+
+public:
+    /** Constructor
+
+        Default constructed parsers are at the
+        start of a URL.
+    */
+    url_parser() = default;
+
+    /** Return the parser to the start of a URL.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    void
+    reset() noexcept
+    {
+        *this = url_parser();
+    }
+
+    /** Return `true` if the end of the URL was found.
+    */
+    bool
+    is_done() const noexcept
+    {
+        return st_ == state::done;
+    }
+
+    /** Return the number of bytes of the URL consumed so far.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return pos_;
+    }
+
+    /** Parse the next bytes of the URL.
+
+        When every byte of `s` may belong to the URL,
+        they are all consumed and `ec` is set to
+        @ref error::need_more. Otherwise the URL ends
+        at the first byte which cannot belong to it;
+        that byte and those after it are not consumed,
+        and the parser is done.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+
+        @return The number of bytes consumed.
+
+        @param s The next bytes of the input.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    std::size_t
+    write(
+        string_view s,
+        error_code& ec) noexcept;
+
+    /** Indicate the end of the input.
+
+        After this call the parser is done, unless
+        the input ends inside a part which cannot
+        be empty, such as an escape or IP-literal.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_URL_DECL
+    void
+    finish(error_code& ec) noexcept;
+
+    /** Return a view of the parsed URL.
+
+        @par Preconditions
+        @code
+        this->is_done() && s.size() == this->size()
+        @endcode
+
+        @par Exception Safety
+
+        No-throw guarantee.
+
+        @param s The characters of the URL as one
+        contiguous string, the same bytes which
+        were consumed by the parser. The view
+        refers to this string.
+    */
+    BOOST_URL_DECL
+    url_view
+    result(string_view s) const noexcept;
+};
+
+} // urls
+} // boost
+
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/url_parser.ipp>
+#endif
+
+#endif
@@ -0,0 +1,198 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_URL_STATS_HPP
+#define BOOST_URL_URL_STATS_HPP
+
+#include <boost/url/config.hpp>
+#include <boost/url/url_view.hpp>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+/** Counts of the components found in a set of URLs.
+
+    This container tallies the hosts, the first path
+    segments, and the query parameter keys of every
+    URL inserted, as encoded strings. Strings which
+    fail to parse are counted as errors.
+
+    Objects of this type are not thread-safe. To
+    process input in parallel, give each thread its
+    own object and @ref merge them at the end; the
+    example `log_stats` does this for a log file.
+
+    @par Example
+    @code
+    url_stats st;
+    st.insert_lines( "http://a.com/x?k=1\n/y?k=2&j\n" );
+    assert( st.urls() == 2 );
+    assert( st.param_keys().at( "k" ) == 2 );
+    @endcode
+*/
+class url_stats
+{
+public:
+    /// The type of table which maps a component to its count
+    using table_type =
+        std::unordered_map<
+            std::string, std::size_t>;
+
+    /// The type of list returned by @ref top
+    using list_type =
+        std::vector<std::pair<
+            std::string, std::size_t>>;
+
+    /** Constructor
+
+        Default constructed objects are empty.
+    */
+    url_stats() = default;
+
+    /** Return the number of URLs inserted.
+    */
+    std::size_t
+    urls() const noexcept
+    {
+        return urls_;
+    }
+
+    /** Return the number of strings which failed to parse.
+    */
+    std::size_t
+    errors() const noexcept
+    {
+        return errors_;
+    }
+
+    /** Return the count of each host.
+    */
+    table_type const&
+    hosts() const noexcept
+    {
+        return hosts_;
+    }
+
+    /** Return the count of each first path segment.
+    */
+    table_type const&
+    first_segments() const noexcept
+    {
+        return segs_;
+    }
+
+    /** Return the count of each query parameter key.
+    */
+    table_type const&
+    param_keys() const noexcept
+    {
+        return keys_;
+    }
+
+    /** Tally the components of a URL.
+
+        Empty components are not counted.
+
+        @par Exception Safety
+
+        Basic guarantee.
+        Calls to allocate may throw.
+    */
+    BOOST_URL_DECL
+    void
+    insert(url_view const& u);
+
+    /** Parse a string and tally its components.
+
+        If the string is not a valid URL, the
+        error count is incremented instead.
+
+        @par Exception Safety
+
+        Basic guarantee.
+        Calls to allocate may throw.
+
+        @return `true` if the string was a valid URL.
+    */
+    BOOST_URL_DECL
+    bool
+    insert(string_view s);
+
+    /** Parse each line of a string and tally its components.
+
+        Lines are separated by LF, with an optional
+        CR before it. Empty lines are skipped.
+
+        @par Exception Safety
+
+        Basic guarantee.
+        Calls to allocate may throw.
+    */
+    BOOST_URL_DECL
+    void
+    insert_lines(string_view s);
+
+    /** Add the counts from another object to this one.
+
+        @par Exception Safety
+
+        Basic guarantee.
+        Calls to allocate may throw.
+    */
+    BOOST_URL_DECL
+    void
+    merge(url_stats const& other);
+
+    /** Return the largest counts in a table.
+
+        The list holds at most `n` elements, in
+        descending order of count. Equal counts
+        are ordered by key.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
+    BOOST_URL_DECL
+    static
+    list_type
+    top(
+        table_type const& t,
+        std::size_t n);
+
+private:
+    void count(
+        table_type& t,
+        string_view s);
+
+    std::size_t urls_ = 0;
+    std::size_t errors_ = 0;
+    table_type hosts_;
+    table_type segs_;
+    table_type keys_;
+
+    // reused to look up keys
+    // without an allocation
+    std::string tmp_;
+};
+
+} // urls
+} // boost
+
+#ifdef BOOST_URL_HEADER_ONLY
+#include <boost/url/impl/url_stats.ipp>
+#endif
+
+#endif
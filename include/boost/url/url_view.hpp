@@ -11,8 +11,14 @@
 #define BOOST_URL_URL_VIEW_HPP
 
 #include <boost/url/config.hpp>
+#include <boost/url/decoded_view.hpp>
+#include <boost/url/parser_kind.hpp>
+#include <boost/url/scheme.hpp>
 #include <boost/url/detail/parts.hpp>
 #include <boost/url/detail/char_type.hpp>
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -20,7 +26,16 @@
 namespace boost {
 namespace urls {
 
+class interned_url;
+class lazy_url_view;
+class origin_pool;
 class url_base;
+class url_parser;
+class params_index;
+
+namespace detail {
+class normal_url;
+} // detail
 
 /** A parsed reference to a URL string.
 */
@@ -29,6 +44,71 @@ class url_view
     char const* s_ = "";
     detail::parts pt_;
 
+    friend
+    url_view
+    parse_uri(
+        string_view s,
+        error_code& ec) noexcept;
+
+    friend
+    url_view
+    parse_uri(
+        string_view s,
+        parser_kind k,
+        error_code& ec) noexcept;
+
+    friend
+    url_view
+    parse_request_target(
+        string_view s,
+        error_code& ec) noexcept;
+
+    friend
+    BOOST_URL_CONSTEXPR14
+    url_view
+    parse_literal(string_view s);
+
+    friend
+    void
+    resolve(
+        url_view const& base,
+        url_view const& ref,
+        url_base& dest,
+        error_code& ec);
+
+    friend
+    std::size_t
+    serialized_size(
+        url_view const& u) noexcept;
+
+    friend
+    char*
+    serialize_url(
+        url_view const& u,
+        char* dest) noexcept;
+
+    friend
+    url_view
+    deserialize_url(
+        string_view& buf,
+        error_code& ec) noexcept;
+
+    friend class detail::normal_url;
+    friend class interned_url;
+    friend class lazy_url_view;
+    friend class origin_pool;
+    friend class url_base;
+    friend class url_parser;
+
+    constexpr
+    url_view(
+        char const* s,
+        detail::parts const& pt) noexcept
+        : s_(s)
+        , pt_(pt)
+    {
+    }
+
 public:
     class segments_type;
     class params_type;
@@ -45,6 +125,7 @@ public:
 
     /** Return the number of characters in the URL.
     */
+    constexpr
     std::size_t
     size() const noexcept
     {
@@ -54,6 +135,7 @@ public:
 
     /** Return a pointer to the characters in the URL.
     */
+    constexpr
     char const*
     data() const noexcept
     {
@@ -86,6 +168,29 @@ public:
     string_view
     scheme() const noexcept;
 
+    /** Return the known scheme, if any.
+
+        This returns the scheme as an enumeration,
+        computed when the scheme was parsed or set.
+        Schemes which are not known, and URLs without
+        a scheme, return @ref scheme::unknown.
+
+        @par Example
+        @code
+        assert( url_view( "HTTPS://example.com" ).scheme_id() == scheme::https );
+        @endcode
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    constexpr
+    urls::scheme
+    scheme_id() const noexcept
+    {
+        return pt_.scheme_id;
+    }
+
     //------------------------------------------------------
     //
     // authority
@@ -194,6 +299,39 @@ public:
             encoded_user(), a);
     }
 
+#ifdef BOOST_URL_HAS_PMR
+    /** Return the user, using a memory resource.
+
+        The returned string allocates from `mr`.
+    */
+    template<class MemoryResource, class =
+        detail::enable_if_memory_resource<
+            MemoryResource>>
+    std::pmr::string
+    user(
+        MemoryResource* mr) const
+    {
+        return user(std::pmr::
+            polymorphic_allocator<char>(mr));
+    }
+#endif
+
+    /** Return the user as a view of decoded characters.
+
+        The returned view refers to the underlying
+        string, and never allocates.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    decoded_view
+    decoded_user() const noexcept
+    {
+        return decoded_view(
+            encoded_user());
+    }
+
     /** Return the user.
 
         This function returns the user portion of
@@ -224,6 +362,39 @@ public:
             encoded_password(), a);
     }
 
+#ifdef BOOST_URL_HAS_PMR
+    /** Return the password, using a memory resource.
+
+        The returned string allocates from `mr`.
+    */
+    template<class MemoryResource, class =
+        detail::enable_if_memory_resource<
+            MemoryResource>>
+    std::pmr::string
+    password(
+        MemoryResource* mr) const
+    {
+        return password(std::pmr::
+            polymorphic_allocator<char>(mr));
+    }
+#endif
+
+    /** Return the password as a view of decoded characters.
+
+        The returned view refers to the underlying
+        string, and never allocates.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    decoded_view
+    decoded_password() const noexcept
+    {
+        return decoded_view(
+            encoded_password());
+    }
+
     /** Return the password.
     */
     BOOST_URL_DECL
@@ -242,12 +413,59 @@ public:
 
         No-throw guarantee.
     */
+    constexpr
     urls::host_type
     host_type() const noexcept
     {
         return pt_.host;
     }
 
+    /** Return the IPv4 address of the host.
+
+        If @ref host_type returns @ref host_type::ipv4,
+        this returns the four bytes of the address in
+        network byte order, decoded when the host was
+        parsed. Otherwise all of the bytes are zero.
+
+        @par Example
+        @code
+        url_view u = parse_uri( "http://192.168.0.1/" ).value();
+        assert( u.ipv4_address()[0] == 192 );
+        @endcode
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    std::array<unsigned char, 4>
+    ipv4_address() const noexcept
+    {
+        std::array<unsigned char, 4> a{};
+        if(pt_.host == urls::host_type::ipv4)
+            std::memcpy(a.data(), pt_.ip, 4);
+        return a;
+    }
+
+    /** Return the IPv6 address of the host.
+
+        If @ref host_type returns @ref host_type::ipv6,
+        this returns the sixteen bytes of the address
+        in network byte order, decoded when the host
+        was parsed. Otherwise all of the bytes are zero.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    std::array<unsigned char, 16>
+    ipv6_address() const noexcept
+    {
+        std::array<unsigned char, 16> a{};
+        if(pt_.host == urls::host_type::ipv6)
+            std::memcpy(a.data(), pt_.ip, 16);
+        return a;
+    }
+
     /** Return the host and port.
 
         This function returns the encoded host and port,
@@ -301,6 +519,39 @@ public:
             encoded_host(), a);
     }
 
+#ifdef BOOST_URL_HAS_PMR
+    /** Return the host, using a memory resource.
+
+        The returned string allocates from `mr`.
+    */
+    template<class MemoryResource, class =
+        detail::enable_if_memory_resource<
+            MemoryResource>>
+    std::pmr::string
+    host(
+        MemoryResource* mr) const
+    {
+        return host(std::pmr::
+            polymorphic_allocator<char>(mr));
+    }
+#endif
+
+    /** Return the host as a view of decoded characters.
+
+        The returned view refers to the underlying
+        string, and never allocates.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    decoded_view
+    decoded_host() const noexcept
+    {
+        return decoded_view(
+            encoded_host());
+    }
+
     /** Return the host.
 
         This function returns the host portion of
@@ -330,6 +581,24 @@ public:
     string_view
     port() const noexcept;
 
+    /** Return the port as a number.
+
+        This returns the value of the port, computed
+        when the port was parsed or set. If there is
+        no port, the port is empty, or its value is
+        greater than 65535, zero is returned.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    constexpr
+    std::uint16_t
+    port_number() const noexcept
+    {
+        return pt_.port_number;
+    }
+
     /** Return the port.
 
         If the URL contains a port, this function
@@ -412,6 +681,39 @@ public:
             encoded_query(), a);
     }
 
+#ifdef BOOST_URL_HAS_PMR
+    /** Return the query, using a memory resource.
+
+        The returned string allocates from `mr`.
+    */
+    template<class MemoryResource, class =
+        detail::enable_if_memory_resource<
+            MemoryResource>>
+    std::pmr::string
+    query(
+        MemoryResource* mr) const
+    {
+        return query(std::pmr::
+            polymorphic_allocator<char>(mr));
+    }
+#endif
+
+    /** Return the query as a view of decoded characters.
+
+        The returned view refers to the underlying
+        string, and never allocates.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    decoded_view
+    decoded_query() const noexcept
+    {
+        return decoded_view(
+            encoded_query());
+    }
+
     /** Return the query.
 
         This function returns the query of the URL:
@@ -527,6 +829,39 @@ public:
             encoded_fragment(), a);
     }
 
+#ifdef BOOST_URL_HAS_PMR
+    /** Return the fragment, using a memory resource.
+
+        The returned string allocates from `mr`.
+    */
+    template<class MemoryResource, class =
+        detail::enable_if_memory_resource<
+            MemoryResource>>
+    std::pmr::string
+    fragment(
+        MemoryResource* mr) const
+    {
+        return fragment(std::pmr::
+            polymorphic_allocator<char>(mr));
+    }
+#endif
+
+    /** Return the fragment as a view of decoded characters.
+
+        The returned view refers to the underlying
+        string, and never allocates.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    decoded_view
+    decoded_fragment() const noexcept
+    {
+        return decoded_view(
+            encoded_fragment());
+    }
+
     /** Return the fragment.
 
         This function returns the fragment of the URL:
@@ -645,13 +980,16 @@ public:
 class url_view::segments_type::value_type
 {
     string_view s_;
+    std::size_t dn_;
 
     friend class segments_type;
 
-    explicit
+    // dn is the decoded size
     value_type(
-        string_view s) noexcept
+        string_view s,
+        std::size_t dn) noexcept
         : s_(s)
+        , dn_(dn)
     {
     }
 
@@ -669,6 +1007,18 @@ public:
         return s_;
     }
 
+    /** Return the segment string.
+
+        The size of the result was found when the
+        iterator reached the segment, so exactly one
+        allocation is made. A segment without escapes
+        is copied as it is.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
     template<
         class Allocator =
             std::allocator<char>>
@@ -676,7 +1026,40 @@ public:
     string(Allocator const& a = {}) const
     {
         return detail::decode(
-            encoded_string(), a);
+            encoded_string(), dn_, a);
+    }
+
+#ifdef BOOST_URL_HAS_PMR
+    /** Return the segment, using a memory resource.
+
+        The returned string allocates from `mr`.
+    */
+    template<class MemoryResource, class =
+        detail::enable_if_memory_resource<
+            MemoryResource>>
+    std::pmr::string
+    string(
+        MemoryResource* mr) const
+    {
+        return string(std::pmr::
+            polymorphic_allocator<char>(mr));
+    }
+#endif
+
+    /** Return the segment as a view of decoded characters.
+
+        The returned view refers to the underlying
+        string, and never allocates.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    decoded_view
+    decoded() const noexcept
+    {
+        return decoded_view(
+            encoded_string());
     }
 
     value_type const*
@@ -696,6 +1079,8 @@ class url_view::segments_type::iterator
     detail::parts const* pt_;
     std::size_t off_;
     std::size_t n_;
+    // decoded size of the segment
+    std::size_t dn_;
 
     BOOST_URL_DECL
     iterator(
@@ -843,16 +1228,23 @@ class url_view::params_type::value_type
 {
     string_view k_;
     string_view v_;
+    std::size_t dk_;
+    std::size_t dv_;
 
     friend class params_type;
 
+    // dk and dv are the decoded sizes
     value_type(
         string_view k,
-        string_view v) noexcept
+        string_view v,
+        std::size_t dk,
+        std::size_t dv) noexcept
         : k_(k)
         , v_(v)
+        , dk_(dk)
+        , dv_(dv)
     {
-        }
+    }
 
 public:
     value_type() = delete;
@@ -874,6 +1266,18 @@ public:
         return v_;
     }
 
+    /** Return the key.
+
+        The size of the result was found when the
+        iterator reached the parameter, so exactly
+        one allocation is made. A key without escapes
+        is copied as it is.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
     template<
         class Allocator =
             std::allocator<char>>
@@ -881,9 +1285,52 @@ public:
     key(Allocator const& a = {}) const
     {
         return detail::decode(
-            encoded_key(), a);
+            encoded_key(), dk_, a);
     }
 
+#ifdef BOOST_URL_HAS_PMR
+    /** Return the key, using a memory resource.
+
+        The returned string allocates from `mr`.
+    */
+    template<class MemoryResource, class =
+        detail::enable_if_memory_resource<
+            MemoryResource>>
+    std::pmr::string
+    key(
+        MemoryResource* mr) const
+    {
+        return key(std::pmr::
+            polymorphic_allocator<char>(mr));
+    }
+#endif
+
+    /** Return the key as a view of decoded characters.
+
+        The returned view refers to the underlying
+        string, and never allocates.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    decoded_view
+    decoded_key() const noexcept
+    {
+        return decoded_view(
+            encoded_key());
+    }
+
+    /** Return the value.
+
+        As with @ref key, exactly one allocation
+        is made.
+
+        @par Exception Safety
+
+        Strong guarantee.
+        Calls to allocate may throw.
+    */
     template<
         class Allocator =
             std::allocator<char>>
@@ -891,7 +1338,40 @@ public:
     value(Allocator const& a = {}) const
     {
         return detail::decode(
-            encoded_value(), a);
+            encoded_value(), dv_, a);
+    }
+
+#ifdef BOOST_URL_HAS_PMR
+    /** Return the value, using a memory resource.
+
+        The returned string allocates from `mr`.
+    */
+    template<class MemoryResource, class =
+        detail::enable_if_memory_resource<
+            MemoryResource>>
+    std::pmr::string
+    value(
+        MemoryResource* mr) const
+    {
+        return value(std::pmr::
+            polymorphic_allocator<char>(mr));
+    }
+#endif
+
+    /** Return the value as a view of decoded characters.
+
+        The returned view refers to the underlying
+        string, and never allocates.
+
+        @par Exception Safety
+
+        No-throw guarantee.
+    */
+    decoded_view
+    decoded_value() const noexcept
+    {
+        return decoded_view(
+            encoded_value());
     }
 
     value_type const*
@@ -914,18 +1394,28 @@ public:
 class url_view::params_type::iterator
 {
     friend params_type;
+    friend class params_index;
 
     char const* s_;
     detail::parts const* pt_;
     std::size_t off_;
     std::size_t nk_;
     std::size_t nv_;
+    // decoded sizes of the key and value
+    std::size_t dk_;
+    std::size_t dv_;
 
     BOOST_URL_DECL
     iterator(
         params_type const* v,
         bool end) noexcept;
 
+    // the parameter at offset `off`
+    BOOST_URL_DECL
+    iterator(
+        params_type const* v,
+        std::size_t off) noexcept;
+
 public:
     using value_type =
         params_type::value_type;
@@ -181,10 +181,171 @@ public:
         }
     }
 
+    void
+    testSkipUnreserved()
+    {
+        string_view const unreserved =
+            "0123456789"
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+            "abcdefghijklmnopqrstuvwxyz"
+            "-._~";
+        for(int i = 0; i < 256; ++i)
+        {
+            auto const c =
+                static_cast<char>(i);
+            BOOST_TEST(is_unreserved(c) ==
+                (unreserved.find(c) !=
+                    string_view::npos));
+        }
+
+        // every length, every position,
+        // every non-unreserved character
+        for(std::size_t n = 0; n < 40; ++n)
+        {
+            std::string s;
+            for(std::size_t i = 0; i < n; ++i)
+                s.push_back(unreserved[
+                    i % unreserved.size()]);
+            auto const b = s.data();
+            BOOST_TEST(skip_unreserved(
+                b, b + n) == b + n);
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                for(int j = 0; j < 256; ++j)
+                {
+                    auto const c =
+                        static_cast<char>(j);
+                    if(is_unreserved(c))
+                        continue;
+                    auto const c0 = s[i];
+                    s[i] = c;
+                    BOOST_TEST(skip_unreserved(
+                        b, b + n) == b + i);
+                    s[i] = c0;
+                }
+            }
+        }
+    }
+
+    void
+    testParse()
+    {
+        auto const check =
+            [](string_view s, pct_encoding e,
+                std::size_t pos, std::size_t dn,
+                error_code ec0)
+        {
+            error_code ec;
+            auto const it = e.parse(
+                s.data(), s.data() + s.size(), ec);
+            // parse stops at a reserved
+            // character without an error
+            if(ec0 == error::illegal_reserved_char)
+                BOOST_TEST(! ec);
+            else
+                BOOST_TEST(ec == ec0);
+            BOOST_TEST(static_cast<std::size_t>(
+                it - s.data()) == pos);
+            ec = {};
+            auto const n =
+                e.decoded_size(s, ec);
+            if(ec0)
+                BOOST_TEST(ec == ec0);
+            if(! ec0)
+                BOOST_TEST(n == dn);
+        };
+
+        std::string s(1000, 'x');
+        check(s, frag_pct_set(),
+            1000, 1000, {});
+        s[500] = '#';
+        check(s, frag_pct_set(), 500, 0,
+            error::illegal_reserved_char);
+        s[500] = '=';
+        check(s, frag_pct_set(),
+            1000, 1000, {});
+        check(s, qkey_pct_set(), 500, 0,
+            error::illegal_reserved_char);
+        s[500] = '%';
+        check(s, frag_pct_set(), 500, 0,
+            error::bad_pct_encoding_digit);
+        s.replace(500, 3, "%2F");
+        check(s, frag_pct_set(),
+            1000, 998, {});
+        s.replace(997, 3, "x%4");
+        check(s, frag_pct_set(), 998, 0,
+            error::incomplete_pct_encoding);
+        s.replace(0, 1, "\x80");
+        check(s, frag_pct_set(), 0, 0,
+            error::illegal_reserved_char);
+    }
+
+    void
+    testDecodeEncode()
+    {
+        auto const check =
+            [](string_view s, pct_encoding e)
+        {
+            auto const n = e.encoded_size(s);
+            std::string es(n, ' ');
+            BOOST_TEST(e.encode(
+                &es[0], s) == n);
+            BOOST_TEST(e.check(es));
+            error_code ec;
+            BOOST_TEST(e.decoded_size(
+                es, ec) == s.size());
+            BOOST_TEST(! ec);
+            BOOST_TEST(pct_encoding::
+                raw_decoded_size(es) == s.size());
+            std::string ds(s.size(), ' ');
+            auto const end =
+                pct_encoding::decode(&ds[0], es);
+            BOOST_TEST(end == &ds[0] + ds.size());
+            BOOST_TEST(ds == s);
+        };
+
+        // every character, alone and in runs
+        for(int i = 0; i < 256; ++i)
+        {
+            auto const c =
+                static_cast<char>(i);
+            check(std::string(1, c),
+                pchar_pct_set());
+            check(std::string(37, c),
+                qval_pct_set());
+            check("abc" + std::string(3, c) +
+                "0123456789abcdefghij",
+                frag_pct_set());
+        }
+
+        {
+            std::string s;
+            for(int i = 0; i < 512; ++i)
+                s.push_back(static_cast<
+                    char>((i * 7) & 0xff));
+            check(s, reg_name_pct_set());
+            check(s, qkey_pct_set());
+        }
+
+        BOOST_TEST(frag_pct_set().encoded_size(
+            "abcdefghijklmnopqrstuvwxyz #") == 32);
+        {
+            string_view const es =
+                "%41%42C%20%2F///xyz%7E";
+            std::string ds(pct_encoding::
+                raw_decoded_size(es), ' ');
+            pct_encoding::decode(&ds[0], es);
+            BOOST_TEST(ds == "ABC ////xyz~");
+        }
+    }
+
     void
     run()
     {
         testEncodings();
+        testSkipUnreserved();
+        testParse();
+        testDecodeEncode();
     }
 };
 
@@ -63,8 +63,25 @@ public:
 
         good("/path/to/file.txt?query#frag");
 
+        good("h2c://example.com");
+        good("coap+tcp://example.com");
+
         bad("ws://%X9");
         bad("1badscheme://");
+        bad("/%X9");
+        bad("/ ");
+
+        // the first segment of
+        // path-absolute is checked
+        {
+            error_code ec;
+            parts pt;
+            parse_url(pt, "/?a=1", ec);
+            BOOST_TEST(! ec);
+            BOOST_TEST(pt.length(id_path) == 1);
+            BOOST_TEST(pt.length(id_query) == 4);
+            BOOST_TEST(pt.nparam == 1);
+        }
     }
 
     void
@@ -0,0 +1,190 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/decoded_view.hpp>
+
+#include <boost/url/url.hpp>
+#include <boost/url/url_view.hpp>
+
+#include "test_suite.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+namespace boost {
+namespace urls {
+
+class decoded_view_test
+{
+public:
+    void
+    testView()
+    {
+        decoded_view const v0;
+        BOOST_TEST(v0.empty());
+        BOOST_TEST(v0.size() == 0);
+        BOOST_TEST(v0.begin() == v0.end());
+        BOOST_TEST(v0 == "");
+
+        decoded_view const v("a%20b%25%41");
+        BOOST_TEST(! v.empty());
+        BOOST_TEST(v.size() == 5);
+        BOOST_TEST(v.encoded() == "a%20b%25%41");
+        BOOST_TEST(v.to_string() == "a b%A");
+        BOOST_TEST(std::string(
+            v.begin(), v.end()) == "a b%A");
+
+        // bidirectional
+        std::string r;
+        auto it = v.end();
+        while(it != v.begin())
+            r.push_back(*--it);
+        BOOST_TEST(r == "A%b a");
+        it = v.begin();
+        BOOST_TEST(*it++ == 'a');
+        BOOST_TEST(*it == ' ');
+        BOOST_TEST(it.base() == v.encoded().data() + 1);
+        BOOST_TEST(*it-- == ' ');
+        BOOST_TEST(*it == 'a');
+
+        // "%2541" is "%" followed by "41"
+        decoded_view const v1("%2541");
+        BOOST_TEST(v1 == "%41");
+        std::string r1(v1.begin(), v1.end());
+        std::reverse(r1.begin(), r1.end());
+        std::string r2;
+        for(auto i = v1.end(); i != v1.begin();)
+            r2.push_back(*--i);
+        BOOST_TEST(r1 == r2);
+    }
+
+    void
+    testCompare()
+    {
+        decoded_view const v("a%62c");
+        BOOST_TEST(v == "abc");
+        BOOST_TEST("abc" == v);
+        BOOST_TEST(v != "ab");
+        BOOST_TEST(v != "abcd");
+        BOOST_TEST(v.compare("abc") == 0);
+        BOOST_TEST(v.compare("abd") < 0);
+        BOOST_TEST(v.compare("abb") > 0);
+        BOOST_TEST(v.compare("ab") > 0);
+        BOOST_TEST(v.compare("abcd") < 0);
+        BOOST_TEST(v.compare("") > 0);
+        BOOST_TEST(decoded_view("%FF").compare("a") > 0);
+
+        BOOST_TEST(v == decoded_view("abc"));
+        BOOST_TEST(v == decoded_view("%61b%63"));
+        BOOST_TEST(decoded_view("abc") == v);
+        BOOST_TEST(v != decoded_view("%61b"));
+        BOOST_TEST(decoded_view("ab") < v);
+        BOOST_TEST(! (v < decoded_view("ab")));
+        BOOST_TEST(decoded_view("%61b") < v);
+
+        BOOST_TEST(v.starts_with(""));
+        BOOST_TEST(v.starts_with("a"));
+        BOOST_TEST(v.starts_with("ab"));
+        BOOST_TEST(v.starts_with("abc"));
+        BOOST_TEST(! v.starts_with("abcd"));
+        BOOST_TEST(! v.starts_with("b"));
+        BOOST_TEST(decoded_view("%41%42%43").starts_with("AB"));
+        BOOST_TEST(! decoded_view("%41%42%43").starts_with("ABCD"));
+
+        BOOST_TEST(v.ends_with(""));
+        BOOST_TEST(v.ends_with("c"));
+        BOOST_TEST(v.ends_with("bc"));
+        BOOST_TEST(v.ends_with("abc"));
+        BOOST_TEST(! v.ends_with("xabc"));
+        BOOST_TEST(! v.ends_with("b"));
+        BOOST_TEST(decoded_view("%41%42%43").ends_with("BC"));
+        BOOST_TEST(! decoded_view("%41%42%43").ends_with("ABCD"));
+    }
+
+    void
+    testHash()
+    {
+        BOOST_TEST(
+            decoded_view("abc").hash() ==
+            decoded_view("%61%62%63").hash());
+        BOOST_TEST(
+            decoded_view("abc").hash() !=
+            decoded_view("abd").hash());
+        BOOST_TEST(
+            decoded_view().hash() ==
+            decoded_view("").hash());
+    }
+
+    void
+    testStream()
+    {
+        std::stringstream ss;
+        ss << decoded_view("x%20y%2Fz") <<
+            decoded_view("") << decoded_view("%41");
+        BOOST_TEST(ss.str() == "x y/zA");
+    }
+
+    void
+    testAccessors()
+    {
+        url_view const v(
+            "http://us%45r:p%41ss@ex%41mple.com/a%20b/c"
+            "?k%31=v%31&k2#fr%41g");
+        BOOST_TEST(v.decoded_user() == "usEr");
+        BOOST_TEST(v.decoded_password() == "pAss");
+        BOOST_TEST(v.decoded_host() == "exAmple.com");
+        BOOST_TEST(v.decoded_query() == "k1=v1&k2");
+        BOOST_TEST(v.decoded_fragment() == "frAg");
+        {
+            auto it = v.segments().begin();
+            BOOST_TEST(it->decoded() == "a b");
+            ++it;
+            BOOST_TEST((*it).decoded() == "c");
+        }
+        {
+            auto it = v.params().begin();
+            BOOST_TEST(it->decoded_key() == "k1");
+            BOOST_TEST(it->decoded_value() == "v1");
+            ++it;
+            BOOST_TEST(it->decoded_key() == "k2");
+            BOOST_TEST(it->decoded_value().empty());
+        }
+
+        url const u(v.encoded_url());
+        BOOST_TEST(u.decoded_user() == "usEr");
+        BOOST_TEST(u.decoded_password() == "pAss");
+        BOOST_TEST(u.decoded_host() == "exAmple.com");
+        BOOST_TEST(u.decoded_query() == "k1=v1&k2");
+        BOOST_TEST(u.decoded_fragment() == "frAg");
+        BOOST_TEST(u.segments().begin()->decoded() == "a b");
+        BOOST_TEST(u.params().begin()->decoded_key() == "k1");
+        BOOST_TEST(u.params().begin()->decoded_value() == "v1");
+
+        // the view refers to the url
+        BOOST_TEST(v.decoded_host().encoded().data() ==
+            v.encoded_host().data());
+    }
+
+    void
+    run()
+    {
+        testView();
+        testCompare();
+        testHash();
+        testStream();
+        testAccessors();
+    }
+};
+
+TEST_SUITE(decoded_view_test, "boost.url.decoded_view");
+
+} // urls
+} // boost
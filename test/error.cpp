@@ -65,6 +65,22 @@ public:
         check(condition::parse_error, error::bad_pct_encoding_digit);
         check(condition::parse_error, error::incomplete_pct_encoding);
         check(condition::parse_error, error::illegal_reserved_char);
+
+        check(condition::parse_error, error::bad_utf8);
+        check(condition::parse_error, error::bad_punycode);
+        check(condition::parse_error, error::bad_idn_char);
+        check(condition::parse_error, error::label_too_long);
+
+        check(condition::parse_error, error::bad_serialized_url);
+        check(condition::parse_error, error::unsupported_version);
+
+        check(error::buffer_full);
+        BOOST_TEST(make_error_code(
+            error::buffer_full) != condition::parse_error);
+
+        check(error::need_more);
+        BOOST_TEST(make_error_code(
+            error::need_more) != condition::parse_error);
     }
 };
 
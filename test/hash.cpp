@@ -0,0 +1,203 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/hash.hpp>
+
+#include <boost/url/url.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+#include <unordered_set>
+
+namespace boost {
+namespace urls {
+
+class hash_test
+{
+public:
+    // agrees with normalize
+    static
+    void
+    check(string_view s)
+    {
+        url_view const u0(s);
+        url u1(s);
+        u1.normalize();
+        url_view const v1 = u1;
+        BOOST_TEST(equivalent(u0, v1));
+        BOOST_TEST(equivalent(v1, u0));
+        BOOST_TEST(hash_url(u0) == hash_url(v1));
+        BOOST_TEST(hash_origin(u0) == hash_origin(v1));
+        BOOST_TEST(hash_path(u0) == hash_path(v1));
+        BOOST_TEST(hash_query_unordered(u0) ==
+            hash_query_unordered(v1));
+    }
+
+    static
+    void
+    check_ne(
+        string_view s0,
+        string_view s1)
+    {
+        url_view const u0(s0);
+        url_view const u1(s1);
+        BOOST_TEST(! equivalent(u0, u1));
+        BOOST_TEST(! equivalent(u1, u0));
+        BOOST_TEST(hash_url(u0) != hash_url(u1));
+    }
+
+    void
+    testNormal()
+    {
+        check("");
+        check("/");
+        check("x");
+        check("HTTP://www.Example.COM:80/a/./b/../c/%7e%3a");
+        check("http://%41%62c.com/");
+        check("http://%31.2.3.4/");
+        check("http://[FE80::A]/");
+        check("http://u%7E:p%2f@h/?q=%7e%2f#%7E%2f");
+        check("http://h:80/");
+        check("http://h:8080/");
+        check("https://h:443");
+        check("http://h:/");
+        check("http://:80");
+        check("//h:80");
+        check("http://a/b/c/./../../g");
+        check("http://a/b/c/..");
+        check("http://a/b/c/.");
+        check("http://a/b/c/../../../..");
+        check("http://a/b/%2E/c");
+        check("http://a/b/%2e%2E/c");
+        check("http://a/g..");
+        check("mid/content=5/../6");
+        check("/a/b/../c");
+        check("x:a/b/../c");
+        check("x:../a");
+        check("x:/a/..//b");
+        check("/./..//b?q");
+        check("x://h/a/..//b");
+        check("http://h/?b=2&a=1#f");
+
+        // long enough to allocate
+        std::string s = "http://h/";
+        for(int i = 0; i < 100; ++i)
+            s += "%7Eseg/";
+        s += "../x";
+        check(s);
+    }
+
+    void
+    testDistinct()
+    {
+        check_ne("http://h/a", "http://h/b");
+        check_ne("http://h/a", "https://h/a");
+        check_ne("http://h/a", "http://h:81/a");
+        check_ne("http://h/%2F", "http://h//");
+        check_ne("http://u@h/", "http://U@h/");
+        check_ne("http://h/A", "http://h/a");
+        check_ne("http://h/?q", "http://h/?Q");
+        check_ne("http://h/?", "http://h/");
+        check_ne("http://h/#", "http://h/");
+        check_ne("http://h/a?b", "http://h/a#b");
+        check_ne("x:a/b/../c", "x:a/b/c");
+        check_ne("a/../b", "b");
+    }
+
+    void
+    testComponents()
+    {
+        // origin
+        BOOST_TEST(
+            hash_origin(url_view("HTTP://Example.com:80/x")) ==
+            hash_origin(url_view("http://example.com/y?q")));
+        BOOST_TEST(
+            hash_origin(url_view("http://a.com/")) !=
+            hash_origin(url_view("http://b.com/")));
+
+        // path
+        BOOST_TEST(
+            hash_path(url_view("http://a.com/x/./y/%7e")) ==
+            hash_path(url_view("https://b.com/x/y/~?q")));
+        BOOST_TEST(
+            hash_path(url_view("/x")) !=
+            hash_path(url_view("/y")));
+
+        // query
+        auto const hq = [](string_view s)
+        {
+            return hash_query_unordered(url_view(s));
+        };
+        BOOST_TEST(hq("?a=1&b=2") == hq("?b=2&a=1"));
+        BOOST_TEST(hq("/p?a=1&b=%7e") == hq("/q?b=~&a=1#f"));
+        BOOST_TEST(hq("?a&a&b") == hq("?a&b&a"));
+        BOOST_TEST(hq("?a&a&b") != hq("?a&b&b"));
+        BOOST_TEST(hq("?a&b") != hq("?a%26b"));
+        BOOST_TEST(hq("?a=1") != hq("?a=2"));
+        BOOST_TEST(hq("?") != hq("/"));
+        BOOST_TEST(hq("?") != hq("?&"));
+        BOOST_TEST(hq("/") == hq(""));
+    }
+
+    void
+    testContainers()
+    {
+        std::unordered_set<
+            url, url_hash, url_equal> s;
+        s.emplace("HTTP://Example.com:80/a/./b");
+        s.emplace("http://example.com/a/b");
+        s.emplace("http://example.com/a/%62");
+        s.emplace("http://example.com/a/c");
+        BOOST_TEST(s.size() == 2);
+
+        std::unordered_set<url_view,
+            std::hash<url_view>, url_equal> s2;
+        s2.emplace("http://example.com/%7E");
+        s2.emplace("http://example.com/~");
+        BOOST_TEST(s2.size() == 1);
+        BOOST_TEST(std::hash<url_view>()(
+            url_view("HTTP://example.com/~")) ==
+            hash_url(url_view("http://example.com/%7e")));
+    }
+
+    void
+    testStable()
+    {
+        // the value must not change between
+        // releases, processes, or platforms
+        if(sizeof(std::size_t) == 8)
+        {
+            BOOST_TEST(hash_url(url_view(
+                "http://example.com/")) ==
+                    static_cast<std::size_t>(
+                        0x08ad47eabf250d4dULL));
+            BOOST_TEST(hash_url(url_view(
+                "HTTP://EXAMPLE.COM:80/%7e/..")) ==
+                    static_cast<std::size_t>(
+                        0x08ad47eabf250d4dULL));
+        }
+    }
+
+    void
+    run()
+    {
+        testStable();
+        testNormal();
+        testDistinct();
+        testComponents();
+        testContainers();
+    }
+};
+
+TEST_SUITE(hash_test, "boost.url.hash");
+
+} // urls
+} // boost
@@ -0,0 +1,214 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/idna.hpp>
+
+#include <boost/url/url.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+
+namespace boost {
+namespace urls {
+
+class idna_test
+{
+public:
+    void
+    check(
+        string_view u,
+        string_view p)
+    {
+        BOOST_TEST(punycode_encode(u) == p);
+        BOOST_TEST(punycode_decode(p) == u);
+    }
+
+    void
+    testPunycode()
+    {
+        // rfc3492 section 7.1
+        check(
+            "\xd9\x84\xd9\x8a\xd9\x87\xd9\x85\xd8\xa7\xd8\xa8"
+            "\xd8\xaa\xd9\x83\xd9\x84\xd9\x85\xd9\x88\xd8\xb4"
+            "\xd8\xb9\xd8\xb1\xd8\xa8\xd9\x8a\xd8\x9f",
+            "egbpdaj6bu4bxfgehfvwxn");
+        check(
+            "\xe4\xbb\x96\xe4\xbb\xac\xe4\xb8\xba\xe4\xbb\x80"
+            "\xe4\xb9\x88\xe4\xb8\x8d\xe8\xaf\xb4\xe4\xb8\xad"
+            "\xe6\x96\x87",
+            "ihqwcrb4cv8a8dqg056pqjye");
+        check(
+            "3\xe5\xb9\xb4" "B\xe7\xb5\x84\xe9\x87\x91\xe5\x85"
+            "\xab\xe5\x85\x88\xe7\x94\x9f",
+            "3B-ww4c5e180e575a65lsy2b");
+        check(
+            "\xe3\x81\x9d\xe3\x81\xae\xe3\x82\xb9\xe3\x83\x94"
+            "\xe3\x83\xbc\xe3\x83\x89\xe3\x81\xa7",
+            "d9juau41awczczp");
+        check("-> $1.00 <-", "-> $1.00 <--");
+
+        check("", "");
+        check("b\xc3\xbc" "cher", "bcher-kva");
+        check("\xc3\xbc", "tda");
+        check("\xf0\x9f\x98\x80", "e28h");
+
+        // digits are not case sensitive
+        BOOST_TEST(punycode_decode("BCHER-KVA") ==
+            "B\xc3\xbc" "CHER");
+
+        error_code ec;
+        BOOST_TEST(punycode_encode("\xff", ec).empty());
+        BOOST_TEST(ec == error::bad_utf8);
+        punycode_encode("\xc0\x80", ec);
+        BOOST_TEST(ec == error::bad_utf8);
+        punycode_encode("\xed\xa0\x80", ec);
+        BOOST_TEST(ec == error::bad_utf8);
+        punycode_encode("\xe4\xbb", ec);
+        BOOST_TEST(ec == error::bad_utf8);
+        BOOST_TEST(punycode_decode("kva", ec) == "\xcd\xa9");
+        BOOST_TEST(! ec);
+        punycode_decode("bcher-kv", ec);
+        BOOST_TEST(ec == error::bad_punycode);
+        punycode_decode("bcher-k!a", ec);
+        BOOST_TEST(ec == error::bad_punycode);
+        punycode_decode("b\xc3\xbc-kva", ec);
+        BOOST_TEST(ec == error::bad_punycode);
+        punycode_decode("99999999999", ec);
+        BOOST_TEST(ec == error::bad_punycode);
+        BOOST_TEST_THROWS(punycode_decode("-9"), invalid_part);
+        BOOST_TEST_THROWS(punycode_encode("\x80"), invalid_part);
+    }
+
+    void
+    testToAscii()
+    {
+        BOOST_TEST(idna_to_ascii("") == "");
+        BOOST_TEST(idna_to_ascii("Example.COM.") == "example.com.");
+        BOOST_TEST(idna_to_ascii("b\xc3\xbc" "cher.example") ==
+            "xn--bcher-kva.example");
+        BOOST_TEST(idna_to_ascii("M\xc3\x9c" "NCHEN.de") ==
+            "xn--mnchen-3ya.de");
+        BOOST_TEST(idna_to_ascii(
+            "\xd0\x9f\xd0\xa0\xd0\x98\xd0\x9c\xd0\x95\xd0\xa0.com") ==
+            "xn--e1afmkfd.com");
+
+        // other full stops separate labels
+        BOOST_TEST(idna_to_ascii(
+            "b\xc3\xbc" "cher\xe3\x80\x82" "de") ==
+                "xn--bcher-kva.de");
+        BOOST_TEST(idna_to_ascii(
+            "a\xef\xbc\x8e" "b\xef\xbd\xa1" "c") == "a.b.c");
+
+        error_code ec;
+        BOOST_TEST(idna_to_ascii("b\xc3\xbc" "cher_x", ec).empty());
+        BOOST_TEST(ec == error::bad_idn_char);
+        idna_to_ascii("\xc2\xa0x", ec);
+        BOOST_TEST(ec == error::bad_idn_char);
+        idna_to_ascii("a.b\xc3", ec);
+        BOOST_TEST(ec == error::bad_utf8);
+        std::string s(60, 'a');
+        s += "\xc3\xbc";
+        idna_to_ascii(s, ec);
+        BOOST_TEST(ec == error::label_too_long);
+        BOOST_TEST_THROWS(idna_to_ascii(s), invalid_part);
+        // ASCII labels keep their characters
+        BOOST_TEST(idna_to_ascii("a_b.c", ec) == "a_b.c");
+        BOOST_TEST(! ec);
+    }
+
+    void
+    testToUnicode()
+    {
+        BOOST_TEST(idna_to_unicode("") == "");
+        BOOST_TEST(idna_to_unicode("example.com") == "example.com");
+        BOOST_TEST(idna_to_unicode("xn--bcher-kva.example") ==
+            "b\xc3\xbc" "cher.example");
+        BOOST_TEST(idna_to_unicode("XN--mnchen-3ya.de.") ==
+            "m\xc3\xbc" "nchen.de.");
+        BOOST_TEST(idna_to_unicode("xn--e1afmkfd.xn--80akhbyknj4f") ==
+            "\xd0\xbf\xd1\x80\xd0\xb8\xd0\xbc\xd0\xb5\xd1\x80."
+            "\xd0\xb8\xd1\x81\xd0\xbf\xd1\x8b\xd1\x82\xd0\xb0"
+            "\xd0\xbd\xd0\xb8\xd0\xb5");
+        BOOST_TEST(idna_to_unicode("a%20b.xn-x") == "a%20b.xn-x");
+
+        error_code ec;
+        BOOST_TEST(idna_to_unicode("a.xn--bcher-kv", ec).empty());
+        BOOST_TEST(ec == error::bad_punycode);
+        idna_to_unicode("xn--" + std::string(60, 'a'), ec);
+        BOOST_TEST(ec == error::label_too_long);
+        BOOST_TEST_THROWS(idna_to_unicode("xn--!"), invalid_part);
+
+        // round trip
+        auto const s = "\xe3\x81\x9d\xe3\x81\xae."
+            "b\xc3\xbc" "cher.example";
+        BOOST_TEST(idna_to_unicode(
+            idna_to_ascii(s)) == s);
+    }
+
+    void
+    testSetHost()
+    {
+        url u("http://example.com/path");
+        u.set_host("b\xc3\xbc" "cher.example");
+        BOOST_TEST(u.encoded_url() ==
+            "http://xn--bcher-kva.example/path");
+        BOOST_TEST(u.host_type() == host_type::name);
+        BOOST_TEST(idna_to_unicode(u.encoded_host()) ==
+            "b\xc3\xbc" "cher.example");
+
+        BOOST_TEST(url().set_host("M\xc3\xbc" "nchen.DE").encoded_url() ==
+            "//xn--mnchen-3ya.de");
+
+        // ASCII is not converted
+        BOOST_TEST(url().set_host("Example.COM").encoded_url() ==
+            "//Example.COM");
+
+        // strings which are not host
+        // names are percent-encoded
+        BOOST_TEST(url().set_host("b\xc3\xbc" "cher x").encoded_url() ==
+            "//b%C3%BCcher%20x");
+        BOOST_TEST(url().set_host("\xff").encoded_url() ==
+            "//%FF");
+
+        // assign converts the host the same way
+        for(string_view h : {
+            "b\xc3\xbc" "cher.example",
+            "M\xc3\xbc" "nchen.DE",
+            "b\xc3\xbc" "cher x" })
+        {
+            components c;
+            c.scheme = "http";
+            c.host = h;
+            url u1;
+            u1.assign(c);
+            url u2("http:");
+            u2.set_host(h);
+            BOOST_TEST(u1.encoded_url() ==
+                u2.encoded_url());
+            BOOST_TEST(u1.host_type() ==
+                u2.host_type());
+        }
+    }
+
+    void
+    run()
+    {
+        testPunycode();
+        testToAscii();
+        testToUnicode();
+        testSetHost();
+    }
+};
+
+TEST_SUITE(idna_test, "boost.url.idna");
+
+} // urls
+} // boost
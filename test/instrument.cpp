@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/instrument.hpp>
+
+#include <boost/url/parse.hpp>
+#include <boost/url/url.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+#include <thread>
+
+namespace boost {
+namespace urls {
+
+class instrument_test
+{
+public:
+#ifdef BOOST_URL_INSTRUMENT
+    void
+    testParse()
+    {
+        instrument_reset();
+        error_code ec;
+        parse_uri("http://example.com", ec);
+        parse_uri("http://[::1", ec);
+        parse_uri("%zz", ec);
+        parse_request_target("/a?b", ec);
+        url_view("/x");
+        BOOST_TEST_THROWS(url("?%"), invalid_part);
+        auto const c = instrument_snapshot();
+        BOOST_TEST(c.parses == 6);
+        BOOST_TEST(c.parse_failures == 3);
+        std::size_t n = 0;
+        for(auto f : c.failures)
+            n += f;
+        BOOST_TEST(n == 3);
+        BOOST_TEST(c.failures_of(
+            error::bad_pct_encoding_digit) >= 1);
+
+        instrument_reset();
+        BOOST_TEST(instrument_snapshot().parses == 0);
+    }
+
+    void
+    testStorage()
+    {
+        instrument_reset();
+        url u;
+        u.set_encoded_url("http://example.com/a");
+        auto c = instrument_snapshot();
+        BOOST_TEST(c.reallocations == 1);
+        BOOST_TEST(c.bytes_moved == 0);
+
+        // the host shrinks in place, and the
+        // path and the null are moved down
+        u.set_encoded_host("e.com");
+        c = instrument_snapshot();
+        BOOST_TEST(c.reallocations == 1);
+        BOOST_TEST(c.bytes_moved == 3);
+
+        u.set_encoded_path("/" + std::string(100, 'p'));
+        c = instrument_snapshot();
+        BOOST_TEST(c.reallocations == 2);
+
+        // decoding accessors which make strings
+        instrument_reset();
+        url_view const v("/?k=v");
+        (void)v.params().begin()->key();
+        (void)v.params().begin()->value();
+        (void)v.params().begin()->encoded_key();
+        BOOST_TEST(instrument_snapshot(
+            ).decode_allocations == 2);
+    }
+
+    void
+    testThreads()
+    {
+        instrument_reset();
+        error_code ec;
+        parse_uri("/", ec);
+        std::size_t other = 0;
+        std::thread t([&other]
+            {
+                error_code ec;
+                parse_uri("/a", ec);
+                parse_uri("/b", ec);
+                other = instrument_snapshot().parses;
+            });
+        t.join();
+        BOOST_TEST(other == 2);
+        BOOST_TEST(instrument_snapshot().parses == 1);
+    }
+
+    void
+    run()
+    {
+        testParse();
+        testStorage();
+        testThreads();
+    }
+#else
+    void
+    run()
+    {
+        // compiled out
+        error_code ec;
+        parse_uri("http://example.com", ec);
+        url u("http://example.com");
+        u.set_encoded_path("/path");
+        auto const c = instrument_snapshot();
+        BOOST_TEST(c.parses == 0);
+        BOOST_TEST(c.parse_failures == 0);
+        BOOST_TEST(c.reallocations == 0);
+        BOOST_TEST(c.bytes_moved == 0);
+        BOOST_TEST(c.decode_allocations == 0);
+        instrument_reset();
+    }
+#endif
+};
+
+TEST_SUITE(instrument_test, "boost.url.instrument");
+
+} // urls
+} // boost
@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/origin_pool.hpp>
+
+#include <boost/url/interned_url.hpp>
+
+#include "test_suite.hpp"
+
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+class origin_pool_test
+{
+public:
+    void
+    testIntern()
+    {
+        origin_pool pool;
+        BOOST_TEST(pool.size() == 0);
+        std::vector<interned_url> v;
+        v.emplace_back(url_view("http://a.com/x"), pool);
+        v.emplace_back(url_view("http://a.com/y?q"), pool);
+        v.emplace_back(url_view("http://a.com:80/"), pool);
+        v.emplace_back(url_view("http://b.com"), pool);
+        v.emplace_back(url_view("/path"), pool);
+        v.emplace_back(url_view("/other"), pool);
+        BOOST_TEST(pool.size() == 4);
+        BOOST_TEST(v[0].shares_origin(v[1]));
+        BOOST_TEST(! v[0].shares_origin(v[2]));
+        BOOST_TEST(v[4].shares_origin(v[5]));
+        BOOST_TEST(
+            v[0].encoded_origin().data() ==
+            v[1].encoded_origin().data());
+    }
+
+    void
+    testCollect()
+    {
+        origin_pool pool;
+        {
+            interned_url u0(
+                url_view("http://a.com/x"), pool);
+            interned_url u1(
+                url_view("http://b.com/x"), pool);
+            {
+                interned_url u2(
+                    url_view("http://c.com/x"), pool);
+                BOOST_TEST(pool.size() == 3);
+                BOOST_TEST(pool.collect() == 0);
+            }
+            BOOST_TEST(pool.collect() == 1);
+            BOOST_TEST(pool.size() == 2);
+        }
+        BOOST_TEST(pool.collect() == 2);
+        BOOST_TEST(pool.size() == 0);
+    }
+
+    void
+    testLifetime()
+    {
+        // origins outlive the pool
+        interned_url u;
+        {
+            origin_pool pool;
+            u = interned_url(url_view(
+                "https://user@example.com:8080/a"), pool);
+        }
+        BOOST_TEST(u.encoded_url() ==
+            "https://user@example.com:8080/a");
+        BOOST_TEST(u.encoded_host() == "example.com");
+    }
+
+    void
+    run()
+    {
+        testIntern();
+        testCollect();
+        testLifetime();
+    }
+};
+
+TEST_SUITE(origin_pool_test, "boost.url.origin_pool");
+
+} // urls
+} // boost
@@ -0,0 +1,126 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/params_index.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+class params_index_test
+{
+public:
+    void
+    testSlots()
+    {
+        BOOST_TEST(params_index::slots_needed(0) == 1);
+        BOOST_TEST(params_index::slots_needed(1) == 2);
+        BOOST_TEST(params_index::slots_needed(2) == 4);
+        BOOST_TEST(params_index::slots_needed(3) == 8);
+        BOOST_TEST(params_index::slots_needed(4) == 8);
+        BOOST_TEST(params_index::slots_needed(5) == 16);
+    }
+
+    void
+    testLookup()
+    {
+        {
+            url_view const u("/p?a=1&b=2&%61=3&c=&d=%34");
+            params_index::slot buf[
+                params_index::slots_needed(5)];
+            params_index const idx(u.params(), buf,
+                sizeof(buf) / sizeof(buf[0]));
+            BOOST_TEST(idx.contains("a"));
+            BOOST_TEST(idx.contains("c"));
+            BOOST_TEST(! idx.contains("e"));
+            BOOST_TEST(! idx.contains(""));
+            BOOST_TEST(idx.count("a") == 2);
+            BOOST_TEST(idx.count("b") == 1);
+            BOOST_TEST(idx.count("z") == 0);
+            BOOST_TEST(idx.find("a")->value() == "1");
+            BOOST_TEST(idx.find("a") == u.params().begin());
+            BOOST_TEST(idx.find("b")->value() == "2");
+            BOOST_TEST(idx.find("c")->encoded_value() == "");
+            BOOST_TEST(idx.find("d")->value() == "4");
+            BOOST_TEST(idx.find("e") == u.params().end());
+            BOOST_TEST(idx.find("b") == u.params().find("b"));
+
+            // iterators from the index are
+            // ordinary parameter iterators
+            auto it = idx.find("b");
+            ++it;
+            BOOST_TEST(it->encoded_key() == "%61");
+            --it;
+            --it;
+            BOOST_TEST(it == u.params().begin());
+        }
+
+        // no query
+        {
+            url_view const u("/path");
+            params_index::slot buf[1];
+            params_index const idx(u.params(), buf, 1);
+            BOOST_TEST(! idx.contains("a"));
+            BOOST_TEST(idx.count("a") == 0);
+            BOOST_TEST(idx.find("a") == u.params().end());
+        }
+
+        // matches the linear search
+        {
+            std::string s = "/p?";
+            for(int i = 0; i < 200; ++i)
+            {
+                if(i > 0)
+                    s.push_back('&');
+                s += "k" + std::to_string(i % 37) +
+                    "=" + std::to_string(i);
+            }
+            url_view const u(s);
+            auto const p = u.params();
+            BOOST_TEST(p.size() == 200);
+            std::vector<params_index::slot> buf(
+                params_index::slots_needed(p.size()));
+            params_index const idx(
+                p, buf.data(), buf.size());
+            for(int i = 0; i < 40; ++i)
+            {
+                auto const k =
+                    "k" + std::to_string(i);
+                BOOST_TEST(idx.count(k) == p.count(k));
+                BOOST_TEST(idx.contains(k) == p.contains(k));
+                BOOST_TEST(idx.find(k) == p.find(k));
+            }
+        }
+
+        // buffer too small
+        {
+            url_view const u("/p?a=1&b=2");
+            params_index::slot buf[2];
+            BOOST_TEST_THROWS(params_index(
+                u.params(), buf, 2), too_large);
+        }
+    }
+
+    void
+    run()
+    {
+        testSlots();
+        testLookup();
+    }
+};
+
+TEST_SUITE(params_index_test, "boost.url.params_index");
+
+} // urls
+} // boost
@@ -0,0 +1,257 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/parse.hpp>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace urls {
+
+class parse_api_test
+{
+public:
+    void
+    testParseUri()
+    {
+        {
+            error_code ec = error::syntax;
+            auto const u = parse_uri(
+                "http://example.com/?q", ec);
+            BOOST_TEST(! ec);
+            BOOST_TEST(u.encoded_host() == "example.com");
+            BOOST_TEST(u.encoded_query() == "q");
+        }
+        {
+            error_code ec;
+            auto const u = parse_uri("//h/%xy", ec);
+            BOOST_TEST(ec == error::bad_pct_encoding_digit);
+            BOOST_TEST(u.size() == 0);
+        }
+        {
+            auto r = parse_uri("ws://h:1");
+            BOOST_TEST(r);
+            BOOST_TEST(r.has_value());
+            BOOST_TEST(! r.has_error());
+            BOOST_TEST(! r.error());
+            BOOST_TEST(r->port() == "1");
+            BOOST_TEST((*r).scheme() == "ws");
+            BOOST_TEST(r.value().encoded_host() == "h");
+        }
+        {
+            auto const r = parse_uri("#%");
+            BOOST_TEST(! r);
+            BOOST_TEST(r.has_error());
+            BOOST_TEST(r.error() ==
+                error::incomplete_pct_encoding);
+            BOOST_TEST_THROWS(r.value(), system_error);
+        }
+    }
+
+    void
+    testParserKind()
+    {
+        for(auto k : {
+            parser_kind::recursive,
+            parser_kind::table })
+        {
+            error_code ec = error::syntax;
+            auto const u = parse_uri(
+                "http://user@example.com:80/a/b?q=1#f",
+                k, ec);
+            BOOST_TEST(! ec);
+            BOOST_TEST(u.encoded_user() == "user");
+            BOOST_TEST(u.encoded_host() == "example.com");
+            BOOST_TEST(u.port() == "80");
+            BOOST_TEST(u.encoded_path() == "/a/b");
+            BOOST_TEST(u.encoded_query() == "q=1");
+            BOOST_TEST(u.encoded_fragment() == "f");
+
+            auto const v = parse_uri("//h/%xy", k, ec);
+            BOOST_TEST(ec == error::bad_pct_encoding_digit);
+            BOOST_TEST(v.size() == 0);
+        }
+    }
+
+    void
+    testParseRequestTarget()
+    {
+        auto const good = [](
+            string_view s)
+        {
+            error_code ec;
+            auto const u =
+                parse_request_target(s, ec);
+            BOOST_TEST(! ec);
+            return u;
+        };
+        auto const bad = [](
+            string_view s)
+        {
+            auto const r =
+                parse_request_target(s);
+            BOOST_TEST(! r);
+            return r.error();
+        };
+
+        // origin-form
+        {
+            auto const u = good("/a/b?q=1");
+            BOOST_TEST(u.encoded_path() == "/a/b");
+            BOOST_TEST(u.encoded_query() == "q=1");
+            BOOST_TEST(u.segments().size() == 2);
+            BOOST_TEST(u.params().size() == 1);
+            BOOST_TEST(! u.has_authority());
+        }
+        {
+            auto const u = good("//a");
+            BOOST_TEST(u.encoded_path() == "//a");
+            BOOST_TEST(u.host_type() == host_type::none);
+        }
+        good("/");
+        good("/?");
+
+        // absolute-form, specialized
+        {
+            auto const u = good(
+                "https://www.example.com:8443/p?k=v");
+            BOOST_TEST(u.scheme() == "https");
+            BOOST_TEST(u.encoded_host() == "www.example.com");
+            BOOST_TEST(u.port() == "8443");
+            BOOST_TEST(u.encoded_path() == "/p");
+            BOOST_TEST(u.encoded_query() == "k=v");
+            BOOST_TEST(u.host_type() == host_type::name);
+        }
+        {
+            auto const u = good("HTTP://1.2.3.4");
+            BOOST_TEST(u.scheme() == "HTTP");
+            BOOST_TEST(u.encoded_host() == "1.2.3.4");
+            BOOST_TEST(u.host_type() == host_type::ipv4);
+            BOOST_TEST(u.ipv4_address()[3] == 4);
+            BOOST_TEST(u.encoded_path() == "");
+        }
+
+        // absolute-form, general
+        {
+            auto const u = good("http://[::1]:80/");
+            BOOST_TEST(u.host_type() == host_type::ipv6);
+            BOOST_TEST(u.port() == "80");
+        }
+        {
+            auto const u = good("http://user:pass@h/");
+            BOOST_TEST(u.encoded_user() == "user");
+            BOOST_TEST(u.encoded_host() == "h");
+        }
+        good("ws://h/chat");
+        good("urn:isbn:0451450523");
+
+        // the same as parse_uri
+        for(auto s : {
+            "http://h",
+            "http://h:/",
+            "https://h.com/a/b/c?x=1&y=2",
+            "http://h%41/%42?%43" })
+        {
+            auto const u0 = good(s);
+            auto const u1 = parse_uri(s).value();
+            BOOST_TEST(u0.encoded_url() == u1.encoded_url());
+            BOOST_TEST(u0.encoded_origin() == u1.encoded_origin());
+            BOOST_TEST(u0.encoded_path() == u1.encoded_path());
+            BOOST_TEST(u0.encoded_query() == u1.encoded_query());
+            BOOST_TEST(u0.host_type() == u1.host_type());
+            BOOST_TEST(u0.segments().size() == u1.segments().size());
+            BOOST_TEST(u0.params().size() == u1.params().size());
+        }
+
+        BOOST_TEST(bad("") == error::syntax);
+        BOOST_TEST(bad("*") == error::syntax);
+        BOOST_TEST(bad("a/b") == error::syntax);
+        BOOST_TEST(bad("/a#f") == error::syntax);
+        BOOST_TEST(bad("http://h/#f") == error::syntax);
+        BOOST_TEST(bad("ws://h#f") == error::syntax);
+        BOOST_TEST(bad("/a b") == error::syntax);
+        BOOST_TEST(bad("http://h:8x") == error::syntax);
+        BOOST_TEST(bad("/%zz") == error::bad_pct_encoding_digit);
+        BOOST_TEST(bad("http://%") == error::incomplete_pct_encoding);
+    }
+
+    void
+    testValidate()
+    {
+        error_code ec = error::syntax;
+        BOOST_TEST(validate_url(
+            "http://example.com/?q#f", ec) == 23);
+        BOOST_TEST(! ec);
+        BOOST_TEST(validate_url(
+            "http://example.com/a b", ec) == 20);
+        BOOST_TEST(ec == error::syntax);
+        BOOST_TEST(validate_url("//h/%xy", ec) == 4);
+        BOOST_TEST(ec == error::bad_pct_encoding_digit);
+
+        BOOST_TEST(is_valid_uri(""));
+        BOOST_TEST(is_valid_uri("/a?b"));
+        BOOST_TEST(is_valid_uri("mailto:u@example.com"));
+        BOOST_TEST(! is_valid_uri("http://[::1"));
+        BOOST_TEST(! is_valid_uri("#%"));
+    }
+
+    void
+    testParseUrls()
+    {
+        string_view const v[] = {
+            "http://example.com/path?q=1#f",
+            "http://[::",
+            "/relative/path",
+            "",
+            "x://%"
+            };
+        url_view out[5];
+        error_code ec[5];
+
+        BOOST_TEST(parse_urls(
+            v, v + 5, out, ec) == 3);
+        BOOST_TEST(! ec[0]);
+        BOOST_TEST(out[0].encoded_host() == "example.com");
+        BOOST_TEST(out[0].encoded_path() == "/path");
+        BOOST_TEST(out[0].encoded_query() == "q=1");
+        BOOST_TEST(out[0].data() == v[0].data());
+        BOOST_TEST(ec[1]);
+        BOOST_TEST(out[1].size() == 0);
+        BOOST_TEST(! ec[2]);
+        BOOST_TEST(out[2].encoded_path() == "/relative/path");
+        BOOST_TEST(! ec[3]);
+        BOOST_TEST(out[3].size() == 0);
+        BOOST_TEST(ec[4]);
+
+        // without error codes
+        BOOST_TEST(parse_urls(
+            v, v + 2, out, nullptr) == 1);
+        BOOST_TEST(out[0].scheme() == "http");
+
+        // empty range
+        BOOST_TEST(parse_urls(
+            v, v, out, ec) == 0);
+    }
+
+    void
+    run()
+    {
+        testParseUri();
+        testParserKind();
+        testParseRequestTarget();
+        testValidate();
+        testParseUrls();
+    }
+};
+
+TEST_SUITE(parse_api_test, "boost.url.parse_api");
+
+} // urls
+} // boost
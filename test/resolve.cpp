@@ -0,0 +1,191 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/resolve.hpp>
+
+#include <boost/url/static_url.hpp>
+#include <boost/url/url.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+
+namespace boost {
+namespace urls {
+
+class resolve_test
+{
+public:
+    // the parts of the target must be
+    // the same as those of a fresh parse
+    static
+    void
+    check(
+        url_view const& base,
+        string_view ref,
+        string_view target)
+    {
+        url u;
+        resolve(base, url_view(ref), u);
+        if(! BOOST_TEST(u.encoded_url() == target))
+            return;
+        url_view const v(target);
+        BOOST_TEST(u.scheme() == v.scheme());
+        BOOST_TEST(u.scheme_id() == v.scheme_id());
+        BOOST_TEST(u.encoded_authority() == v.encoded_authority());
+        BOOST_TEST(u.encoded_userinfo() == v.encoded_userinfo());
+        BOOST_TEST(u.encoded_host() == v.encoded_host());
+        BOOST_TEST(u.host_type() == v.host_type());
+        BOOST_TEST(u.port() == v.port());
+        BOOST_TEST(u.port_number() == v.port_number());
+        BOOST_TEST(u.encoded_path() == v.encoded_path());
+        BOOST_TEST(u.segments().size() == v.segments().size());
+        BOOST_TEST(u.encoded_query() == v.encoded_query());
+        BOOST_TEST(u.query_part() == v.query_part());
+        BOOST_TEST(u.params().size() == v.params().size());
+        BOOST_TEST(u.fragment_part() == v.fragment_part());
+    }
+
+    void
+    testExamples()
+    {
+        // rfc3986 5.4.1
+        url_view const base("http://a/b/c/d;p?q");
+        check(base, "g:h", "g:h");
+        check(base, "g", "http://a/b/c/g");
+        check(base, "./g", "http://a/b/c/g");
+        check(base, "g/", "http://a/b/c/g/");
+        check(base, "/g", "http://a/g");
+        check(base, "//g", "http://g");
+        check(base, "?y", "http://a/b/c/d;p?y");
+        check(base, "g?y", "http://a/b/c/g?y");
+        check(base, "#s", "http://a/b/c/d;p?q#s");
+        check(base, "g#s", "http://a/b/c/g#s");
+        check(base, "g?y#s", "http://a/b/c/g?y#s");
+        check(base, ";x", "http://a/b/c/;x");
+        check(base, "g;x", "http://a/b/c/g;x");
+        check(base, "g;x?y#s", "http://a/b/c/g;x?y#s");
+        check(base, "", "http://a/b/c/d;p?q");
+        check(base, ".", "http://a/b/c/");
+        check(base, "./", "http://a/b/c/");
+        check(base, "..", "http://a/b/");
+        check(base, "../", "http://a/b/");
+        check(base, "../g", "http://a/b/g");
+        check(base, "../..", "http://a/");
+        check(base, "../../", "http://a/");
+        check(base, "../../g", "http://a/g");
+
+        // rfc3986 5.4.2
+        check(base, "../../../g", "http://a/g");
+        check(base, "../../../../g", "http://a/g");
+        check(base, "/./g", "http://a/g");
+        check(base, "/../g", "http://a/g");
+        check(base, "g.", "http://a/b/c/g.");
+        check(base, ".g", "http://a/b/c/.g");
+        check(base, "g..", "http://a/b/c/g..");
+        check(base, "..g", "http://a/b/c/..g");
+        check(base, "./../g", "http://a/b/g");
+        check(base, "./g/.", "http://a/b/c/g/");
+        check(base, "g/./h", "http://a/b/c/g/h");
+        check(base, "g/../h", "http://a/b/c/h");
+        check(base, "g;x=1/./y", "http://a/b/c/g;x=1/y");
+        check(base, "g;x=1/../y", "http://a/b/c/y");
+        check(base, "g?y/./x", "http://a/b/c/g?y/./x");
+        check(base, "g?y/../x", "http://a/b/c/g?y/../x");
+        check(base, "g#s/./x", "http://a/b/c/g#s/./x");
+        check(base, "g#s/../x", "http://a/b/c/g#s/../x");
+        check(base, "http:g", "http:g");
+    }
+
+    void
+    testParts()
+    {
+        url_view const base(
+            "https://user:pass@[::1]:8443/a/b?x=1&y=2#f");
+        check(base, "c?z", "https://user:pass@[::1]:8443/a/c?z");
+        check(base, "#g", "https://user:pass@[::1]:8443/a/b?x=1&y=2#g");
+        check(base, "//h:1/p/../q", "https://h:1/q");
+        check(base, "ftp://127.0.0.1/./x/../y?", "ftp://127.0.0.1/y?");
+        check(base, "/", "https://user:pass@[::1]:8443/");
+
+        // an empty base path is merged as "/"
+        check(url_view("http://h"), "g", "http://h/g");
+        check(url_view("http://h?q#f"), "", "http://h?q");
+
+        // paths without an authority
+        check(url_view("mailto:a@b"), "c@d", "mailto:c@d");
+        check(url_view("urn:a/b/c"), "../d", "urn:a/d");
+        check(url_view("urn:a/b"), "?q", "urn:a/b?q");
+        check(url_view("x:/a/b"), ".//g", "x:/a//g");
+        check(url_view("x:/a/b"), "/..//g", "x:/.//g");
+        check(url_view("x:a"), "/", "x:/");
+    }
+
+    void
+    testErrors()
+    {
+        url u("http://x/y");
+        error_code ec;
+        resolve(url_view("/a/b"), url_view("c"), u, ec);
+        BOOST_TEST(ec == error::missing_scheme);
+        BOOST_TEST(u.encoded_url() == "http://x/y");
+        BOOST_TEST_THROWS(resolve(
+            url_view("//h/a"), url_view("c"), u),
+            invalid_part);
+        BOOST_TEST(u.encoded_url() == "http://x/y");
+
+        // the target does not fit
+        static_url<16> su("http://x/y");
+        BOOST_TEST_THROWS(resolve(
+            url_view("http://example.com/a/b"),
+            url_view("c"), su),
+            too_large);
+        BOOST_TEST(su.encoded_url() == "http://x/y");
+        // the merged path must fit before
+        // its dot segments are removed
+        BOOST_TEST_THROWS(resolve(
+            url_view("http://a/b/c"),
+            url_view("../a/./b/../../."), su),
+            too_large);
+        resolve(url_view("http://a/b"),
+            url_view("./c/.."), su);
+        BOOST_TEST(su.encoded_url() == "http://a/");
+    }
+
+    void
+    testReuse()
+    {
+        // one destination for many references
+        url_view const base("http://a/b/c/d;p?q");
+        url u;
+        resolve(base, url_view("../../g/h/i/j/k/l?m#n"), u);
+        BOOST_TEST(u.encoded_url() == "http://a/g/h/i/j/k/l?m#n");
+        resolve(base, url_view("g"), u);
+        BOOST_TEST(u.encoded_url() == "http://a/b/c/g");
+        BOOST_TEST(u.segments().size() == 3);
+        url const b(u);
+        resolve(b, url_view("?k=v"), u);
+        BOOST_TEST(u.encoded_url() == "http://a/b/c/g?k=v");
+    }
+
+    void
+    run()
+    {
+        testExamples();
+        testParts();
+        testErrors();
+        testReuse();
+    }
+};
+
+TEST_SUITE(resolve_test, "boost.url.resolve");
+
+} // urls
+} // boost
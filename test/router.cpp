@@ -0,0 +1,204 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/router.hpp>
+
+#include <boost/url/url.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+
+namespace boost {
+namespace urls {
+
+class router_test
+{
+public:
+    void
+    testMatch()
+    {
+        router r;
+        BOOST_TEST(r.size() == 0);
+        BOOST_TEST(r.insert("/") == 0);
+        BOOST_TEST(r.insert("/users") == 1);
+        BOOST_TEST(r.insert("/users/{id}") == 2);
+        BOOST_TEST(r.insert("/users/{id}/posts/*") == 3);
+        BOOST_TEST(r.insert("/users/me") == 4);
+        BOOST_TEST(r.insert("/files/*") == 5);
+        BOOST_TEST(r.insert("/a/{x}/c") == 6);
+        BOOST_TEST(r.insert("/a/b/{y}") == 7);
+        BOOST_TEST(r.insert("") == 8);
+        BOOST_TEST(r.insert("/users/") == 9);
+        BOOST_TEST(r.size() == 10);
+
+        router::match_results m;
+        auto const check = [&](
+            string_view s,
+            std::size_t route)
+        {
+            if(! BOOST_TEST(r.match(url_view(s), m)))
+                return false;
+            return BOOST_TEST(m.route() == route);
+        };
+
+        BOOST_TEST(check("/", 0));
+        BOOST_TEST(check("http://example.com/", 0));
+        BOOST_TEST(check("http://example.com", 8));
+        BOOST_TEST(check("/users", 1));
+        BOOST_TEST(check("/users/", 9));
+        BOOST_TEST(check("/users/me", 4));
+        BOOST_TEST(m.size() == 0);
+        if(check("/users/42", 2))
+        {
+            BOOST_TEST(m.size() == 1);
+            BOOST_TEST(m[0] == "42");
+            BOOST_TEST(m["id"] == "42");
+            BOOST_TEST(m["x"] == "");
+        }
+        if(check("/users/me/posts/2021/06?q#f", 3))
+        {
+            BOOST_TEST(m.size() == 2);
+            BOOST_TEST(m["id"] == "me");
+            BOOST_TEST(m["*"] == "2021/06");
+            BOOST_TEST(m[1] == "2021/06");
+        }
+        if(check("/files/a//b/", 5))
+            BOOST_TEST(m[0] == "a//b/");
+        if(check("/files/", 5))
+            BOOST_TEST(m[0] == "");
+        BOOST_TEST(! r.match(url_view("/files"), m));
+        BOOST_TEST(m.size() == 0);
+
+        // a literal is preferred, but
+        // the parameter is tried after
+        BOOST_TEST(check("/a/b/c", 7));
+        BOOST_TEST(m["y"] == "c");
+        BOOST_TEST(check("/a/z/c", 6));
+        BOOST_TEST(m["x"] == "z");
+        BOOST_TEST(! r.match(url_view("/a/b"), m));
+        BOOST_TEST(! r.match(url_view("/users/1/2"), m));
+        BOOST_TEST(! r.match(url_view("/nope"), m));
+        BOOST_TEST(! r.match(url_view("//h/a/b/c/d"), m));
+    }
+
+    void
+    testDecoded()
+    {
+        router r;
+        r.insert("/a%62c/%7Bx%7D");
+        r.insert("/p%2Fq");
+        router::match_results m;
+        BOOST_TEST(r.match(url_view("/abc/%7bx%7d"), m));
+        BOOST_TEST(r.match(url_view("/%61%62%63/%7Bx%7D"), m));
+        BOOST_TEST(m.route() == 0);
+        BOOST_TEST(r.match(url_view("/p%2fq"), m));
+        BOOST_TEST(m.route() == 1);
+        BOOST_TEST(! r.match(url_view("/p/q"), m));
+
+        // captures are encoded
+        r.insert("/{v}");
+        BOOST_TEST(r.match(url_view("/x%20y"), m));
+        BOOST_TEST(m[0] == "x%20y");
+    }
+
+    void
+    testUrl()
+    {
+        router r;
+        r.insert("/api/{version}/items");
+        url u("https://example.com/api/v1/items");
+        router::match_results m;
+        BOOST_TEST(r.match(u, m));
+        BOOST_TEST(m["version"] == "v1");
+        BOOST_TEST(r.match(u.segments(), m));
+        BOOST_TEST(m["version"] == "v1");
+    }
+
+    void
+    testErrors()
+    {
+        router r;
+        r.insert("/a/{b}");
+        r.insert("/a/*");
+        BOOST_TEST_THROWS(r.insert("/a/{c}"), invalid_part);
+        BOOST_TEST_THROWS(r.insert("/a/*"), invalid_part);
+        BOOST_TEST_THROWS(r.insert("/*/a"), invalid_part);
+        BOOST_TEST_THROWS(r.insert("/{}"), invalid_part);
+        BOOST_TEST_THROWS(r.insert("/{a"), invalid_part);
+        BOOST_TEST_THROWS(r.insert("/a}"), invalid_part);
+        BOOST_TEST_THROWS(r.insert("/{a}b"), invalid_part);
+        BOOST_TEST_THROWS(r.insert("/{a{b}"), invalid_part);
+        BOOST_TEST_THROWS(r.insert("/%"), invalid_part);
+        BOOST_TEST_THROWS(r.insert("/%4g"), invalid_part);
+        BOOST_TEST(r.size() == 2);
+
+        std::string s;
+        for(std::size_t i = 0;
+            i <= router::max_captures; ++i)
+            s += "/{p" + std::to_string(i) + "}";
+        BOOST_TEST_THROWS(r.insert(s), too_large);
+        BOOST_TEST(r.size() == 2);
+
+        // the failed inserts changed nothing
+        router::match_results m;
+        BOOST_TEST(r.match(url_view("/a/x"), m));
+        BOOST_TEST(m.route() == 0);
+        BOOST_TEST(r.match(url_view("/a/x/y"), m));
+        BOOST_TEST(m.route() == 1);
+        BOOST_TEST(! r.match(url_view("/p0/p1"), m));
+    }
+
+    void
+    testMany()
+    {
+        // many routes sharing prefixes
+        router r;
+        for(int i = 0; i < 300; ++i)
+        {
+            auto const n = std::to_string(i);
+            BOOST_TEST(r.insert("/r" + n + "/{id}") ==
+                static_cast<std::size_t>(2 * i));
+            BOOST_TEST(r.insert("/r" + n + "/{id}/x" + n) ==
+                static_cast<std::size_t>(2 * i + 1));
+        }
+        router::match_results m;
+        for(int i = 0; i < 300; ++i)
+        {
+            auto const n = std::to_string(i);
+            auto const s0 = "/r" + n + "/7";
+            auto const s1 = "/r" + n + "/8/x" + n;
+            BOOST_TEST(r.match(url_view(s0), m));
+            BOOST_TEST(m.route() ==
+                static_cast<std::size_t>(2 * i));
+            BOOST_TEST(m["id"] == "7");
+            BOOST_TEST(r.match(url_view(s1), m));
+            BOOST_TEST(m.route() ==
+                static_cast<std::size_t>(2 * i + 1));
+            BOOST_TEST(m["id"] == "8");
+        }
+        BOOST_TEST(! r.match(url_view("/r1/8/x2"), m));
+    }
+
+    void
+    run()
+    {
+        testMatch();
+        testDecoded();
+        testUrl();
+        testErrors();
+        testMany();
+    }
+};
+
+TEST_SUITE(router_test, "boost.url.router");
+
+} // urls
+} // boost
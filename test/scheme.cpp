@@ -10,8 +10,14 @@
 // Test that header file is self-contained.
 #include <boost/url/scheme.hpp>
 
+#include <boost/url/parse.hpp>
+#include <boost/url/serialize.hpp>
+#include <boost/url/url_view.hpp>
+
 #include "test_suite.hpp"
 
+#include <string>
+
 namespace boost {
 namespace urls {
 
@@ -19,7 +25,7 @@ class scheme_test
 {
 public:
     void
-    run()
+    testSpecial()
     {
         BOOST_TEST(is_special("ftp"));
         BOOST_TEST(is_special("file"));
@@ -31,6 +37,117 @@ public:
         BOOST_TEST(! is_special("gopher"));
         BOOST_TEST(! is_special("magnet"));
         BOOST_TEST(! is_special("mailto"));
+
+        BOOST_TEST(is_special(scheme::ftp));
+        BOOST_TEST(is_special(scheme::wss));
+        BOOST_TEST(! is_special(scheme::unknown));
+    }
+
+    void
+    testLookup()
+    {
+        BOOST_TEST(string_to_scheme("ftp") == scheme::ftp);
+        BOOST_TEST(string_to_scheme("FILE") == scheme::file);
+        BOOST_TEST(string_to_scheme("hTtP") == scheme::http);
+        BOOST_TEST(string_to_scheme("HTTPS") == scheme::https);
+        BOOST_TEST(string_to_scheme("Ws") == scheme::ws);
+        BOOST_TEST(string_to_scheme("wsS") == scheme::wss);
+
+        BOOST_TEST(string_to_scheme("") == scheme::unknown);
+        BOOST_TEST(string_to_scheme("h") == scheme::unknown);
+        BOOST_TEST(string_to_scheme("htt") == scheme::unknown);
+        BOOST_TEST(string_to_scheme("httpx") == scheme::unknown);
+        BOOST_TEST(string_to_scheme("httpsxxxx") == scheme::unknown);
+        BOOST_TEST(string_to_scheme(
+            string_view("http\0", 5)) == scheme::unknown);
+        // control characters do not fold
+        BOOST_TEST(string_to_scheme("\x08TTP") == scheme::unknown);
+        BOOST_TEST(string_to_scheme("wS\x13") == scheme::unknown);
+
+        BOOST_TEST(to_string(scheme::https) == "https");
+        BOOST_TEST(to_string(scheme::unknown) == "<unknown>");
+
+        BOOST_TEST(default_port(scheme::unknown) == 0);
+        BOOST_TEST(default_port(scheme::ftp) == 21);
+        BOOST_TEST(default_port(scheme::file) == 0);
+        BOOST_TEST(default_port(scheme::http) == 80);
+        BOOST_TEST(default_port(scheme::https) == 443);
+        BOOST_TEST(default_port(scheme::ws) == 80);
+        BOOST_TEST(default_port(scheme::wss) == 443);
+        BOOST_TEST(default_port(static_cast<scheme>(200)) == 0);
+    }
+
+    void
+    testRegister()
+    {
+        auto const grpc = register_scheme("grpc", 50051);
+        auto const s3 = register_scheme("S3", 0);
+        auto const redis = register_scheme("redis", 6379);
+        BOOST_TEST(grpc != scheme::unknown);
+        BOOST_TEST(! is_special(grpc));
+        BOOST_TEST(s3 != grpc);
+        BOOST_TEST(string_to_scheme("GRPC") == grpc);
+        BOOST_TEST(string_to_scheme("s3") == s3);
+        BOOST_TEST(string_to_scheme("Redis") == redis);
+        BOOST_TEST(! is_special("grpc"));
+        BOOST_TEST(to_string(s3) == "s3");
+        BOOST_TEST(default_port(grpc) == 50051);
+        BOOST_TEST(default_port(redis) == 6379);
+        BOOST_TEST(string_to_scheme("http") == scheme::http);
+
+        // the parsers keep the scheme
+        url_view const u("GRPC://example.com:50051/svc");
+        BOOST_TEST(u.scheme_id() == grpc);
+        BOOST_TEST(default_port(u.scheme_id()) == u.port_number());
+        BOOST_TEST(parse_uri("redis://h").value().scheme_id() == redis);
+        {
+            // stored by name, not by id
+            std::string b;
+            serialize_url(u, b);
+            string_view buf = b;
+            BOOST_TEST(deserialize_url(buf).scheme_id() == grpc);
+        }
+
+        // again, with the same port
+        BOOST_TEST(register_scheme("Grpc", 50051) == grpc);
+
+        BOOST_TEST_THROWS(register_scheme("grpc", 1), invalid_part);
+        BOOST_TEST_THROWS(register_scheme("http", 80), invalid_part);
+        BOOST_TEST_THROWS(register_scheme("", 1), invalid_part);
+        BOOST_TEST_THROWS(register_scheme("1a", 1), invalid_part);
+        BOOST_TEST_THROWS(register_scheme("a_b", 1), invalid_part);
+        BOOST_TEST_THROWS(register_scheme("abcdefghi", 1), invalid_part);
+
+        // fill the table, which needs other
+        // multipliers to stay perfect
+        std::string names[32];
+        std::size_t n = 3;
+        for(; n < 32; ++n)
+        {
+            names[n] = "t" + std::to_string(n) + "+x";
+            auto const id = register_scheme(
+                names[n], static_cast<
+                    std::uint16_t>(n));
+            BOOST_TEST(default_port(id) == n);
+        }
+        BOOST_TEST_THROWS(register_scheme("t99", 1), too_large);
+        for(n = 3; n < 32; ++n)
+        {
+            auto const id = string_to_scheme(names[n]);
+            BOOST_TEST(to_string(id) == names[n]);
+            BOOST_TEST(default_port(id) == n);
+        }
+        BOOST_TEST(string_to_scheme("grpc") == grpc);
+        BOOST_TEST(string_to_scheme("wss") == scheme::wss);
+        BOOST_TEST(string_to_scheme("t99") == scheme::unknown);
+    }
+
+    void
+    run()
+    {
+        testSpecial();
+        testLookup();
+        testRegister();
     }
 };
 
@@ -0,0 +1,175 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/segments_index.hpp>
+
+#include <boost/url/url.hpp>
+
+#include "test_suite.hpp"
+
+#include <algorithm>
+
+namespace boost {
+namespace urls {
+
+class segments_index_test
+{
+public:
+    // the index agrees with a fresh scan
+    static
+    void
+    check(segments_index const& idx, url& u)
+    {
+        auto const ps = u.segments();
+        BOOST_TEST(idx.size() == ps.size());
+        std::size_t i = 0;
+        for(auto e : ps)
+        {
+            if(! BOOST_TEST(i < idx.size()))
+                break;
+            BOOST_TEST(idx[i].encoded_string() ==
+                e.encoded_string());
+            ++i;
+        }
+        BOOST_TEST(i == idx.size());
+    }
+
+    void
+    testIndex()
+    {
+        {
+            url u("/path/to/file.txt");
+            segments_index idx(u);
+            BOOST_TEST(! idx.empty());
+            BOOST_TEST(idx.size() == 3);
+            BOOST_TEST(idx[0].encoded_string() == "path");
+            BOOST_TEST(idx[1].encoded_string() == "to");
+            BOOST_TEST(idx[2].encoded_string() == "file.txt");
+            check(idx, u);
+        }
+        {
+            url u("http://example.com");
+            segments_index idx(u);
+            BOOST_TEST(idx.empty());
+            BOOST_TEST(idx.begin() == idx.end());
+        }
+        for(auto s : {
+            "/", "//h/", "//h//", "a/b", "x:a/b/",
+            "/a/%2F/b?q#f", "//h/a//b" })
+        {
+            url u(s);
+            segments_index idx(u);
+            check(idx, u);
+        }
+    }
+
+    void
+    testIterator()
+    {
+        url u("/a/b/c/d/e");
+        segments_index const idx(u);
+        auto it = idx.begin();
+        BOOST_TEST(idx.end() - it == 5);
+        BOOST_TEST((it + 3)->encoded_string() == "d");
+        BOOST_TEST(it[4].encoded_string() == "e");
+        it += 2;
+        BOOST_TEST(it->encoded_string() == "c");
+        BOOST_TEST((*it).encoded_string() == "c");
+        BOOST_TEST((it - 1)->encoded_string() == "b");
+        BOOST_TEST((1 + it)->encoded_string() == "d");
+        BOOST_TEST(it - idx.begin() == 2);
+        it -= 2;
+        BOOST_TEST(it == idx.begin());
+        BOOST_TEST(it < idx.end());
+        BOOST_TEST(it <= idx.begin());
+        BOOST_TEST(idx.end() > it);
+        BOOST_TEST(idx.end() >= it);
+        BOOST_TEST(it++ == idx.begin());
+        BOOST_TEST(it-- != idx.begin());
+        BOOST_TEST(++it != idx.begin());
+        BOOST_TEST(--it == idx.begin());
+
+        // base
+        BOOST_TEST(idx.begin().base() == u.segments().begin());
+        BOOST_TEST(idx.end().base() == u.segments().end());
+        BOOST_TEST((idx.begin() + 2).base()->encoded_string() == "c");
+
+        // algorithms
+        BOOST_TEST(std::lower_bound(idx.begin(), idx.end(), 'c',
+            [](segments_index::value_type const& v, char c)
+            {
+                return v.encoded_string()[0] < c;
+            })->encoded_string() == "c");
+    }
+
+    void
+    testModify()
+    {
+        url u("http://example.com/a/b/c?q");
+        segments_index idx(u);
+        auto ps = idx.segments();
+
+        ps.erase((idx.begin() + 1).base());
+        BOOST_TEST(u.encoded_path() == "/a/c");
+        check(idx, u);
+
+        ps.insert_encoded((idx.begin() + 1).base(), "x");
+        BOOST_TEST(u.encoded_path() == "/a/x/c");
+        check(idx, u);
+
+        ps.insert(idx.end().base(), "y z");
+        BOOST_TEST(u.encoded_path() == "/a/x/c/y%20z");
+        check(idx, u);
+
+        ps.replace_encoded(idx.begin().base(), "longer");
+        BOOST_TEST(u.encoded_path() == "/longer/x/c/y%20z");
+        check(idx, u);
+
+        ps.replace((idx.begin() + 3).base(), "w");
+        BOOST_TEST(u.encoded_path() == "/longer/x/c/w");
+        check(idx, u);
+
+        ps.erase(
+            (idx.begin() + 1).base(),
+            (idx.begin() + 3).base());
+        BOOST_TEST(u.encoded_path() == "/longer/w");
+        check(idx, u);
+
+        // other parts do not invalidate
+        u.set_encoded_host("www.example.com");
+        u.set_query("k=v");
+        check(idx, u);
+        BOOST_TEST(idx[1].encoded_string() == "w");
+
+        ps.erase(idx.begin().base(), idx.end().base());
+        BOOST_TEST(u.encoded_path() == "");
+        BOOST_TEST(idx.empty());
+        check(idx, u);
+
+        // rebuild after other path changes
+        u.set_encoded_path("/p/q");
+        idx.rebuild();
+        BOOST_TEST(idx.size() == 2);
+        check(idx, u);
+    }
+
+    void
+    run()
+    {
+        testIndex();
+        testIterator();
+        testModify();
+    }
+};
+
+TEST_SUITE(segments_index_test, "boost.url.segments_index");
+
+} // urls
+} // boost
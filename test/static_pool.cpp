@@ -10,9 +10,13 @@
 // Test that header file is self-contained.
 #include <boost/url/static_pool.hpp>
 
+#include <boost/url/basic_url.hpp>
+
 #include "test_suite.hpp"
 
+#include <cstdint>
 #include <iostream>
+#include <string>
 
 namespace boost {
 namespace urls {
@@ -20,9 +24,113 @@ namespace urls {
 class static_pool_test
 {
 public:
+    void
+    testAllocate()
+    {
+        static_pool<64> sp;
+        auto a = sp.allocator();
+        auto p0 = a.allocate(16);
+        auto p1 = a.allocate(16);
+        BOOST_TEST(p1 == p0 + 16);
+        BOOST_TEST(sp.used() == 32);
+
+        // LIFO rollback
+        a.deallocate(p1, 16);
+        BOOST_TEST(sp.used() == 16);
+        BOOST_TEST(a.allocate(8) == p1);
+
+        // not the most recent, no effect
+        a.deallocate(p0, 16);
+        BOOST_TEST(sp.used() == 24);
+
+        BOOST_TEST_THROWS(a.allocate(41),
+            std::bad_alloc);
+        BOOST_TEST(sp.used() == 24);
+
+        // alignment
+        static_pool<64> sp2;
+        basic_static_pool::allocator_type<
+            std::uint32_t> a2(sp2);
+        sp2.allocator().allocate(1);
+        auto p2 = a2.allocate(2);
+        BOOST_TEST(reinterpret_cast<
+            std::uintptr_t>(p2) % 4 == 0);
+    }
+
+    void
+    testReset()
+    {
+        static_pool<64> sp;
+        auto a = sp.allocator();
+        auto p0 = a.allocate(40);
+        a.allocate(20);
+        BOOST_TEST(sp.used() == 60);
+        sp.reset();
+        BOOST_TEST(sp.used() == 0);
+        BOOST_TEST(a.allocate(40) == p0);
+    }
+
+    void
+    testExtend()
+    {
+        static_pool<64> sp;
+        auto a = sp.allocator();
+        auto p0 = a.allocate(16);
+        BOOST_TEST(try_extend(a, p0, 16, 32));
+        BOOST_TEST(sp.used() == 32);
+        BOOST_TEST(! try_extend(a, p0, 32, 65));
+        auto p1 = a.allocate(8);
+        BOOST_TEST(! try_extend(a, p0, 32, 40));
+        BOOST_TEST(try_extend(a, p1, 8, 16));
+        BOOST_TEST(sp.used() == 48);
+
+        // growing a url uses the space in place
+        static_pool<4000> sp2;
+        basic_url<basic_static_pool::
+            allocator_type<char>> u(sp2.allocator());
+        u.set_encoded_path("/a");
+        auto const p = u.data();
+        for(int i = 0; i < 10; ++i)
+            u.set_encoded_path(std::string(
+                100 * i, 'x').insert(0, "/"));
+        BOOST_TEST(u.data() == p);
+        BOOST_TEST(sp2.used() == u.capacity() + 1);
+    }
+
+    void
+    testUpstream()
+    {
+        static_pool<32> sp(256);
+        auto a = sp.allocator();
+        auto p0 = a.allocate(24);
+        auto p1 = a.allocate(24);
+        BOOST_TEST(p1 != p0 + 24);
+        BOOST_TEST(sp.used() == 24);
+
+        // larger than a block
+        a.allocate(1000);
+        BOOST_TEST(sp.used() == 1000);
+
+        sp.reset();
+        BOOST_TEST(sp.used() == 0);
+        BOOST_TEST(a.allocate(24) == p0);
+
+        // urls can outgrow the buffer
+        static_pool<16> sp2(128);
+        basic_url<basic_static_pool::
+            allocator_type<char>> u(
+                "http://www.example.com/path/to/file",
+                sp2.allocator());
+        BOOST_TEST(u.encoded_host() == "www.example.com");
+    }
+
     void
     run()
     {
+        testAllocate();
+        testReset();
+        testExtend();
+        testUpstream();
     }
 };
 
@@ -18,11 +18,83 @@ namespace urls {
 class static_url_test
 {
 public:
-    //------------------------------------------------------
+    void
+    testCapacity()
+    {
+        BOOST_STATIC_ASSERT(
+            static_url<64>::max_size() == 64);
+        BOOST_STATIC_ASSERT(
+            static_url<64>::static_capacity == 64);
+        char buf[static_url<16>::max_size()];
+        (void)buf;
+
+        static_url<64> u;
+        BOOST_TEST(u.capacity() == 64);
+        BOOST_TEST(u.size() == 0);
+        BOOST_TEST(u.encoded_url() == "");
+        BOOST_TEST(*u.data() == 0);
+    }
+
+    void
+    testModify()
+    {
+        static_url<32> u("http://x.com/a");
+        BOOST_TEST(u.encoded_url() == "http://x.com/a");
+        u.set_encoded_query("k=v");
+        BOOST_TEST(u.encoded_url() == "http://x.com/a?k=v");
+
+        // exactly the capacity
+        u.set_encoded_fragment("0123456789012");
+        BOOST_TEST(u.size() == 32);
+
+        // overflow leaves the URL unchanged
+        BOOST_TEST_THROWS(
+            u.set_encoded_fragment("01234567890123"),
+            too_large);
+        BOOST_TEST(u.encoded_url() ==
+            "http://x.com/a?k=v#0123456789012");
+
+        BOOST_TEST_THROWS(
+            static_url<8>("http://x.com/a"),
+            too_large);
+    }
+
+    void
+    testCopy()
+    {
+        static_url<64> u1("http://user@x.com:80/a/b?k=v#f");
+        static_url<64> u2(u1);
+        BOOST_TEST(u2.encoded_url() == u1.encoded_url());
+        BOOST_TEST(u2.data() != u1.data());
+        BOOST_TEST(u2.encoded_user() == "user");
+        BOOST_TEST(u2.port() == "80");
+        BOOST_TEST(u2.segments().size() == 2);
+
+        // copies are independent
+        u2.set_encoded_host("y.org");
+        BOOST_TEST(u1.encoded_host() == "x.com");
+        BOOST_TEST(u2.encoded_url() ==
+            "http://user@y.org:80/a/b?k=v#f");
+
+        static_url<64> u3;
+        u3 = u2;
+        BOOST_TEST(u3.encoded_url() == u2.encoded_url());
+        BOOST_TEST(u3.encoded_query() == "k=v");
+        u3 = u3;
+        BOOST_TEST(u3.encoded_url() == u2.encoded_url());
+
+        static_url<64> const u4;
+        u3 = u4;
+        BOOST_TEST(u3.encoded_url() == "");
+        BOOST_TEST(u3.segments().size() == 0);
+    }
 
     void
     run()
     {
+        testCapacity();
+        testModify();
+        testCopy();
     }
 };
 
@@ -0,0 +1,205 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/url_dedup.hpp>
+
+#include <boost/url/url.hpp>
+
+#include "test_suite.hpp"
+
+#include <algorithm>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace boost {
+namespace urls {
+
+class url_dedup_test
+{
+public:
+    void
+    testInsert()
+    {
+        std::vector<char> buf(1000);
+        url_dedup set(buf.data(), buf.size());
+        BOOST_TEST(set.size() == 0);
+        BOOST_TEST(set.capacity() == 1000);
+
+        error_code ec;
+        auto const s0 = set.insert(
+            "HTTP://Example.com:80/a/./b%7e", ec);
+        BOOST_TEST(! ec);
+        BOOST_TEST(s0 == "http://example.com/a/b~");
+        BOOST_TEST(s0.data() == buf.data());
+        BOOST_TEST(set.used() == s0.size());
+        auto const s1 = set.insert(
+            "http://example.com/a/b~", ec);
+        BOOST_TEST(! ec);
+        BOOST_TEST(s1.data() == s0.data());
+        BOOST_TEST(s1.size() == s0.size());
+        auto const s2 = set.insert(
+            "http://example.com/a/b", ec);
+        BOOST_TEST(! ec);
+        BOOST_TEST(s2 == "http://example.com/a/b");
+        BOOST_TEST(s2.data() != s0.data());
+        BOOST_TEST(set.size() == 2);
+
+        // errors
+        auto const s3 = set.insert(
+            "http://[::1/", ec);
+        BOOST_TEST(ec);
+        BOOST_TEST(s3.empty());
+        BOOST_TEST(set.size() == 2);
+
+        // the empty URL
+        auto const s4 = set.insert("", ec);
+        BOOST_TEST(! ec);
+        BOOST_TEST(s4.empty());
+        BOOST_TEST(set.size() == 3);
+        set.insert("", ec);
+        BOOST_TEST(set.size() == 3);
+
+        auto v = set.values();
+        std::sort(v.begin(), v.end());
+        BOOST_TEST(v.size() == 3);
+        BOOST_TEST(v[0] == "");
+        BOOST_TEST(v[1] == "http://example.com/a/b");
+        BOOST_TEST(v[2] == "http://example.com/a/b~");
+    }
+
+    void
+    testFull()
+    {
+        char buf[20];
+        url_dedup set(buf, sizeof(buf));
+        error_code ec;
+        set.insert("http://a.com/x", ec);
+        BOOST_TEST(! ec);
+        BOOST_TEST(set.used() == 14);
+        auto const s = set.insert(
+            "http://b.com/x", ec);
+        BOOST_TEST(ec == error::buffer_full);
+        BOOST_TEST(s.empty());
+        BOOST_TEST(set.size() == 1);
+        BOOST_TEST(set.used() == 14);
+
+        // a duplicate needs no room
+        auto const s1 = set.insert(
+            "HTTP://A.COM/x", ec);
+        BOOST_TEST(! ec);
+        BOOST_TEST(s1.data() == buf);
+        set.insert("/y", ec);
+        BOOST_TEST(! ec);
+        BOOST_TEST(set.size() == 2);
+    }
+
+    void
+    testRange()
+    {
+        // k distinct URLs, each written
+        // in several equivalent ways
+        std::size_t const k = 500;
+        std::vector<std::string> w;
+        for(std::size_t i = 0; i < k; ++i)
+        {
+            auto const n = std::to_string(i);
+            w.push_back("http://h" + n + ".com/p");
+            w.push_back("HTTP://H" + n + ".COM:80/p");
+            w.push_back("http://h" + n + ".com/q/../p");
+            w.push_back("http://h" + n + ".com/%70");
+        }
+        w.push_back("http://[::1/");
+        std::vector<string_view> in(
+            w.begin(), w.end());
+
+        for(std::size_t threads : { 1, 4 })
+        {
+            std::vector<char> buf(k * 20);
+            url_dedup set(buf.data(), buf.size(), 3);
+            std::vector<string_view> out(in.size());
+            std::vector<error_code> ec(in.size());
+
+            // each thread takes its own
+            // part of the range
+            std::vector<std::size_t> added(threads);
+            std::vector<std::thread> v;
+            auto const m =
+                (in.size() + threads - 1) / threads;
+            for(std::size_t t = 0; t < threads; ++t)
+            {
+                auto const i0 = (std::min)(
+                    in.size(), t * m);
+                auto const i1 = (std::min)(
+                    in.size(), i0 + m);
+                v.emplace_back([&, t, i0, i1]
+                {
+                    added[t] = set.insert(
+                        in.data() + i0,
+                        in.data() + i1,
+                        out.data() + i0,
+                        ec.data() + i0);
+                });
+            }
+            std::size_t n = 0;
+            for(std::size_t t = 0; t < threads; ++t)
+            {
+                v[t].join();
+                n += added[t];
+            }
+            BOOST_TEST(n == k);
+            BOOST_TEST(set.size() == k);
+            BOOST_TEST(ec.back());
+            BOOST_TEST(out.back().empty());
+            std::set<char const*> seen;
+            for(std::size_t i = 0; i < k; ++i)
+            {
+                auto const s = out[4 * i];
+                BOOST_TEST(! ec[4 * i]);
+                BOOST_TEST(s == w[4 * i]);
+                BOOST_TEST(s.data() >= buf.data() &&
+                    s.data() < buf.data() + buf.size());
+                for(std::size_t j = 1; j < 4; ++j)
+                    BOOST_TEST(
+                        out[4 * i + j].data() == s.data());
+                seen.insert(s.data());
+            }
+            BOOST_TEST(seen.size() == k);
+            BOOST_TEST(set.values().size() == k);
+
+            // again, nothing is new
+            BOOST_TEST(set.insert(
+                in.data(), in.data() + in.size(),
+                out.data(), nullptr) == 0);
+            BOOST_TEST(set.size() == k);
+        }
+
+        // empty range
+        {
+            url_dedup set(nullptr, 0);
+            BOOST_TEST(set.insert(in.data(),
+                in.data(), nullptr, nullptr) == 0);
+        }
+    }
+
+    void
+    run()
+    {
+        testInsert();
+        testFull();
+        testRange();
+    }
+};
+
+TEST_SUITE(url_dedup_test, "boost.url.url_dedup");
+
+} // urls
+} // boost
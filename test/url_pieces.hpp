@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+#ifndef BOOST_URL_TEST_URL_PIECES_HPP
+#define BOOST_URL_TEST_URL_PIECES_HPP
+
+#include <boost/url/url_view.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace boost {
+namespace urls {
+namespace test {
+
+/** Random strings made of pieces of URLs.
+
+    The sequence is the same on every run, so a
+    failing string can be found again. With
+    `more` set, the pieces also include runs of
+    letters and characters which are never
+    allowed in a URL.
+*/
+class url_pieces
+{
+    std::uint32_t seed_ = 1;
+    std::size_t n_;
+
+    static
+    char const* const*
+    table() noexcept
+    {
+        static char const* const pieces[] = {
+            "a", "Z", "0", "1", "9", "255", "256",
+            ".", ":", "/", "//", "?", "#", "@",
+            "[", "]", "%", "%4", "%41", "%g1", "%2F",
+            "=", "&", "+", "-", "_", "~", "!", "'",
+            " ", "\x80", "[::1]", "[", "::", "1.2.3.4",
+            "FFFF", "v", "http:", "x:", "//h", "[::FFFF:1.2.3.4]",
+            "https:", ":80", ":65535", ":65536", "WS:",
+            // more
+            "abcdefghijklmnopqrstuvwxyz0123456789",
+            "\"", "<", ">", "\\", "^", "`", "{", "|", "}",
+            };
+        return pieces;
+    }
+
+public:
+    explicit
+    url_pieces(bool more = false) noexcept
+        : n_(more ? 56 : 46)
+    {
+    }
+
+    unsigned
+    rand() noexcept
+    {
+        seed_ = seed_ * 1103515245 + 12345;
+        return (seed_ >> 16) & 0x7fff;
+    }
+
+    // Return up to max - 1 pieces
+    std::string
+    operator()(unsigned max = 10)
+    {
+        std::string s;
+        auto const n = rand() % max;
+        for(unsigned j = 0; j < n; ++j)
+            s += table()[rand() % n_];
+        return s;
+    }
+};
+
+/** Return true if two views have the same parts.
+
+    The second view may be of any type with
+    the members of @ref url_view that are
+    compared.
+*/
+template<class View>
+bool
+same_parts(
+    url_view const& u0,
+    View const& u1)
+{
+    return
+        u0.encoded_url() == u1.encoded_url() &&
+        u0.scheme() == u1.scheme() &&
+        u0.scheme_id() == u1.scheme_id() &&
+        u0.has_authority() == u1.has_authority() &&
+        u0.encoded_user() == u1.encoded_user() &&
+        u0.encoded_password() == u1.encoded_password() &&
+        u0.userinfo_part() == u1.userinfo_part() &&
+        u0.host_type() == u1.host_type() &&
+        u0.encoded_host() == u1.encoded_host() &&
+        u0.port_part() == u1.port_part() &&
+        u0.port_number() == u1.port_number() &&
+        u0.encoded_path() == u1.encoded_path() &&
+        u0.segments().size() == u1.segments().size() &&
+        u0.query_part() == u1.query_part() &&
+        u0.params().size() == u1.params().size() &&
+        u0.fragment_part() == u1.fragment_part();
+}
+
+inline
+bool
+same(
+    url_view const& u0,
+    url_view const& u1)
+{
+    return
+        same_parts(u0, u1) &&
+        u0.ipv4_address() == u1.ipv4_address() &&
+        u0.ipv6_address() == u1.ipv6_address();
+}
+
+} // test
+} // urls
+} // boost
+
+#endif
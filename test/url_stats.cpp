@@ -0,0 +1,135 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/vinniefalco/url
+//
+
+// Test that header file is self-contained.
+#include <boost/url/url_stats.hpp>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace urls {
+
+class url_stats_test
+{
+public:
+    static
+    std::size_t
+    at(
+        url_stats::table_type const& t,
+        char const* key)
+    {
+        auto const it = t.find(key);
+        if(it == t.end())
+            return 0;
+        return it->second;
+    }
+
+    void
+    testInsert()
+    {
+        url_stats st;
+        BOOST_TEST(st.urls() == 0);
+        BOOST_TEST(st.errors() == 0);
+        BOOST_TEST(st.insert(
+            "http://www.example.com/a/b?k=1&j=2"));
+        BOOST_TEST(st.insert(
+            "https://www.example.com/a?k"));
+        BOOST_TEST(st.insert("/c/d#f"));
+        BOOST_TEST(! st.insert("http://[::1/"));
+        BOOST_TEST(st.urls() == 3);
+        BOOST_TEST(st.errors() == 1);
+        BOOST_TEST(st.hosts().size() == 1);
+        BOOST_TEST(at(st.hosts(),
+            "www.example.com") == 2);
+        BOOST_TEST(at(st.first_segments(), "a") == 2);
+        BOOST_TEST(at(st.first_segments(), "c") == 1);
+        BOOST_TEST(at(st.param_keys(), "k") == 2);
+        BOOST_TEST(at(st.param_keys(), "j") == 1);
+    }
+
+    void
+    testLines()
+    {
+        url_stats st;
+        st.insert_lines(
+            "http://a.com/x\r\n"
+            "\n"
+            "http://b.com/y?q=1\n"
+            "not a url\n"
+            "//a.com/x");
+        BOOST_TEST(st.urls() == 3);
+        BOOST_TEST(st.errors() == 1);
+        BOOST_TEST(at(st.hosts(), "a.com") == 2);
+        BOOST_TEST(at(st.hosts(), "b.com") == 1);
+        BOOST_TEST(at(st.first_segments(), "x") == 2);
+
+        url_stats st2;
+        st2.insert_lines("");
+        st2.insert_lines("\n\r\n");
+        BOOST_TEST(st2.urls() == 0);
+        BOOST_TEST(st2.errors() == 0);
+    }
+
+    void
+    testMerge()
+    {
+        url_stats a;
+        url_stats b;
+        a.insert_lines(
+            "http://a.com/x?k\n"
+            "http://b.com/y\n");
+        b.insert_lines(
+            "http://a.com/z?k=1&j\n"
+            "%\n");
+        a.merge(b);
+        BOOST_TEST(a.urls() == 3);
+        BOOST_TEST(a.errors() == 1);
+        BOOST_TEST(at(a.hosts(), "a.com") == 2);
+        BOOST_TEST(at(a.hosts(), "b.com") == 1);
+        BOOST_TEST(at(a.first_segments(), "z") == 1);
+        BOOST_TEST(at(a.param_keys(), "k") == 2);
+        BOOST_TEST(at(a.param_keys(), "j") == 1);
+    }
+
+    void
+    testTop()
+    {
+        url_stats st;
+        st.insert_lines(
+            "http://b.com\n"
+            "http://a.com\n"
+            "http://c.com\n"
+            "http://c.com\n");
+        auto v = url_stats::top(st.hosts(), 2);
+        BOOST_TEST(v.size() == 2);
+        BOOST_TEST(v[0].first == "c.com");
+        BOOST_TEST(v[0].second == 2);
+        BOOST_TEST(v[1].first == "a.com");
+        BOOST_TEST(v[1].second == 1);
+        v = url_stats::top(st.hosts(), 10);
+        BOOST_TEST(v.size() == 3);
+        BOOST_TEST(v[2].first == "b.com");
+        v = url_stats::top(st.hosts(), 0);
+        BOOST_TEST(v.empty());
+    }
+
+    void
+    run()
+    {
+        testInsert();
+        testLines();
+        testMerge();
+        testTop();
+    }
+};
+
+TEST_SUITE(url_stats_test, "boost.url.url_stats");
+
+} // urls
+} // boost
@@ -10,9 +10,12 @@
 // Test that header file is self-contained.
 #include <boost/url/url_view.hpp>
 #include <boost/url/static_pool.hpp>
+#include <boost/url/parse.hpp>
 
 #include "test_suite.hpp"
 
+#include <array>
+
 namespace boost {
 namespace urls {
 
@@ -24,6 +27,11 @@ public:
     void
     testView()
     {
+        // offsets are 32 bits,
+        // plus the IP address
+        BOOST_TEST(sizeof(detail::parts) <=
+            (detail::id_end + 3) * 4 + 4 + 16);
+
         BOOST_TEST(url_view().host_type() == host_type::none);
         BOOST_TEST(url_view("//").host_type() == host_type::none);
         BOOST_TEST(url_view("//127.0.0.1").host_type() == host_type::ipv4);
@@ -203,6 +211,62 @@ public:
         BOOST_TEST(url_view("//[1:2:3:4:5:6:7::]").host_type() == host_type::ipv6);
     }
 
+    void
+    testAddress()
+    {
+        using a4 = std::array<unsigned char, 4>;
+        using a6 = std::array<unsigned char, 16>;
+        auto const v4 = [](string_view s)
+        {
+            return url_view(s).ipv4_address();
+        };
+        auto const v6 = [](string_view s)
+        {
+            return url_view(s).ipv6_address();
+        };
+
+        BOOST_TEST(v4("//127.0.0.1") == (a4{{127, 0, 0, 1}}));
+        BOOST_TEST(v4("//255.255.255.255") == (a4{{255, 255, 255, 255}}));
+        BOOST_TEST(v4("http://10.1.2.3:80/") == (a4{{10, 1, 2, 3}}));
+        BOOST_TEST(v4("//127.0.0.1.9") == a4{});
+        BOOST_TEST(v4("//example.com") == a4{});
+        BOOST_TEST(v4("//[::1]") == a4{});
+        BOOST_TEST(url_view().ipv4_address() == a4{});
+
+        BOOST_TEST(v6("//[::]") == a6{});
+        BOOST_TEST(v6("//[::1]") == (a6{{
+            0,0, 0,0, 0,0, 0,0, 0,0, 0,0, 0,0, 0,1 }}));
+        BOOST_TEST(v6("//[2001:DB8::1234:5678]") == (a6{{
+            0x20,0x01, 0x0D,0xB8, 0,0, 0,0,
+            0,0, 0,0, 0x12,0x34, 0x56,0x78 }}));
+        BOOST_TEST(v6("//[1:2:3:4:5::]") == (a6{{
+            0,1, 0,2, 0,3, 0,4, 0,5, 0,0, 0,0, 0,0 }}));
+        BOOST_TEST(v6("//[1:2::3:4:5]") == (a6{{
+            0,1, 0,2, 0,0, 0,0, 0,0, 0,3, 0,4, 0,5 }}));
+        BOOST_TEST(v6("//[684D:1111:222:3333:4444:5555:6:77]") == (a6{{
+            0x68,0x4D, 0x11,0x11, 0x02,0x22, 0x33,0x33,
+            0x44,0x44, 0x55,0x55, 0x00,0x06, 0x00,0x77 }}));
+        BOOST_TEST(v6("//[::FFFF:1.2.3.4]") == (a6{{
+            0,0, 0,0, 0,0, 0,0, 0,0, 0xFF,0xFF, 1,2, 3,4 }}));
+        BOOST_TEST(v6("//[0:0:0:0:0:0:192.168.0.1]") == (a6{{
+            0,0, 0,0, 0,0, 0,0, 0,0, 0,0, 192,168, 0,1 }}));
+        BOOST_TEST(v6("//[::255.1.2.3]") == (a6{{
+            0,0, 0,0, 0,0, 0,0, 0,0, 0,0, 255,1, 2,3 }}));
+        BOOST_TEST(v6("//127.0.0.1") == a6{});
+
+        // the table parser decodes the same address
+        {
+            error_code ec;
+            auto const u = parse_uri(
+                "//[2001:DB8::7]:80", parser_kind::table, ec);
+            BOOST_TEST(! ec);
+            BOOST_TEST(u.ipv6_address() == v6("//[2001:DB8::7]"));
+            auto const w = parse_uri(
+                "//1.2.3.4", parser_kind::table, ec);
+            BOOST_TEST(w.ipv4_address() == (a4{{1, 2, 3, 4}}));
+        }
+    }
+
     void
     testHost()
     {
@@ -231,6 +295,31 @@ public:
         BOOST_TEST(url_view("//x:/").port_part() == ":");
         BOOST_TEST(url_view("//x:80/").port() == "80");
         BOOST_TEST(url_view("//x:80/").port_part() == ":80");
+
+        BOOST_TEST(url_view().port_number() == 0);
+        BOOST_TEST(url_view("//x:/").port_number() == 0);
+        BOOST_TEST(url_view("//x:80/").port_number() == 80);
+        BOOST_TEST(url_view("//x:008080").port_number() == 8080);
+        BOOST_TEST(url_view("//x:65535").port_number() == 65535);
+        BOOST_TEST(url_view("//x:65536").port_number() == 0);
+        BOOST_TEST(url_view("//x:99999999999999999999").port_number() == 0);
+        BOOST_TEST(url_view("//[::1]:443").port_number() == 443);
+        BOOST_TEST(url_view("//u:p@x:21").port_number() == 21);
+    }
+
+    void
+    testSchemeId()
+    {
+        BOOST_TEST(url_view().scheme_id() == scheme::unknown);
+        BOOST_TEST(url_view("/a").scheme_id() == scheme::unknown);
+        BOOST_TEST(url_view("http:").scheme_id() == scheme::http);
+        BOOST_TEST(url_view("HTTPS://x").scheme_id() == scheme::https);
+        BOOST_TEST(url_view("ws://x").scheme_id() == scheme::ws);
+        BOOST_TEST(url_view("wss:").scheme_id() == scheme::wss);
+        BOOST_TEST(url_view("ftp:/x").scheme_id() == scheme::ftp);
+        BOOST_TEST(url_view("file:///x").scheme_id() == scheme::file);
+        BOOST_TEST(url_view("gopher:").scheme_id() == scheme::unknown);
+        BOOST_TEST(url_view("httpx:").scheme_id() == scheme::unknown);
     }
 
     //------------------------------------------------------
@@ -302,6 +391,19 @@ public:
             it--;
             BOOST_TEST(it->encoded_string() == "path");
         }
+        {
+            // decoded sizes found while iterating
+            url_view const v("a%20b/%41%42%43/d%2F/e");
+            auto it = v.segments().begin();
+            BOOST_TEST(it->string() == "a b"); ++it;
+            BOOST_TEST(it->string() == "ABC"); ++it;
+            BOOST_TEST(it->string() == "d/"); ++it;
+            BOOST_TEST(it->string() == "e"); --it;
+            BOOST_TEST(it->string() == "d/"); --it;
+            BOOST_TEST(it->string() == "ABC"); --it;
+            BOOST_TEST(it->encoded_string() == "a%20b");
+            BOOST_TEST(it->string() == "a b");
+        }
     }
 
     //------------------------------------------------------
@@ -394,6 +496,22 @@ public:
             it--;
             BOOST_TEST(it->encoded_key() == "x");
         }
+        {
+            // decoded sizes found while iterating
+            url_view const v("?k%20ey=v%41lue&long_key=x&%3D");
+            auto it = v.params().begin();
+            BOOST_TEST(it->key() == "k ey");
+            BOOST_TEST(it->value() == "vAlue"); ++it;
+            BOOST_TEST(it->key() == "long_key");
+            BOOST_TEST(it->value() == "x"); ++it;
+            BOOST_TEST(it->key() == "=");
+            BOOST_TEST(it->value() == ""); --it;
+            BOOST_TEST(it->key() == "long_key"); --it;
+            BOOST_TEST(it->encoded_key() == "k%20ey");
+            BOOST_TEST(it->encoded_value() == "v%41lue");
+            BOOST_TEST(it->key() == "k ey");
+            BOOST_TEST(it->value() == "vAlue");
+        }
     }
 
     //------------------------------------------------------
@@ -421,8 +539,12 @@ public:
 
         testUserinfo();
         testHostAndPort();
+        testIPv4();
+        testIPv6();
+        testAddress();
         testHost();
         testPort();
+        testSchemeId();
         testPath();
         testQuery();
         testFragment();